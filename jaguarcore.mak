@@ -51,6 +51,8 @@ INCS := -I./src
 
 OBJS := \
 	obj/blitter.o      \
+	obj/cdaudio.o      \
+	obj/cdimage.o      \
 	obj/cdintf.o       \
 	obj/cdrom.o        \
 	obj/dac.o          \
@@ -74,9 +76,12 @@ OBJS := \
 	obj/mmu.o          \
 	obj/modelsBIOS.o   \
 	obj/op.o           \
+	obj/perfcount.o    \
 	obj/state.o        \
 	obj/tom.o          \
+	obj/trace.o        \
 	obj/universalhdr.o \
+	obj/wavcapture.o   \
 	obj/wavetable.o
 
 # Targets for convenience sake, not "real" targets
@@ -30,12 +30,11 @@
 #include "jaguar.h"
 #include "log.h"
 //#include "memory.h"
+#include "perfcount.h"
 #include "settings.h"
 
 // Various conditional compilation goodies...
 
-//#define LOG_BLITS
-
 #define USE_ORIGINAL_BLITTER
 //#define USE_MIDSUMMER_BLITTER
 #define USE_MIDSUMMER_BLITTER_MKII
@@ -53,7 +52,6 @@ extern int jaguar_active_memory_dumps;
 
 // Local global variables
 
-int start_logging = 0;
 uint8_t blitter_working = 0;
 bool startConciseBlitLogging = false;
 bool logBlit = false;
@@ -64,9 +62,7 @@ static uint8_t blitter_ram[0x100];
 
 // Other crapola
 
-bool specialLog = false;
 extern int effect_start;
-extern int blit_start_log;
 void BlitterMidsummer(uint32_t cmd);
 void BlitterMidsummer2(void);
 
@@ -272,7 +268,7 @@ void BlitterMidsummer2(void);
 
 // 16 bpp pixel write
 //#define WRITE_PIXEL_16(a,d)     {  JaguarWriteWord(a##_addr+(PIXEL_OFFSET_16(a)<<1),d); }
-#define WRITE_PIXEL_16(a,d)     {  JaguarWriteWord(a##_addr+(PIXEL_OFFSET_16(a)<<1), d, BLITTER); if (specialLog) WriteLog("Pixel write address: %08X\n", a##_addr+(PIXEL_OFFSET_16(a)<<1)); }
+#define WRITE_PIXEL_16(a,d)     {  JaguarWriteWord(a##_addr+(PIXEL_OFFSET_16(a)<<1), d, BLITTER); if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_TRACE)) WriteLog("Pixel write address: %08X\n", a##_addr+(PIXEL_OFFSET_16(a)<<1)); }
 //#define WRITE_PIXEL_16(a,d)     {  JaguarWriteWord(a##_addr+(PIXEL_OFFSET_16(a)<<1), d); if (specialLog) WriteLog("Pixel write address: %08X\n", a##_addr+(PIXEL_OFFSET_16(a)<<1)); }
 
 // 32 bpp pixel write
@@ -397,7 +393,7 @@ Blit! (0018FA70 <- 008DDC40) count: 2 x 13, A1/2_FLAGS: 00014218/00013C18 [cmd:
 	uint32_t srcdata, srczdata, dstdata, dstzdata, writedata, inhibit;
 	uint32_t bppSrc = (DSTA2 ? 1 << ((REG(A1_FLAGS) >> 3) & 0x07) : 1 << ((REG(A2_FLAGS) >> 3) & 0x07));
 
-if (specialLog)
+if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_TRACE))
 {
 	WriteLog("About to do n x m blit (BM width is ? pixels)...\n");
 	WriteLog("A1_STEP_X/Y = %08X/%08X, A2_STEP_X/Y = %08X/%08X\n", a1_step_x, a1_step_y, a2_step_x, a2_step_y);
@@ -412,7 +408,7 @@ if (specialLog)
 
 	while (outer_loop--)
 	{
-if (specialLog)
+if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_TRACE))
 {
 	WriteLog("  A1_X/Y = %08X/%08X, A2_X/Y = %08X/%08X\n", a1_x, a1_y, a2_x, a2_y);
 }
@@ -430,7 +426,7 @@ if (specialLog)
 		inner_loop = n_pixels;
 		while (inner_loop--)
 		{
-if (specialLog)
+if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_TRACE))
 {
 	WriteLog("    A1_X/Y = %08X/%08X, A2_X/Y = %08X/%08X\n", a1_x, a1_y, a2_x, a2_y);
 }
@@ -1083,7 +1079,6 @@ Lesse, with pre-add we'd have:
 	WREG(A1_PIXEL,  (a1_y & 0xFFFF0000) | ((a1_x >> 16) & 0xFFFF));
 	WREG(A1_FPIXEL, (a1_y << 16) | (a1_x & 0xFFFF));
 	WREG(A2_PIXEL,  (a2_y & 0xFFFF0000) | ((a2_x >> 16) & 0xFFFF));
-specialLog = false;
 }
 
 void blitter_blit(uint32_t cmd)
@@ -1332,8 +1327,7 @@ WriteLog("BLIT: Asked to use invalid bit combo (XADDINC) for A2...\n");
 			a2_x <<= 3;
 	}//*/
 
-#ifdef LOG_BLITS
-	if (start_logging)
+	if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_DEBUG))
 	{
 		WriteLog("Blit!\n");
 		WriteLog("  cmd      = 0x%.8x\n",cmd);
@@ -1377,7 +1371,6 @@ WriteLog("BLIT: Asked to use invalid bit combo (XADDINC) for A2...\n");
 		WriteLog("  GOURD   = %i\n",GOURD);
 		WriteLog("  SRCSHADE= %i\n",SRCSHADE);
 	}
-#endif
 
 //NOTE: Pitch is ignored!
 
@@ -1479,7 +1472,7 @@ Blit! (00110000 <- 0010B2A8) count: 12 x 12, A1/2_FLAGS: 000042E2/00000020 [cmd:
 
 */
 //extern int op_start_log;
-if (blit_start_log)
+if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_DEBUG))
 {
 	const char * ctrlStr[4] = { "XADDPHR\0", "XADDPIX\0", "XADD0\0", "XADDINC\0" };
 	const char * bppStr[8] = { "1bpp\0", "2bpp\0", "4bpp\0", "8bpp\0", "16bpp\0", "32bpp\0", "???\0", "!!!\0" };
@@ -1747,10 +1740,14 @@ if (blit_start_log)
 #endif
 #else
 	{
+		int perfUnit = PerfCountSwitch(PERF_BLITTER);
+
 		if (vjs.useFastBlitter)
 			blitter_blit(GET32(blitter_ram, 0x38));
 		else
 			BlitterMidsummer2();
+
+		PerfCountSwitch(perfUnit);
 	}
 #endif
 }
@@ -1894,9 +1891,9 @@ void LogBlit(void)
 
 void BlitterMidsummer(uint32_t cmd)
 {
-#ifdef LOG_BLITS
-	LogBlit();
-#endif
+	if (LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_DEBUG))
+		LogBlit();
+
 uint32_t outer_loop, inner_loop, a1_addr, a2_addr;
 int32_t a1_x, a1_y, a2_x, a2_y, a1_width, a2_width;
 uint8_t a1_phrase_mode, a2_phrase_mode;
@@ -2714,10 +2711,7 @@ void COMP_CTRL(uint8_t &dbinh, bool &nowrite,
 
 void BlitterMidsummer2(void)
 {
-#ifdef LOG_BLITS
-	LogBlit();
-#endif
-	if (startConciseBlitLogging)
+	if (startConciseBlitLogging || LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_DEBUG))
 		LogBlit();
 
 	// Here's what the specs say the state machine does. Note that this can probably be
@@ -2776,7 +2770,7 @@ if (
 #else
 logBlit = true;
 #endif
-if (blit_start_log == 0)	// Wait for the signal...
+if (!LOG_ENABLED(LOG_CAT_BLITTER, LOG_LEVEL_DEBUG))	// Wait for the signal...
 	logBlit = false;//*/
 //temp, for testing...
 /*if (cmd != 0x49820609)
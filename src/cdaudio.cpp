@@ -0,0 +1,249 @@
+//
+// CD audio (Red Book) streaming
+//
+// When BUTCH plays the disc without the I2S path to JERRY on, the drive's
+// audio goes out on its own. A decoder thread reads the sectors from the CD
+// interface, and turns each one into its 588 stereo samples in a ring buffer,
+// running a few sectors ahead of the playback. The host audio callback mixes
+// the ring buffer with the DSP output (see SDLSoundCallback in dac.cpp),
+// resampling it from 44.1 KHz to the host rate.
+//
+// The emulation thread only sets the play position and the state; it never
+// reads from the disc, nor waits on the decoder thread. Neither does the
+// audio callback, which reads the ring buffer without locking.
+//
+
+#include "cdaudio.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "cdintf.h"
+#include "log.h"
+
+#define CDAUDIO_RING_SIZE		0x4000				// 16K stereo samples, ~370 ms (must be a power of two)
+#define CDAUDIO_SECTOR_SIZE		2352
+
+
+// Local variables
+
+static std::thread decodeThread;
+static std::mutex cdAudioMutex;
+static std::condition_variable cdAudioCondition;
+static bool cdAudioQuit;
+static uint32_t cdAudioBlock;						// Next block to decode
+static uint32_t cdAudioGeneration = 0;				// Bumped by each play/stop, to flush the ring
+static std::atomic<bool> cdAudioPlaying(false);
+static std::atomic<bool> cdAudioPaused(false);
+static std::atomic<bool> cdAudioMuted(false);
+
+// Samples ring buffer; written by the decoder thread, read by the audio thread
+static int16_t ringBuffer[CDAUDIO_RING_SIZE][2];
+static std::atomic<uint32_t> ringWrite(0);
+static std::atomic<uint32_t> ringRead(0);
+static std::atomic<uint32_t> ringStart(0);			// Samples before this one are stale
+
+// Resampler state, owned by the audio thread
+static double mixPhase = 0;
+static int16_t mixSample[2][2];						// Previous & current input samples
+
+// Local functions
+
+static void CDAudioDecode(void);
+
+
+void CDAudioInit(void)
+{
+	cdAudioQuit = false;
+	cdAudioPlaying = cdAudioPaused = cdAudioMuted = false;
+	decodeThread = std::thread(CDAudioDecode);
+}
+
+
+void CDAudioDone(void)
+{
+	if (!decodeThread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(cdAudioMutex);
+		cdAudioQuit = true;
+	}
+
+	cdAudioCondition.notify_one();
+	decodeThread.join();
+}
+
+
+//
+// Start playing at the given block (absolute frame number, 00:02:00 = 150)
+//
+void CDAudioPlay(uint32_t block)
+{
+	{
+		std::lock_guard<std::mutex> lock(cdAudioMutex);
+		cdAudioBlock = block;
+		cdAudioGeneration++;
+		cdAudioPlaying = true;
+		cdAudioPaused = false;
+	}
+
+	cdAudioCondition.notify_one();
+	LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_INFO, "CDAUDIO: Playing from block #%u\n", block);
+}
+
+
+void CDAudioStop(void)
+{
+	if (!cdAudioPlaying)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(cdAudioMutex);
+		cdAudioGeneration++;
+		cdAudioPlaying = false;
+	}
+
+	cdAudioCondition.notify_one();
+	LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_INFO, "CDAUDIO: Stopped\n");
+}
+
+
+void CDAudioPause(bool state)
+{
+	cdAudioPaused = state;
+	cdAudioCondition.notify_one();
+}
+
+
+void CDAudioMute(bool state)
+{
+	cdAudioMuted = state;
+}
+
+
+bool CDAudioIsPlaying(void)
+{
+	return cdAudioPlaying && !cdAudioPaused;
+}
+
+
+//
+// Decoder thread: one sector at a time, whenever the ring buffer has room for
+// it. The audio callback doesn't signal when it makes room, so the wait times
+// out now and then.
+//
+static void CDAudioDecode(void)
+{
+	static uint8_t sector[CDAUDIO_SECTOR_SIZE + 96];
+	uint32_t generation = cdAudioGeneration;
+	std::unique_lock<std::mutex> lock(cdAudioMutex);
+
+	while (true)
+	{
+		cdAudioCondition.wait_for(lock, std::chrono::milliseconds(5), [&generation] {
+			return cdAudioQuit || (generation != cdAudioGeneration)
+				|| (cdAudioPlaying && !cdAudioPaused && ((CDAUDIO_RING_SIZE - (ringWrite - ringRead)) >= CDAUDIO_SECTOR_FRAMES)); });
+
+		if (cdAudioQuit)
+			break;
+
+		// A new play position, or a stop: what's in the ring buffer is not to be heard
+		if (generation != cdAudioGeneration)
+		{
+			generation = cdAudioGeneration;
+			ringStart.store(ringWrite.load(std::memory_order_relaxed), std::memory_order_release);
+		}
+
+		if (!cdAudioPlaying || cdAudioPaused || ((CDAUDIO_RING_SIZE - (ringWrite - ringRead)) < CDAUDIO_SECTOR_FRAMES))
+			continue;
+
+		uint32_t block = cdAudioBlock++;
+		lock.unlock();
+
+		bool ok = CDIntfReadBlock(block, sector, CDINTF_STREAM_AUDIO);
+		uint32_t write = ringWrite.load(std::memory_order_relaxed);
+
+		// Red Book samples are 16-bit little endian, left then right
+		for(int i=0; ok && (i<CDAUDIO_SECTOR_FRAMES); i++)
+		{
+			int16_t * sample = ringBuffer[(write + i) & (CDAUDIO_RING_SIZE - 1)];
+			sample[0] = (int16_t)(sector[(i * 4) + 0] | (sector[(i * 4) + 1] << 8));
+			sample[1] = (int16_t)(sector[(i * 4) + 2] | (sector[(i * 4) + 3] << 8));
+		}
+
+		lock.lock();
+
+		// Whatever was decoded for a previous play position is dropped
+		if (generation != cdAudioGeneration)
+			continue;
+
+		if (ok)
+			ringWrite.store(write + CDAUDIO_SECTOR_FRAMES, std::memory_order_release);
+		else
+		{
+			WriteLog("CDAUDIO: Could not read block #%u, stopping\n", block);
+			cdAudioPlaying = false;
+		}
+	}
+}
+
+
+//
+// Add the CD audio to the host audio buffer (16 bit left/16 bit right pairs),
+// at the given rate. Called by the audio thread.
+//
+void CDAudioMix(int16_t * buffer, int samples, int rate)
+{
+	uint32_t read = ringRead.load(std::memory_order_relaxed);
+	uint32_t start = ringStart.load(std::memory_order_acquire);
+
+	if ((int32_t)(start - read) > 0)
+		read = start;
+
+	if (!cdAudioPlaying || cdAudioPaused)
+	{
+		ringRead.store(read, std::memory_order_release);
+		return;
+	}
+
+	uint32_t write = ringWrite.load(std::memory_order_acquire);
+	double step = (double)CDAUDIO_RATE / (double)rate;
+	bool muted = cdAudioMuted;
+
+	for(int i=0; i<samples; i++)
+	{
+		mixPhase += step;
+
+		while (mixPhase >= 1.0)
+		{
+			// Ran dry, hold the last sample
+			if (read == write)
+			{
+				mixSample[0][0] = mixSample[1][0], mixSample[0][1] = mixSample[1][1];
+				mixPhase = 0;
+				break;
+			}
+
+			mixSample[0][0] = mixSample[1][0], mixSample[0][1] = mixSample[1][1];
+			mixSample[1][0] = ringBuffer[read & (CDAUDIO_RING_SIZE - 1)][0];
+			mixSample[1][1] = ringBuffer[read & (CDAUDIO_RING_SIZE - 1)][1];
+			read++;
+			mixPhase -= 1.0;
+		}
+
+		if (muted)
+			continue;
+
+		for(int channel=0; channel<2; channel++)
+		{
+			int32_t sample = buffer[(i * 2) + channel] + (int32_t)(mixSample[0][channel]
+				+ ((mixSample[1][channel] - mixSample[0][channel]) * mixPhase));
+			buffer[(i * 2) + channel] = (int16_t)(sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample));
+		}
+	}
+
+	ringRead.store(read, std::memory_order_release);
+}
@@ -0,0 +1,22 @@
+//
+// CDAUDIO.H: Header file
+//
+
+#ifndef __CDAUDIO_H__
+#define __CDAUDIO_H__
+
+#include <stdint.h>
+
+#define CDAUDIO_RATE			44100
+#define CDAUDIO_SECTOR_FRAMES	588					// Stereo samples in a 2352 byte sector
+
+void CDAudioInit(void);
+void CDAudioDone(void);
+void CDAudioPlay(uint32_t block);
+void CDAudioStop(void);
+void CDAudioPause(bool state);
+void CDAudioMute(bool state);
+bool CDAudioIsPlaying(void);
+void CDAudioMix(int16_t * buffer, int samples, int rate);
+
+#endif	// __CDAUDIO_H__
@@ -0,0 +1,609 @@
+//
+// CD image backend (CUE/BIN, ISO)
+//
+// The image files are memory mapped, and a read-ahead thread copies the
+// sectors following the last one read into a small cache. BUTCH reads the
+// disc sequentially, so while streaming the emulation thread only copies from
+// the cache and never waits on the disk (the page faults are taken by the
+// read-ahead thread). A seek simply restarts the read-ahead at the new
+// position; until it catches up, sectors are copied from the mapping directly.
+// The data path and the CD audio decoder read at their own positions, so each
+// stream has its own cache and read-ahead window.
+//
+// Sectors are handed out as 2352 raw bytes followed by 96 bytes of subcode;
+// the subcode is only there if the image has it (2448 byte sectors). Cooked
+// 2048 byte sectors get a Mode 1 header made up for them.
+//
+// A CUE sheet may split the disc in sessions with "REM SESSION nn" lines, the
+// way the Jaguar CD images are usually dumped. "REM LEAD-OUT" and "REM LEAD-IN"
+// set the gap before the next session, else the Red Book ones are used.
+//
+
+#include "cdimage.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cdintf.h"
+#include "file.h"
+#include "log.h"
+
+#define CDIMAGE_MAX_TRACKS		99
+#define CDIMAGE_MAX_SESSIONS	8
+#define CDIMAGE_LEADOUT_FIRST	6750				// 1:30:00 after the first session
+#define CDIMAGE_LEADOUT_NEXT	2250				// 0:30:00 after the next ones
+#define CDIMAGE_LEADIN			4500				// 1:00:00
+#define CDIMAGE_CACHE_SECTORS	512					// Must be a power of two
+#define CDIMAGE_READAHEAD		256					// Must be less than the cache
+#define CDIMAGE_NO_SECTOR		0xFFFFFFFF
+
+
+struct CDImageFile
+{
+	uint8_t * data;
+	uint32_t size;
+};
+
+struct CDImageTrack
+{
+	uint32_t session;					// 0 based
+	uint32_t start;						// LBA of index 01
+	uint32_t length;					// In sectors
+	uint32_t sectorSize;				// 2048, 2352 or 2448
+	uint32_t file;						// Index in cdFiles
+	uint32_t offset;					// Of index 01 in the file
+};
+
+struct CDImageStream
+{
+	uint8_t * data;
+	uint32_t tag[CDIMAGE_CACHE_SECTORS];
+	uint32_t next, end;					// Read-ahead window
+	uint32_t hits, misses;
+};
+
+// Local variables
+
+static std::vector<CDImageFile> cdFiles;
+static std::vector<CDImageTrack> cdTracks;
+static uint32_t cdSessions = 0;
+
+static CDImageStream cacheStream[CDINTF_STREAMS];
+static std::mutex cacheMutex;
+static std::condition_variable cacheCondition;
+static std::thread prefetchThread;
+static bool prefetchQuit;
+
+// Local functions
+
+static void CDImagePrefetch(void);
+static CDImageStream * CDImagePrefetchStream(void);
+
+
+static inline void CDImageLBAToMSF(uint32_t lba, uint8_t & m, uint8_t & s, uint8_t & f)
+{
+	lba += 150;
+	m = lba / (60 * 75);
+	s = (lba / 75) % 60;
+	f = lba % 75;
+}
+
+
+static inline uint8_t CDImageBCD(uint8_t value)
+{
+	return ((value / 10) << 4) | (value % 10);
+}
+
+
+//
+// Parse a mm:ss:ff time, in frames
+//
+static bool CDImageParseMSF(const char * text, uint32_t & frames)
+{
+	unsigned int m, s, f;
+
+	if (sscanf(text, "%u:%u:%u", &m, &s, &f) != 3)
+		return false;
+
+	frames = (((m * 60) + s) * 75) + f;
+	return true;
+}
+
+
+static bool CDImageMapFile(const char * path)
+{
+	CDImageFile file;
+	file.data = FileMap(path, file.size);
+
+	if (file.data == NULL)
+	{
+		WriteLog("CDIMAGE: Could not map \"%s\"!\n", path);
+		return false;
+	}
+
+	cdFiles.push_back(file);
+	return true;
+}
+
+
+//
+// Ends the last track at the end of its file, if it has no length yet
+//
+static void CDImageEndTrack(void)
+{
+	if (cdTracks.empty() || cdTracks.back().length)
+		return;
+
+	CDImageTrack & track = cdTracks.back();
+	uint32_t size = cdFiles[track.file].size;
+	track.length = (track.offset < size ? (size - track.offset) / track.sectorSize : 0);
+}
+
+
+static bool CDImageParseCue(const char * path)
+{
+	FILE * fp = fopen(path, "r");
+
+	if (fp == NULL)
+		return false;
+
+	std::string directory(path);
+	size_t slash = directory.find_last_of("/\\");
+	directory = (slash == std::string::npos ? "" : directory.substr(0, slash + 1));
+
+	char line[1024];
+	uint32_t lineNum = 0, session = 0;
+	uint32_t position = 0;					// LBA of the current file's start
+	uint32_t gap = 0;						// Not in the file, before the next track
+	uint32_t leadOut = 0, leadIn = 0;
+	uint32_t sectorSize = 0;
+	bool newTrack = false, newSession = false, ok = true;
+
+	while (ok && fgets(line, sizeof(line), fp))
+	{
+		lineNum++;
+		char * p = line;
+
+		while (isspace((unsigned char)*p))
+			p++;
+
+		if (strncmp(p, "FILE", 4) == 0)
+		{
+			CDImageEndTrack();
+
+			if (!cdTracks.empty())
+				position = cdTracks.back().start + cdTracks.back().length;
+
+			// The name may or may not be quoted, the file type after it is ignored
+			char * name = p + 4, * end;
+
+			while (isspace((unsigned char)*name))
+				name++;
+
+			if (*name == '"')
+				end = strchr(++name, '"');
+			else
+				end = name + strcspn(name, " \t\r\n");
+
+			if (end == NULL)
+				ok = false;
+			else
+			{
+				*end = 0;
+				ok = CDImageMapFile(((name[0] == '/' || strchr(name, ':')) ? std::string(name) : directory + name).c_str());
+			}
+		}
+		else if (strncmp(p, "TRACK", 5) == 0)
+		{
+			char * mode = p + 5;
+			strtoul(mode, &mode, 10);
+
+			while (isspace((unsigned char)*mode))
+				mode++;
+
+			const char * size = strchr(mode, '/');
+			sectorSize = (size ? strtoul(size + 1, NULL, 10) : (strncmp(mode, "AUDIO", 5) == 0 ? 2352 : 0));
+
+			if ((sectorSize != 2048) && (sectorSize != 2352) && (sectorSize != 2448))
+			{
+				WriteLog("CDIMAGE: Unsupported track type on line %u of the CUE sheet\n", lineNum);
+				ok = false;
+			}
+
+			ok = ok && !cdFiles.empty() && (cdTracks.size() < CDIMAGE_MAX_TRACKS);
+			newTrack = true;
+		}
+		else if (strncmp(p, "PREGAP", 6) == 0)
+		{
+			uint32_t frames;
+			ok = CDImageParseMSF(p + 6 + strspn(p + 6, " \t"), frames);
+			gap += frames;
+		}
+		else if (strncmp(p, "INDEX", 5) == 0)
+		{
+			char * index = p + 5;
+			uint32_t frames;
+
+			if ((strtoul(index, &index, 10) != 1) || !newTrack)
+				continue;
+
+			ok = CDImageParseMSF(index + strspn(index, " \t"), frames);
+
+			if (newSession)
+			{
+				gap += (leadOut ? leadOut : (session == 1 ? CDIMAGE_LEADOUT_FIRST : CDIMAGE_LEADOUT_NEXT))
+					+ (leadIn ? leadIn : CDIMAGE_LEADIN);
+				leadOut = leadIn = 0;
+				newSession = false;
+			}
+
+			// The gap shifts the rest of the file along
+			position += gap;
+
+			CDImageTrack track;
+			track.session = session;
+			track.start = position + frames;
+			track.length = 0;
+			track.sectorSize = sectorSize;
+			track.file = cdFiles.size() - 1;
+			track.offset = frames * sectorSize;
+
+			// A previous track in the same file ends where this one starts
+			if (!cdTracks.empty() && (cdTracks.back().file == track.file))
+			{
+				CDImageTrack & previous = cdTracks.back();
+				previous.length = track.start - gap - previous.start;
+				track.offset = previous.offset + (previous.length * previous.sectorSize);
+			}
+
+			CDImageEndTrack();
+			cdTracks.push_back(track);
+			newTrack = false;
+			gap = 0;
+		}
+		else if (strncmp(p, "REM", 3) == 0)
+		{
+			char * rem = p + 3 + strspn(p + 3, " \t");
+
+			if (strncmp(rem, "SESSION", 7) == 0)
+			{
+				uint32_t number = strtoul(rem + 7, NULL, 10);
+
+				if ((number > 1) && !cdTracks.empty() && (number <= CDIMAGE_MAX_SESSIONS))
+					session = number - 1, newSession = true;
+			}
+			else if (strncmp(rem, "PREGAP", 6) == 0)
+			{
+				uint32_t frames;
+				ok = CDImageParseMSF(rem + 6 + strspn(rem + 6, " \t"), frames);
+				gap += frames;
+			}
+			else if (strncmp(rem, "LEAD-OUT", 8) == 0)
+				ok = CDImageParseMSF(rem + 8 + strspn(rem + 8, " \t"), leadOut);
+			else if (strncmp(rem, "LEAD-IN", 7) == 0)
+				ok = CDImageParseMSF(rem + 7 + strspn(rem + 7, " \t"), leadIn);
+		}
+	}
+
+	fclose(fp);
+	CDImageEndTrack();
+
+	if (!ok)
+		WriteLog("CDIMAGE: Error on line %u of the CUE sheet \"%s\"\n", lineNum, path);
+
+	return ok && !cdTracks.empty();
+}
+
+
+//
+// A .iso is one cooked Mode 1 track, anything else one raw track
+//
+static bool CDImageSingleTrack(const char * path, bool cooked)
+{
+	if (!CDImageMapFile(path))
+		return false;
+
+	CDImageTrack track;
+	track.session = 0;
+	track.start = 0;
+	track.file = 0;
+	track.offset = 0;
+	track.sectorSize = (cooked ? 2048 : ((cdFiles[0].size % 2352) && !(cdFiles[0].size % 2448) ? 2448 : 2352));
+	track.length = cdFiles[0].size / track.sectorSize;
+	cdTracks.push_back(track);
+
+	return (track.length > 0);
+}
+
+
+static const CDImageTrack * CDImageFindTrack(uint32_t lba)
+{
+	for(uint32_t i=0; i<cdTracks.size(); i++)
+	{
+		if (lba - cdTracks[i].start < cdTracks[i].length)
+			return &cdTracks[i];
+	}
+
+	return NULL;
+}
+
+
+//
+// Copy a sector from the mapped image; this may have to wait on the disk
+//
+static void CDImageCopySector(uint32_t lba, uint8_t * buffer)
+{
+	const CDImageTrack * track = CDImageFindTrack(lba);
+
+	if (track == NULL)
+	{
+		// Pregaps, session gaps and past the end of the disc
+		memset(buffer, 0, CDIMAGE_SECTOR_MAX);
+		return;
+	}
+
+	const CDImageFile & file = cdFiles[track->file];
+	uint32_t offset = track->offset + ((lba - track->start) * track->sectorSize);
+	uint32_t size = (offset < file.size ? file.size - offset : 0);
+
+	if (size > track->sectorSize)
+		size = track->sectorSize;
+
+	if (track->sectorSize == 2048)
+	{
+		static const uint8_t sync[12] = { 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00 };
+		uint8_t m, s, f;
+		CDImageLBAToMSF(lba, m, s, f);
+		memcpy(buffer, sync, 12);
+		buffer[12] = CDImageBCD(m);
+		buffer[13] = CDImageBCD(s);
+		buffer[14] = CDImageBCD(f);
+		buffer[15] = 0x01;
+		memcpy(buffer + 16, file.data + offset, size);
+		memset(buffer + 16 + size, 0, CDIMAGE_SECTOR_MAX - 16 - size);
+	}
+	else
+	{
+		memcpy(buffer, file.data + offset, size);
+		memset(buffer + size, 0, CDIMAGE_SECTOR_MAX - size);
+	}
+}
+
+
+bool CDImageOpen(const char * path)
+{
+	CDImageClose();
+
+	const char * ext = strrchr(path, '.');
+	bool ok;
+
+	if (ext && (strcasecmp(ext, ".cue") == 0))
+		ok = CDImageParseCue(path);
+	else
+		ok = CDImageSingleTrack(path, (ext && (strcasecmp(ext, ".iso") == 0)));
+
+	if (!ok)
+	{
+		WriteLog("CDIMAGE: Could not open \"%s\"!\n", path);
+		CDImageClose();
+		return false;
+	}
+
+	cdSessions = cdTracks.back().session + 1;
+	WriteLog("CDIMAGE: Opened \"%s\", %u track(s) in %u session(s)\n", path, (uint32_t)cdTracks.size(), cdSessions);
+
+	for(uint32_t i=0; i<cdTracks.size(); i++)
+	{
+		uint8_t m, s, f;
+		CDImageLBAToMSF(cdTracks[i].start, m, s, f);
+		WriteLog("CDIMAGE:   Track %2u, session %u: %02u:%02u:%02u, %u sectors of %u bytes\n", i + 1, cdTracks[i].session + 1, m, s, f, cdTracks[i].length, cdTracks[i].sectorSize);
+	}
+
+	for(int i=0; i<CDINTF_STREAMS; i++)
+	{
+		cacheStream[i].data = (uint8_t *)malloc(CDIMAGE_CACHE_SECTORS * CDIMAGE_SECTOR_MAX);
+
+		for(int j=0; j<CDIMAGE_CACHE_SECTORS; j++)
+			cacheStream[i].tag[j] = CDIMAGE_NO_SECTOR;
+
+		cacheStream[i].next = cacheStream[i].end = 0;
+		cacheStream[i].hits = cacheStream[i].misses = 0;
+	}
+
+	prefetchQuit = false;
+	prefetchThread = std::thread(CDImagePrefetch);
+
+	return true;
+}
+
+
+void CDImageClose(void)
+{
+	if (prefetchThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(cacheMutex);
+			prefetchQuit = true;
+		}
+
+		cacheCondition.notify_one();
+		prefetchThread.join();
+
+		for(int i=0; i<CDINTF_STREAMS; i++)
+			WriteLog("CDIMAGE: Stream %d read-ahead cache hits: %u, misses: %u\n", i, cacheStream[i].hits, cacheStream[i].misses);
+	}
+
+	for(int i=0; i<CDINTF_STREAMS; i++)
+	{
+		free(cacheStream[i].data);
+		cacheStream[i].data = NULL;
+	}
+
+	for(uint32_t i=0; i<cdFiles.size(); i++)
+		FileUnmap(cdFiles[i].data, cdFiles[i].size);
+
+	cdFiles.clear();
+	cdTracks.clear();
+	cdSessions = 0;
+}
+
+
+bool CDImageIsOpen(void)
+{
+	return !cdTracks.empty();
+}
+
+
+//
+// Stream with sectors left in its read-ahead window, the data one first
+//
+static CDImageStream * CDImagePrefetchStream(void)
+{
+	for(int i=0; i<CDINTF_STREAMS; i++)
+	{
+		if (cacheStream[i].next < cacheStream[i].end)
+			return &cacheStream[i];
+	}
+
+	return NULL;
+}
+
+
+//
+// Read-ahead thread: fills the caches with the sectors in the windows set up
+// by CDImageReadSector(). The sector is copied without holding the lock, its
+// slot being marked empty meanwhile.
+//
+static void CDImagePrefetch(void)
+{
+	std::unique_lock<std::mutex> lock(cacheMutex);
+
+	while (true)
+	{
+		cacheCondition.wait(lock, [] { return prefetchQuit || (CDImagePrefetchStream() != NULL); });
+
+		if (prefetchQuit)
+			break;
+
+		CDImageStream * stream = CDImagePrefetchStream();
+		uint32_t lba = stream->next;
+		uint32_t slot = lba & (CDIMAGE_CACHE_SECTORS - 1);
+
+		if (stream->tag[slot] != lba)
+		{
+			stream->tag[slot] = CDIMAGE_NO_SECTOR;
+			lock.unlock();
+			CDImageCopySector(lba, stream->data + (slot * CDIMAGE_SECTOR_MAX));
+			lock.lock();
+			stream->tag[slot] = lba;
+		}
+
+		// The window may have moved meanwhile
+		if (stream->next == lba)
+			stream->next++;
+	}
+}
+
+
+//
+// Read a sector (2352 + 96 bytes) at the given LBA (00:02:00 is LBA 0), for
+// one of the CDINTF_STREAM_* readers
+//
+bool CDImageReadSector(uint32_t lba, uint8_t * buffer, uint32_t stream)
+{
+	if (cdTracks.empty() || (stream >= CDINTF_STREAMS))
+		return false;
+
+	CDImageStream & cache = cacheStream[stream];
+	uint32_t slot = lba & (CDIMAGE_CACHE_SECTORS - 1);
+	bool hit;
+
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		hit = (cache.tag[slot] == lba);
+
+		if (hit)
+		{
+			memcpy(buffer, cache.data + (slot * CDIMAGE_SECTOR_MAX), CDIMAGE_SECTOR_MAX);
+			cache.hits++;
+		}
+		else
+			cache.misses++;
+
+		// Keep the window going, or restart it after a seek
+		if ((cache.next <= lba) || (cache.next > lba + CDIMAGE_READAHEAD))
+			cache.next = lba + 1;
+
+		cache.end = lba + 1 + CDIMAGE_READAHEAD;
+	}
+
+	cacheCondition.notify_one();
+
+	if (!hit)
+	{
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDIMAGE: Stream %u read-ahead cache miss at LBA %u\n", stream, lba);
+		CDImageCopySector(lba, buffer);
+	}
+
+	return true;
+}
+
+
+uint32_t CDImageGetNumSessions(void)
+{
+	return cdSessions;
+}
+
+
+//
+// Session TOC: 0 = first track, 1 = last track, 2-4 = lead-out M, S & F
+//
+uint8_t CDImageGetSessionInfo(uint32_t session, uint32_t offset)
+{
+	uint32_t first = CDIMAGE_NO_SECTOR, last = 0;
+
+	for(uint32_t i=0; i<cdTracks.size(); i++)
+	{
+		if (cdTracks[i].session == session)
+		{
+			if (first == CDIMAGE_NO_SECTOR)
+				first = i;
+
+			last = i;
+		}
+	}
+
+	if ((first == CDIMAGE_NO_SECTOR) || (offset > 4))
+		return 0xFF;
+
+	if (offset == 0)
+		return first + 1;
+	else if (offset == 1)
+		return last + 1;
+
+	uint8_t msf[3];
+	CDImageLBAToMSF(cdTracks[last].start + cdTracks[last].length, msf[0], msf[1], msf[2]);
+
+	return msf[offset - 2];
+}
+
+
+//
+// Track start: 0 = M, 1 = S, 2 = F (tracks are 1 based)
+//
+uint8_t CDImageGetTrackInfo(uint32_t track, uint32_t offset)
+{
+	if ((track == 0) || (track > cdTracks.size()) || (offset > 2))
+		return 0xFF;
+
+	uint8_t msf[3];
+	CDImageLBAToMSF(cdTracks[track - 1].start, msf[0], msf[1], msf[2]);
+
+	return msf[offset];
+}
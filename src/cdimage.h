@@ -0,0 +1,22 @@
+//
+// CDIMAGE.H: Header file
+//
+
+#ifndef __CDIMAGE_H__
+#define __CDIMAGE_H__
+
+#include <stdint.h>
+
+#define CDIMAGE_SECTOR_SIZE		2352				// Raw sector
+#define CDIMAGE_SUBCODE_SIZE	96
+#define CDIMAGE_SECTOR_MAX		(CDIMAGE_SECTOR_SIZE + CDIMAGE_SUBCODE_SIZE)
+
+bool CDImageOpen(const char * path);
+void CDImageClose(void);
+bool CDImageIsOpen(void);
+bool CDImageReadSector(uint32_t lba, uint8_t * buffer, uint32_t stream);
+uint32_t CDImageGetNumSessions(void);
+uint8_t CDImageGetSessionInfo(uint32_t session, uint32_t offset);
+uint8_t CDImageGetTrackInfo(uint32_t track, uint32_t offset);
+
+#endif	// __CDIMAGE_H__
@@ -19,6 +19,11 @@
 // still out on whether or not to make this a conditional compilation or not.
 //
 
+//
+// A CD image (CUE/BIN or ISO, see cdimage.cpp) set with CDIntfSetImage() is
+// used instead of the drive.
+//
+
 // Comment this out if you don't have libcdio installed
 // (Actually, this is defined in the Makefile to prevent having to edit
 //  things too damn much. Jury is still out whether or not to make this
@@ -30,6 +35,9 @@
 #ifdef HAVE_LIB_CDIO
 #include <cdio/cdio.h>							// Now using OS agnostic CD access routines!
 #endif
+#include <string.h>
+#include <string>
+#include "cdimage.h"
 #include "log.h"
 
 
@@ -60,10 +68,29 @@ static void TestCDIO(void)
 #ifdef HAVE_LIB_CDIO
 static CdIo_t * cdioPtr = NULL;
 #endif
+static std::string cdImagePath;
+
+
+//
+// Use a CD image instead of the drive; this has to be set before CDIntfInit()
+//
+void CDIntfSetImage(const char * path)
+{
+	cdImagePath = (path ? path : "");
+}
+
+
+bool CDIntfHaveImage(void)
+{
+	return !cdImagePath.empty();
+}
 
 
 bool CDIntfInit(void)
 {
+	if (!cdImagePath.empty())
+		return CDImageOpen(cdImagePath.c_str());
+
 #ifdef HAVE_LIB_CDIO
 	cdioPtr = cdio_open(NULL, DRIVER_DEVICE);
 
@@ -85,6 +112,7 @@ bool CDIntfInit(void)
 void CDIntfDone(void)
 {
 	WriteLog("CDINTF: Shutting down CD-ROM subsystem.\n");
+	CDImageClose();
 
 #ifdef HAVE_LIB_CDIO
 	if (cdioPtr)
@@ -93,8 +121,21 @@ void CDIntfDone(void)
 }
 
 
-bool CDIntfReadBlock(uint32_t sector, uint8_t * buffer)
+//
+// The sector is the absolute frame number, so the first one of the program
+// area (00:02:00) is 150. The stream tells the readers apart (CDINTF_STREAM_*)
+//
+bool CDIntfReadBlock(uint32_t sector, uint8_t * buffer, uint32_t stream/*= CDINTF_STREAM_DATA*/)
 {
+	if (CDImageIsOpen())
+	{
+		if (sector >= 150)
+			return CDImageReadSector(sector - 150, buffer, stream);
+
+		memset(buffer, 0, CDIMAGE_SECTOR_MAX);
+		return true;
+	}
+
 #ifdef _MSC_VER
 #pragma message("Warning: !!! FIX !!! CDIntfReadBlock not implemented!")
 #else
@@ -108,6 +149,9 @@ bool CDIntfReadBlock(uint32_t sector, uint8_t * buffer)
 
 uint32_t CDIntfGetNumSessions(void)
 {
+	if (CDImageIsOpen())
+		return CDImageGetNumSessions();
+
 #ifdef _MSC_VER
 #pragma message("Warning: !!! FIX !!! CDIntfGetNumSessions not implemented!")
 #else
@@ -166,6 +210,9 @@ const uint8_t * CDIntfGetDriveName(uint32_t driveNum)
 
 uint8_t CDIntfGetSessionInfo(uint32_t session, uint32_t offset)
 {
+	if (CDImageIsOpen())
+		return CDImageGetSessionInfo(session, offset);
+
 #ifdef _MSC_VER
 #pragma message("Warning: !!! FIX !!! CDIntfGetSessionInfo not implemented!")
 #else
@@ -179,6 +226,9 @@ uint8_t CDIntfGetSessionInfo(uint32_t session, uint32_t offset)
 
 uint8_t CDIntfGetTrackInfo(uint32_t track, uint32_t offset)
 {
+	if (CDImageIsOpen())
+		return CDImageGetTrackInfo(track, offset);
+
 #ifdef _MSC_VER
 #pragma message("Warning: !!! FIX !!! CDIntfTrackInfo not implemented!")
 #else
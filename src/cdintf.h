@@ -9,9 +9,14 @@
 
 #include <stdint.h>
 
+// Readers of the disc, each one gets its own read-ahead
+enum { CDINTF_STREAM_DATA = 0, CDINTF_STREAM_AUDIO, CDINTF_STREAMS };
+
+void CDIntfSetImage(const char *);
+bool CDIntfHaveImage(void);
 bool CDIntfInit(void);
 void CDIntfDone(void);
-bool CDIntfReadBlock(uint32_t, uint8_t *);
+bool CDIntfReadBlock(uint32_t, uint8_t *, uint32_t stream = CDINTF_STREAM_DATA);
 uint32_t CDIntfGetNumSessions(void);
 void CDIntfSelectDrive(uint32_t);
 uint32_t CDIntfGetCurrentDrive(void);
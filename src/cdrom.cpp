@@ -19,12 +19,12 @@
 //#include "jaguar.h"									// For GET32/SET32 macros
 //#include "m68k.h"	//???
 //#include "memory.h"
+#include "cdaudio.h"
 #include "cdintf.h"									// System agnostic CD interface functions
 #include "log.h"
+#include "m68000/m68kinterface.h"
 #include "dac.h"
 
-//#define CDROM_LOG									// For CDROM logging, obviously
-
 /*
 BUTCH     equ  $DFFF00		; base of Butch=interrupt control register, R/W
 DSCNTRL   equ  BUTCH+4		; DSA control register, R/W
@@ -192,6 +192,9 @@ void CDROMInit(void)
 {
 	haveCDGoodness = CDIntfInit();
 
+	if (haveCDGoodness)
+		CDAudioInit();
+
 //GetRawTOC();
 /*uint8_t buf[2448];
 uint32_t sec = 18667 - 150;
@@ -249,10 +252,12 @@ void CDROMReset(void)
 {
 	memset(cdRam, 0x00, 0x100);
 	cdCmd = 0;
+	CDAudioStop();
 }
 
 void CDROMDone(void)
 {
+	CDAudioDone();
 	CDIntfDone();
 }
 
@@ -296,11 +301,9 @@ return;
 
 uint8_t CDROMReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
-#ifdef CDROM_LOG
 	if ((offset & 0xFF) < 12 * 4)
-		WriteLog("[%s] ", BReg[(offset & 0xFF) / 4]);
-	WriteLog("CDROM: %s reading byte $%02X from $%08X [68K PC=$%08X]\n", whoName[who], offset, cdRam[offset & 0xFF], m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "[%s] ", BReg[(offset & 0xFF) / 4]);
+	LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "CDROM: %s reading byte $%02X from $%08X [68K PC=$%08X]\n", whoName[who], offset, cdRam[offset & 0xFF], m68k_get_reg(NULL, M68K_REG_PC));
 	return cdRam[offset & 0xFF];
 }
 
@@ -354,7 +357,7 @@ uint16_t CDROMReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 			case 5:
 				data = 0x0400;
 			}//*/
-			WriteLog("CDROM: Reading DS_DATA (???), cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (???), cdCmd=$%04X\n", cdCmd);
 		}
 		else if ((cdCmd & 0xFF00) == 0x0200)			// Stop CD
 		{
@@ -378,7 +381,7 @@ uint16_t CDROMReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 			case 5:
 				data = 0x0400;
 			}//*/
-			WriteLog("CDROM: Reading DS_DATA (stop), cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (stop), cdCmd=$%04X\n", cdCmd);
 		}
 		else if ((cdCmd & 0xFF00) == 0x0300)		// Read session TOC (overview?)
 		{
@@ -412,12 +415,12 @@ TOC: 2 10 00  b 00:00:00 00 54:26:17   <-- Track #11
 			if (data == 0xFF)	// Failed...
 			{
 				data = 0x0400;
-				WriteLog("CDROM: Requested invalid session #%u (or failed to load TOC, or bad cdPtr value)\n", cdCmd & 0xFF);
+				LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_WARNING, "CDROM: Requested invalid session #%u (or failed to load TOC, or bad cdPtr value)\n", cdCmd & 0xFF);
 			}
 			else
 			{
 				data |= (0x20 | cdPtr++) << 8;
-				WriteLog("CDROM: Reading DS_DATA (session #%u TOC byte #%u): $%04X\n", cdCmd & 0xFF, cdPtr, data);
+				LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (session #%u TOC byte #%u): $%04X\n", cdCmd & 0xFF, cdPtr, data);
 			}
 
 /*			bool isValidSession = ((cdCmd & 0xFF) == 0 ? true : false);//Hardcoded... !!! FIX !!!
@@ -476,7 +479,7 @@ TOC: 2 10 00  b 00:00:00 00 54:26:17   <-- Track #11
 			if (trackNum > maxTrack)
 			{
 				data = 0x400;
-WriteLog("CDROM: Requested invalid track #%u for session #%u\n", trackNum, cdCmd & 0xFF);
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_WARNING, "CDROM: Requested invalid track #%u for session #%u\n", trackNum, cdCmd & 0xFF);
 			}
 			else
 			{
@@ -485,7 +488,7 @@ WriteLog("CDROM: Requested invalid track #%u for session #%u\n", trackNum, cdCmd
 				else if (cdPtr < 0x65)
 					data = (cdPtr << 8) | CDIntfGetTrackInfo(trackNum, (cdPtr - 2) & 0x0F);
 
-WriteLog("CDROM: Reading DS_DATA (session #%u, full TOC byte #%u): $%04X\n", cdCmd & 0xFF, (cdPtr+1) & 0x0F, data);
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (session #%u, full TOC byte #%u): $%04X\n", cdCmd & 0xFF, (cdPtr+1) & 0x0F, data);
 
 				cdPtr++;
 				if (cdPtr == 0x65)
@@ -532,28 +535,28 @@ WriteLog("CDROM: Reading DS_DATA (session #%u, full TOC byte #%u): $%04X\n", cdC
 		else if ((cdCmd & 0xFF00) == 0x1500)		// Read CD mode
 		{
 			data = cdCmd | 0x0200;	// ?? not sure ?? [Seems OK]
-			WriteLog("CDROM: Reading DS_DATA (mode), cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (mode), cdCmd=$%04X\n", cdCmd);
 		}
 		else if ((cdCmd & 0xFF00) == 0x1800)		// Spin up session #
 		{
 			data = cdCmd;
-			WriteLog("CDROM: Reading DS_DATA (spin up session), cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (spin up session), cdCmd=$%04X\n", cdCmd);
 		}
 		else if ((cdCmd & 0xFF00) == 0x5400)		// Read # of sessions
 		{
 			data = cdCmd | 0x00;	// !!! Hardcoded !!! FIX !!!
-			WriteLog("CDROM: Reading DS_DATA (# of sessions), cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (# of sessions), cdCmd=$%04X\n", cdCmd);
 		}
 		else if ((cdCmd & 0xFF00) == 0x7000)		// Read oversampling
 		{
 //NOTE: This setting will probably affect the # of DSP interrupts that need to happen. !!! FIX !!!
 			data = cdCmd;
-			WriteLog("CDROM: Reading DS_DATA (oversampling), cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading DS_DATA (oversampling), cdCmd=$%04X\n", cdCmd);
 		}
 		else
 		{
 			data = 0x0400;
-			WriteLog("CDROM: Reading DS_DATA, unhandled cdCmd=$%04X\n", cdCmd);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_WARNING, "CDROM: Reading DS_DATA, unhandled cdCmd=$%04X\n", cdCmd);
 		}
 	}
 	else if (offset == DS_DATA && !haveCDGoodness)
@@ -580,12 +583,10 @@ if (offset == 0x2E)
 	if (offset == UNKNOWN + 2)
 		data = CDROMBusRead();
 
-#ifdef CDROM_LOG
 	if ((offset & 0xFF) < 11 * 4)
-		WriteLog("[%s] ", BReg[(offset & 0xFF) / 4]);
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "[%s] ", BReg[(offset & 0xFF) / 4]);
 	if (offset != UNKNOWN && offset != UNKNOWN + 2)
-		WriteLog("CDROM: %s reading word $%04X from $%08X [68K PC=$%08X]\n", whoName[who], data, offset, m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "CDROM: %s reading word $%04X from $%08X [68K PC=$%08X]\n", whoName[who], data, offset, m68k_get_reg(NULL, M68K_REG_PC));
 	return data;
 }
 
@@ -594,11 +595,9 @@ void CDROMWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 	offset &= 0xFF;
 	cdRam[offset] = data;
 
-#ifdef CDROM_LOG
 	if ((offset & 0xFF) < 12 * 4)
-		WriteLog("[%s] ", BReg[(offset & 0xFF) / 4]);
-	WriteLog("CDROM: %s writing byte $%02X at $%08X [68K PC=$%08X]\n", whoName[who], data, offset, m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "[%s] ", BReg[(offset & 0xFF) / 4]);
+	LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "CDROM: %s writing byte $%02X at $%08X [68K PC=$%08X]\n", whoName[who], data, offset, m68k_get_reg(NULL, M68K_REG_PC));
 }
 
 void CDROMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
@@ -611,15 +610,23 @@ void CDROMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 	if (offset == DS_DATA)
 	{
 		cdCmd = data;
-		if ((data & 0xFF00) == 0x0200)				// Stop CD
+		if ((data & 0xFF00) == 0x0100)				// Play track
+		{
+			uint32_t track = data & 0xFF;
+			block = (((CDIntfGetTrackInfo(track, 0) * 60) + CDIntfGetTrackInfo(track, 1)) * 75) + CDIntfGetTrackInfo(track, 2);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Playing track #%u [block #%u]\n", track, block);
+			CDAudioPlay(block);
+		}
+		else if ((data & 0xFF00) == 0x0200)			// Stop CD
 		{
 			cdPtr = 0;
-			WriteLog("CDROM: Stopping CD\n", data & 0xFF);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Stopping CD\n", data & 0xFF);
+			CDAudioStop();
 		}
 		else if ((data & 0xFF00) == 0x0300)			// Read session TOC (short? overview?)
 		{
 			cdPtr = 0;
-			WriteLog("CDROM: Reading TOC for session #%u\n", data & 0xFF);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading TOC for session #%u\n", data & 0xFF);
 		}
 //Not sure how these three acknowledge...
 		else if ((data & 0xFF00) == 0x1000)			// Seek to minute position
@@ -635,49 +642,61 @@ void CDROMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 			frm = data & 0x00FF;
 			block = (((min * 60) + sec) * 75) + frm;
 			cdBufPtr = 2352;						// Ensure that SSI read will do so immediately
-			WriteLog("CDROM: Seeking to %u:%02u:%02u [block #%u]\n", min, sec, frm, block);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Seeking to %u:%02u:%02u [block #%u]\n", min, sec, frm, block);
+
+			// Without the I2S path to JERRY, the drive plays the audio out
+			if (!ButchIsReadyToSend())
+				CDAudioPlay(block);
 		}
+		else if ((data & 0xFF00) == 0x0400)			// Pause CD
+			CDAudioPause(true);
+		else if ((data & 0xFF00) == 0x0500)			// Unpause CD
+			CDAudioPause(false);
+		else if ((data & 0xFF00) == 0x5100)			// Mute/unmute CD (audio mode only)
+			CDAudioMute((data & 0xFF) == 0x00);
 		else if ((data & 0xFF00) == 0x1400)			// Read "full" TOC for session
 		{
 			cdPtr = 0x60,
 			minTrack = CDIntfGetSessionInfo(data & 0xFF, 0),
 			maxTrack = CDIntfGetSessionInfo(data & 0xFF, 1);
 			trackNum = minTrack;
-			WriteLog("CDROM: Reading \"full\" TOC for session #%u (min=%u, max=%u)\n", data & 0xFF, minTrack, maxTrack);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading \"full\" TOC for session #%u (min=%u, max=%u)\n", data & 0xFF, minTrack, maxTrack);
 		}
 		else if ((data & 0xFF00) == 0x1500)			// Set CDROM mode
 		{
 			// Mode setting is as follows: bit 0 set -> single speed, bit 1 set -> double,
 			// bit 3 set -> multisession CD, bit 3 unset -> audio CD
-			WriteLog("CDROM: Setting mode $%02X\n", data & 0xFF);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Setting mode $%02X\n", data & 0xFF);
 		}
 		else if ((data & 0xFF00) == 0x1800)			// Spin up session #
 		{
-			WriteLog("CDROM: Spinning up session #%u\n", data & 0xFF);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Spinning up session #%u\n", data & 0xFF);
 		}
 		else if ((data & 0xFF00) == 0x5400)			// Read # of sessions
 		{
-			WriteLog("CDROM: Reading # of sessions\n", data & 0xFF);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading # of sessions\n", data & 0xFF);
 		}
 		else if ((data & 0xFF00) == 0x7000)			// Set oversampling rate
 		{
 			// 1 = none, 2 = 2x, 3 = 4x, 4 = 8x
 			uint32_t rates[5] = { 0, 1, 2, 4, 8 };
-			WriteLog("CDROM: Setting oversample rate to %uX\n", rates[(data & 0xFF)]);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Setting oversample rate to %uX\n", rates[(data & 0xFF)]);
 		}
 		else
-			WriteLog("CDROM: Unknown command $%04X\n", data);
+			LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_WARNING, "CDROM: Unknown command $%04X\n", data);
 	}//*/
 
 	if (offset == UNKNOWN + 2)
 		CDROMBusWrite(data);
 
-#ifdef CDROM_LOG
+	// The data goes to JERRY now, not out as audio
+	if ((offset == I2CNTRL + 2) && ButchIsReadyToSend())
+		CDAudioStop();
+
 	if ((offset & 0xFF) < 11 * 4)
-		WriteLog("[%s] ", BReg[(offset & 0xFF) / 4]);
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "[%s] ", BReg[(offset & 0xFF) / 4]);
 	if (offset != UNKNOWN && offset != UNKNOWN + 2)
-		WriteLog("CDROM: %s writing word $%04X at $%08X [68K PC=$%08X]\n", whoName[who], data, offset, m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "CDROM: %s writing word $%04X at $%08X [68K PC=$%08X]\n", whoName[who], data, offset, m68k_get_reg(NULL, M68K_REG_PC));
 }
 
 //
@@ -698,10 +717,8 @@ static void CDROMBusWrite(uint16_t data)
 //This is kinda lame. What we should do is check for a 0->1 transition on either bits 0 or 1...
 //!!! FIX !!!
 
-#ifdef CDROM_LOG
 	if (data & 0xFFF0)
-		WriteLog("CDROM: BusWrite write on unknown line: $%04X\n", data);
-#endif
+		LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: BusWrite write on unknown line: $%04X\n", data);
 
 	switch (currentState)
 	{
@@ -750,9 +767,7 @@ static void CDROMBusWrite(uint16_t data)
 					counter = 0;
 					firstTime = true;
 					txData = 0;
-#ifdef CDROM_LOG
-					WriteLog("CDROM: *** BusWrite got command $%04X\n", busCmd);
-#endif
+					LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "CDROM: *** BusWrite got command $%04X\n", busCmd);
 				}
 			}
 			else
@@ -763,10 +778,8 @@ static void CDROMBusWrite(uint16_t data)
 				rxDataBit = (rxData & 0x8000) >> 12;
 				rxData <<= 1;
 				counter++;
-#ifdef CDROM_LOG
 				if (counter == 16)
-					WriteLog("CDROM: *** BusWrite got extra command $%04X\n", txData);
-#endif
+					LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "CDROM: *** BusWrite got extra command $%04X\n", txData);
 			}
 		}
 
@@ -783,23 +796,24 @@ static uint16_t CDROMBusRead(void)
 // It seems the counter == 0 simply waits for a single bit acknowledge-- !!! FIX !!!
 // Or does it? Hmm. It still "pumps" 16 bits through above, so how is this special?
 // Seems to be because it sits and looks at it as if it will change. Dunno!
-#ifdef CDROM_LOG
-	if ((counter & 0x0F) == 0)
+	if (LOG_ENABLED(LOG_CAT_CDROM, LOG_LEVEL_TRACE))
 	{
-		if (counter == 0 && rxDataBit == 0)
+		if ((counter & 0x0F) == 0)
 		{
-			if (firstTime)
+			if (counter == 0 && rxDataBit == 0)
 			{
-				firstTime = false;
-				WriteLog("0...\n");
+				if (firstTime)
+				{
+					firstTime = false;
+					WriteLog("0...\n");
+				}
 			}
+			else
+				WriteLog("%s\n", rxDataBit ? "1" : "0");
 		}
 		else
-			WriteLog("%s\n", rxDataBit ? "1" : "0");
+			WriteLog("%s", rxDataBit ? "1" : "0");
 	}
-	else
-		WriteLog("%s", rxDataBit ? "1" : "0");
-#endif
 
 	return rxDataBit;
 }
@@ -825,14 +839,15 @@ uint16_t GetWordFromButchSSI(uint32_t offset, uint32_t who/*= UNKNOWN*/)
 
 	if (cdBufPtr >= 2352)
 	{
-WriteLog("CDROM: %s reading block #%u...\n", whoName[who], block);
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: %s reading block #%u...\n", whoName[who], block);
 		//No error checking. !!! FIX !!!
 //NOTE: We have to subtract out the 1st track start as well (in cdintf_foo.cpp)!
 //		CDIntfReadBlock(block - 150, cdBuf);
 
 //Crappy kludge for shitty shit. Lesse if it works!
-		CDIntfReadBlock(block - 150, cdBuf2);
-		CDIntfReadBlock(block - 149, cdBuf3);
+		// The pregap is taken out by CDIntfReadBlock
+		CDIntfReadBlock(block, cdBuf2);
+		CDIntfReadBlock(block + 1, cdBuf3);
 		for(int i=0; i<2352-4; i+=4)
 		{
 			cdBuf[i+0] = cdBuf2[i+4];
@@ -852,9 +867,9 @@ WriteLog("CDROM: %s reading block #%u...\n", whoName[who], block);
 if (block == 244968)
 	doDSPDis = true;//*/
 
-WriteLog("[%04X:%01X]", GET16(cdBuf, cdBufPtr), offset & 0x0F);
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "[%04X:%01X]", GET16(cdBuf, cdBufPtr), offset & 0x0F);
 if (cdBufPtr % 32 == 30)
-	WriteLog("\n");
+	LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "\n");
 
 //	return GET16(cdBuf, cdBufPtr);
 //This probably isn't endian safe...
@@ -869,9 +884,7 @@ if (cdBufPtr % 32 == 30)
 
 bool ButchIsReadyToSend(void)
 {
-#ifdef LOG_CDROM_VERBOSE
-WriteLog("Butch is%s ready to send...\n", cdRam[I2CNTRL + 3] & 0x02 ? "" : " not");
-#endif
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "Butch is%s ready to send...\n", cdRam[I2CNTRL + 3] & 0x02 ? "" : " not");
 	return (cdRam[I2CNTRL + 3] & 0x02 ? true : false);
 }
 
@@ -893,7 +906,7 @@ void SetSSIWordsXmittedFromButch(void)
 
 	if (cdBufPtr >= 2352)
 	{
-WriteLog("CDROM: Reading block #%u...\n", block);
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_DEBUG, "CDROM: Reading block #%u...\n", block);
 		//No error checking. !!! FIX !!!
 //NOTE: We have to subtract out the 1st track start as well (in cdintf_foo.cpp)!
 //		CDIntfReadBlock(block - 150, cdBuf);
@@ -929,9 +942,9 @@ WriteLog("\n***** foo = %u, block = %u *****\n\n", foo, block);
 	}
 
 
-WriteLog("[%02X%02X %02X%02X]", cdBuf[cdBufPtr+1], cdBuf[cdBufPtr+0], cdBuf[cdBufPtr+3], cdBuf[cdBufPtr+2]);
+LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "[%02X%02X %02X%02X]", cdBuf[cdBufPtr+1], cdBuf[cdBufPtr+0], cdBuf[cdBufPtr+3], cdBuf[cdBufPtr+2]);
 if (cdBufPtr % 32 == 28)
-	WriteLog("\n");
+	LOGCAT(LOG_CAT_CDROM, LOG_LEVEL_TRACE, "\n");
 
 //This probably isn't endian safe...
 // But then again... It seems that even though the data on the CD is organized as
@@ -13,9 +13,38 @@
 // JLH  01/16/2010  Created this log ;-)
 //
 
-//#include "crc32.h"
+// The CRC is done 8 bytes at a time with 8 tables (slicing-by-8), derived from
+// the original one at the first use. On x86 CPUs with the carry-less multiply
+// instruction (PCLMULQDQ), 64 byte blocks are folded with it instead (see
+// Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction"); the CPU is checked at run time, so the binary runs anywhere.
+//
+// crc32_update() continues a CRC with more data, so it can be computed on
+// data as it comes (e.g. while inflating), instead of in a second pass.
+
+#include "crc32.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CRC32_PCLMUL
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CRC32_PCLMUL_TARGET
+#else
+#include <cpuid.h>
+#define CRC32_PCLMUL_TARGET		__attribute__((target("pclmul,sse4.1")))
+#endif // _MSC_VER
+#endif
 
-static unsigned long crctable[256] =
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define CRC32_BIG_ENDIAN
+#endif
+
+static const uint32_t crctable[256] =
 {
 	0x00000000L, 0x77073096L, 0xEE0E612CL, 0x990951BAL, 0x076DC419L, 0x706AF48FL, 0xE963A535L, 0x9E6495A3L,
 	0x0EDB8832L, 0x79DCB8A4L, 0xE0D5E91EL, 0x97D2D988L, 0x09B64C2BL, 0x7EB17CBDL, 0xE7B82D07L, 0x90BF1D91L,
@@ -52,12 +81,186 @@ static unsigned long crctable[256] =
 };
 
 
+// Private function prototypes
+
+typedef uint32_t (* CRCFunction)(uint32_t crc, const unsigned char * data, unsigned int length);
+static uint32_t crc32_slicing8(uint32_t crc, const unsigned char * data, unsigned int length);
+static CRCFunction crc32_select(void);
+
+
+//
+// Tables for slicing-by-8: table[n][b] is the CRC of byte b followed by n
+// zero bytes
+//
+struct CRCSliceTables
+{
+	uint32_t table[8][256];
+
+	CRCSliceTables()
+	{
+		for(int i=0; i<256; i++)
+		{
+			table[0][i] = crctable[i];
+
+			for(int n=1; n<8; n++)
+				table[n][i] = (table[n - 1][i] >> 8) ^ crctable[table[n - 1][i] & 0xFF];
+		}
+	}
+};
+
+
 int crc32_calcCheckSum(unsigned char * data, unsigned int length)
 {
-	unsigned long crc = 0xFFFFFFFF;
+	return (int)crc32_update(0, data, length);
+}
+
+
+//
+// Continue the CRC 'crc' (0 to start a new one) over 'length' more bytes
+//
+uint32_t crc32_update(uint32_t crc, const unsigned char * data, unsigned int length)
+{
+	// Chosen once, at the first call (thread safe since C++11)
+	static const CRCFunction crcFunction = crc32_select();
+
+	return crcFunction(crc ^ 0xFFFFFFFF, data, length) ^ 0xFFFFFFFF;
+}
+
 
-	for(unsigned int i=0; i<length; i++)
-		crc = crctable[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+//
+// The CRC functions below work on the CRC register (i.e. not inverted)
+//
+static uint32_t crc32_slicing8(uint32_t crc, const unsigned char * data, unsigned int length)
+{
+	static const CRCSliceTables slice;
+	const uint32_t (* t)[256] = slice.table;
+
+#ifndef CRC32_BIG_ENDIAN
+	for(; length>=8; length-=8, data+=8)
+	{
+		uint32_t one, two;
+		memcpy(&one, data, 4);
+		memcpy(&two, data + 4, 4);
+		one ^= crc;
+		crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+			^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+	}
+#endif
+
+	for(; length>0; length--)
+		crc = t[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+	return crc;
+}
+
+
+#ifdef CRC32_PCLMUL
+//
+// Fold 64 bytes at a time with carry-less multiplies, then reduce to 32 bits
+// (Barrett reduction); the rest (less than 16 bytes) is left to slicing-by-8
+//
+CRC32_PCLMUL_TARGET
+static uint32_t crc32_pclmul(uint32_t crc, const unsigned char * data, unsigned int length)
+{
+	if (length < 64)
+		return crc32_slicing8(crc, data, length);
+
+	// Folding constants, x^n mod P(x) for the reflected polynomial
+	const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);
+	const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);
+	const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163CD6124LL);
+	const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+	__m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(data + 0x00)), _mm_cvtsi32_si128(crc));
+	x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+	data += 64;
+	length -= 64;
+
+	// Four folds in parallel, 64 bytes at a time
+	for(; length>=64; length-=64, data+=64)
+	{
+		x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(data + 0x30)));
+	}
+
+	// Fold the four into one
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	// Then 16 bytes at a time
+	for(; length>=16; length-=16, data+=16)
+	{
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)data)), x5);
+	}
+
+	// 128 bits down to 64
+	x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask32);
+	x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+	// Barrett reduction down to 32
+	x2 = _mm_and_si128(x1, mask32);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask32);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	crc = (uint32_t)_mm_extract_epi32(x1, 1);
+	return crc32_slicing8(crc, data, length);
+}
+
+
+static bool crc32_havePCLMUL(void)
+{
+	unsigned int ecx;
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	ecx = (unsigned int)info[2];
+#else
+	unsigned int eax, ebx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+#endif // _MSC_VER
+
+	// PCLMULQDQ & SSE4.1
+	return ((ecx & (1 << 1)) != 0) && ((ecx & (1 << 19)) != 0);
+}
+#endif // CRC32_PCLMUL
+
+
+static CRCFunction crc32_select(void)
+{
+#ifdef CRC32_PCLMUL
+	if (crc32_havePCLMUL())
+		return crc32_pclmul;
+#endif
 
-	return crc ^ 0xFFFFFFFF;
+	return crc32_slicing8;
 }
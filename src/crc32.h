@@ -5,6 +5,9 @@
 #ifndef __CRC32_H__
 #define __CRC32_H__
 
+#include <stdint.h>
+
 extern int crc32_calcCheckSum(unsigned char * data, unsigned int length);
+extern uint32_t crc32_update(uint32_t crc, const unsigned char * data, unsigned int length);
 
 #endif	// __CRC32_H__
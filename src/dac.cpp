@@ -39,10 +39,27 @@
 // seems doubtful that anything useful could come of such a high rate, and we
 // can probably safely ignore any such ridiculously high audio rates. It won't
 // sound the same as on a real Jaguar, but who cares? :-)
+//
+// Update: running JERRY in the host audio callback made the audio crackle as
+// soon as the host was busy (the callback had to emulate ~40 ms of JERRY in
+// time), and the 48 KHz sampling of L/RTXD ignored the real I2S rate. JERRY
+// is now run along with the emulated frames (DACRunFrame), and each I2S word
+// clock puts L/RTXD into a ring buffer, at whatever rate SCLK (or the CD word
+// clock) sets. The host audio callback only resamples the ring buffer to the
+// host rate, with a windowed sinc, and adjusts the ratio a tiny bit to keep
+// the ring buffer fill around its target: the emulated frames and the host
+// audio don't run on the same clock.
+//
+// The CD audio played by the drive (see cdaudio.cpp) is mixed in by the host
+// audio callback as well.
 
 #include "dac.h"
 
+#include <string.h>
+#include <math.h>
+#include <atomic>
 #include "SDL.h"
+#include "cdaudio.h"
 #include "cdrom.h"
 #include "dsp.h"
 #include "event.h"
@@ -51,13 +68,20 @@
 #include "log.h"
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
+#include "perfcount.h"
 #include "settings.h"
+#include "wavcapture.h"
 
 
 //#define DEBUG_DAC
 
-#define BUFFER_SIZE			0x10000				// Make the DAC buffers 64K x 16 bits
 #define DAC_AUDIO_RATE		48000				// Set the audio rate to 48 KHz
+#define RING_SIZE			0x4000				// Ring buffer of 16K stereo samples
+#define RING_TARGET_USEC	50000				// Ring buffer fill we aim at
+#define RATIO_ADJUST_MAX	0.005				// Resampling ratio adjustment at most +/- 0.5%
+#define SINC_TAPS			16					// Taps of the resampling filter, even
+#define SINC_PHASES			256					// Filter phases between two input samples
+#define DAC_PI				3.14159265358979323846
 
 // Jaguar memory locations
 
@@ -70,6 +94,8 @@
 
 // Global variables
 
+bool dacHostAudio = true;						// False: no SDL audio, nothing plays the samples
+
 // These are defined in memory.h/cpp
 //uint16_t lrxd, rrxd;							// I2S ports (into Jaguar)
 
@@ -77,13 +103,29 @@
 
 static SDL_AudioSpec desired;
 static bool SDLSoundInitialized;
+static bool fastForward = false;				// True: the samples are dropped
+
+// I2S samples ring buffer; written by the emulation, read by the audio thread
+static int16_t ringBuffer[RING_SIZE][2];
+static std::atomic<uint32_t> ringWrite(0);
+static std::atomic<uint32_t> ringRead(0);
+static std::atomic<double> i2sRate(DAC_AUDIO_RATE);
+
+// Resampler state, owned by the audio thread
+static float sincTable[SINC_PHASES + 1][SINC_TAPS];
+static double sincCutoff = 0;
+static double resamplePhase = 0;
+static bool ringPrimed = false;
+static int16_t lastSample[2] = { 0, 0 };
+static bool jerryFrameDone;
 //static uint8_t SCLKFrequencyDivider = 19;			// Default is roughly 22 KHz (20774 Hz in NTSC mode)
 // /*static*/ uint16_t serialMode = 0;
 
 // Private function prototypes
 
 void SDLSoundCallback(void * userdata, Uint8 * buffer, int length);
-void DSPSampleCallback(void);
+static void DACRunJERRY(double usecs);
+static void DACFrameCallback(void);
 
 
 //
@@ -96,32 +138,33 @@ void DACInit(void)
 //	if (!vjs.audioEnabled)
 	if (!vjs.DSPEnabled)
 	{
-		WriteLog("DAC: DSP/host audio playback disabled.\n");
+		LOGCAT(LOG_CAT_DAC, LOG_LEVEL_INFO, "DAC: DSP/host audio playback disabled.\n");
 		return;
 	}
 
 	desired.freq = DAC_AUDIO_RATE;
 	desired.format = AUDIO_S16SYS;
 	desired.channels = 2;
-	desired.samples = 2048;						// 2K buffer = audio delay of 42.67 ms (@ 48 KHz)
+	desired.samples = 1024;						// 1K buffer = audio delay of 21.33 ms (@ 48 KHz)
 	desired.callback = SDLSoundCallback;
 
-	if (SDL_OpenAudio(&desired, NULL) < 0)		// NULL means SDL guarantees what we want
-		WriteLog("DAC: Failed to initialize SDL sound...\n");
+	if (!dacHostAudio)
+		LOGCAT(LOG_CAT_DAC, LOG_LEVEL_WARNING, "DAC: No host audio.\n");
+	else if (SDL_OpenAudio(&desired, NULL) < 0)	// NULL means SDL guarantees what we want
+		LOGCAT(LOG_CAT_DAC, LOG_LEVEL_ERROR, "DAC: Failed to initialize SDL sound...\n");
 	else
 	{
 		SDLSoundInitialized = true;
 		DACReset();
 		SDL_PauseAudio(false);					// Start playback!
-		WriteLog("DAC: Successfully initialized. Sample rate: %u\n", desired.freq);
+		LOGCAT(LOG_CAT_DAC, LOG_LEVEL_INFO, "DAC: Successfully initialized. Sample rate: %u\n", desired.freq);
 	}
 
 	ltxd = lrxd = desired.silence;
 	sclk = 19;									// Default is roughly 22 KHz
 
 	uint32_t riscClockRate = (vjs.hardwareTypeNTSC ? RISC_CLOCK_RATE_NTSC : RISC_CLOCK_RATE_PAL);
-	uint32_t cyclesPerSample = riscClockRate / DAC_AUDIO_RATE;
-	WriteLog("DAC: RISC clock = %u, cyclesPerSample = %u\n", riscClockRate, cyclesPerSample);
+	LOGCAT(LOG_CAT_DAC, LOG_LEVEL_INFO, "DAC: RISC clock = %u\n", riscClockRate);
 }
 
 
@@ -132,6 +175,15 @@ void DACReset(void)
 {
 //	LeftFIFOHeadPtr = LeftFIFOTailPtr = 0, RightFIFOHeadPtr = RightFIFOTailPtr = 1;
 	ltxd = lrxd = desired.silence;
+
+	if (SDLSoundInitialized)
+		SDL_LockAudio();
+
+	ringRead = ringWrite.load();
+	ringPrimed = false;
+
+	if (SDLSoundInitialized)
+		SDL_UnlockAudio();
 }
 
 
@@ -155,18 +207,80 @@ void DACDone(void)
 		SDL_CloseAudio();
 	}
 
-	WriteLog("DAC: Done.\n");
+	LOGCAT(LOG_CAT_DAC, LOG_LEVEL_INFO, "DAC: Done.\n");
+}
+
+
+//
+// Drop the samples while fast forwarding, the host audio plays silence
+//
+void DACSetFastForward(bool state)
+{
+	fastForward = state;
+}
+
+
+//
+// Put the L/RTXD word into the ring buffer, at the I2S word clock. period is
+// the time to the next word, in usec.
+//
+void DACI2SSample(double period)
+{
+	// The capture gets every sample, whatever the host audio does
+	if (wavCaptureActive)
+		WAVCaptureSample((int16_t)ltxd, (int16_t)rtxd, (uint32_t)((1000000.0 / period) + 0.5));
+
+	if (fastForward)
+		return;
+
+	uint32_t write = ringWrite.load(std::memory_order_relaxed);
+
+	// Leave room for the filter taps behind the read position
+	if ((write - ringRead.load(std::memory_order_acquire)) >= (RING_SIZE - SINC_TAPS))
+		return;
+
+	ringBuffer[write & (RING_SIZE - 1)][0] = (int16_t)ltxd;
+	ringBuffer[write & (RING_SIZE - 1)][1] = (int16_t)rtxd;
+	i2sRate.store(1000000.0 / period, std::memory_order_relaxed);
+	ringWrite.store(write + 1, std::memory_order_release);
+}
+
+
+//
+// Windowed sinc (Blackman), for SINC_PHASES fractional positions between two
+// input samples. cutoff is relative to the input Nyquist frequency.
+//
+static void DACBuildSincTable(double cutoff)
+{
+	for(int phase=0; phase<=SINC_PHASES; phase++)
+	{
+		double frac = (double)phase / SINC_PHASES;
+		double sum = 0;
+
+		for(int tap=0; tap<SINC_TAPS; tap++)
+		{
+			double x = (double)(tap - (SINC_TAPS / 2 - 1)) - frac;
+			double w = 0.42 + 0.5 * cos(DAC_PI * x / (SINC_TAPS / 2)) + 0.08 * cos(2.0 * DAC_PI * x / (SINC_TAPS / 2));
+			double sinc = (x == 0 ? 1.0 : sin(DAC_PI * cutoff * x) / (DAC_PI * cutoff * x));
+			sincTable[phase][tap] = (float)(sinc * w);
+			sum += sinc * w;
+		}
+
+		// Unity gain at DC for each phase
+		for(int tap=0; tap<SINC_TAPS; tap++)
+			sincTable[phase][tap] /= (float)sum;
+	}
+
+	sincCutoff = cutoff;
 }
 
 
-// Approach: Run the DSP for however many cycles needed to correspond to whatever sample rate
-// we've set the audio to run at. So, e.g., if we run it at 48 KHz, then we would run the DSP
-// for however much time it takes to fill the buffer. So with a 2K buffer, this would correspond
-// to running the DSP for 0.042666... seconds. At 26590906 Hz, this would correspond to
-// running the DSP for 1134545 cycles. You would then sample the L/RTXD registers every
-// 1134545 / 2048 = 554 cycles to fill the buffer. You would also have to manage interrupt
-// timing as well (generating them at the proper times), but that shouldn't be too difficult...
-// If the DSP isn't running, then fill the buffer with L/RTXD and exit.
+// Approach: JERRY is run by the emulation, which fills the ring buffer at the
+// I2S rate. Here, we only convert what is in the ring buffer to the host rate.
+// The resampling step is the rate ratio, adjusted by up to RATIO_ADJUST_MAX
+// depending on how far the ring buffer fill is from RING_TARGET_USEC. If the
+// ring buffer runs dry, the last sample is held until it is filled back to
+// its target.
 
 //
 // SDL callback routine to fill audio buffer
@@ -174,42 +288,82 @@ void DACDone(void)
 // Note: The samples are packed in the buffer in 16 bit left/16 bit right pairs.
 //       Also, length is the length of the buffer in BYTES
 //
-static Uint8 * sampleBuffer;
-static int bufferIndex = 0;
-static int numberOfSamples = 0;
-static bool bufferDone = false;
 void SDLSoundCallback(void * userdata, Uint8 * buffer, int length)
 {
-	// 1st, check to see if the DSP is running. If not, fill the buffer with L/RXTD and exit.
+	int16_t * out = (int16_t *)buffer;
+	int samples = length / 4;
+	double rate = i2sRate.load(std::memory_order_relaxed);
+	uint32_t read = ringRead.load(std::memory_order_relaxed);
+	uint32_t fill = ringWrite.load(std::memory_order_acquire) - read;
+	double target = rate * RING_TARGET_USEC / 1000000.0;
 
-	if (!DSPIsRunning())
+	if (!ringPrimed && (fill >= target))
+		ringPrimed = true;
+
+	double adjust = (fill - target) / target * RATIO_ADJUST_MAX;
+
+	if (adjust > RATIO_ADJUST_MAX)
+		adjust = RATIO_ADJUST_MAX;
+	else if (adjust < -RATIO_ADJUST_MAX)
+		adjust = -RATIO_ADJUST_MAX;
+
+	double step = rate / (double)desired.freq * (1.0 + adjust);
+
+	// Band limit to the host Nyquist frequency when going down in rate
+	double cutoff = (step > 1.0 ? 0.9 / step : 0.9);
+
+	if (fabs(cutoff - sincCutoff) > 0.01)
+		DACBuildSincTable(cutoff);
+
+	for(int i=0; i<samples; i++)
 	{
-		for(int i=0; i<(length/2); i+=2)
+		// Taps ahead of the read position have to be in the ring buffer
+		if (!ringPrimed || ((read + SINC_TAPS / 2) >= ringWrite.load(std::memory_order_acquire)))
 		{
-			((uint16_t *)buffer)[i + 0] = ltxd;
-			((uint16_t *)buffer)[i + 1] = rtxd;
+			ringPrimed = false;
+			out[(i * 2) + 0] = lastSample[0];
+			out[(i * 2) + 1] = lastSample[1];
+			continue;
 		}
 
-		return;
+		const float * taps = sincTable[(int)(resamplePhase * SINC_PHASES)];
+		uint32_t first = read - (SINC_TAPS / 2 - 1);
+		float left = 0, right = 0;
+
+		for(int tap=0; tap<SINC_TAPS; tap++)
+		{
+			int16_t * sample = ringBuffer[(first + tap) & (RING_SIZE - 1)];
+			left += taps[tap] * sample[0];
+			right += taps[tap] * sample[1];
+		}
+
+		lastSample[0] = (int16_t)(left > 32767.0f ? 32767 : (left < -32768.0f ? -32768 : left));
+		lastSample[1] = (int16_t)(right > 32767.0f ? 32767 : (right < -32768.0f ? -32768 : right));
+		out[(i * 2) + 0] = lastSample[0];
+		out[(i * 2) + 1] = lastSample[1];
+
+		resamplePhase += step;
+		read += (uint32_t)resamplePhase;
+		resamplePhase -= floor(resamplePhase);
 	}
 
-	// The length of time we're dealing with here is 1/48000 s, so we multiply this
-	// by the number of cycles per second to get the number of cycles for one sample.
-//	uint32_t riscClockRate = (vjs.hardwareTypeNTSC ? RISC_CLOCK_RATE_NTSC : RISC_CLOCK_RATE_PAL);
-//	uint32_t cyclesPerSample = riscClockRate / DAC_AUDIO_RATE;
-	// This is the length of time
-//	timePerSample = (1000000.0 / (double)riscClockRate) * ();
+	ringRead.store(read, std::memory_order_release);
+	CDAudioMix(out, samples, desired.freq);
+}
 
-	// Now, run the DSP for that length of time for each sample we need to make
 
-	bufferIndex = 0;
-	sampleBuffer = buffer;
-// If length is the length of the sample buffer in BYTES, then shouldn't the # of
-// samples be / 4? No, because we bump the sample count by 2, so this is OK.
-	numberOfSamples = length / 2;
-	bufferDone = false;
+//
+// Run JERRY for the given time, I2S samples go to the ring buffer
+//
+static void DACRunJERRY(double usecs)
+{
+	// 1st, check to see if the DSP is running. If not, there is nothing to do.
+	if (!DSPIsRunning())
+		return;
 
-	SetCallbackTime(DSPSampleCallback, 1000000.0 / (double)DAC_AUDIO_RATE, EVENT_JERRY);
+	jerryFrameDone = false;
+	SetCallbackTime(DACFrameCallback, usecs, EVENT_JERRY);
+	int perfUnit = PerfCountSwitch(PERF_DSP);
 
 	// These timings are tied to NTSC, need to fix that in event.cpp/h! [FIXED]
 	do
@@ -226,23 +380,25 @@ void SDLSoundCallback(void * userdata, Uint8 * buffer, int length)
 
 		HandleNextEvent(EVENT_JERRY);
 	}
-	while (!bufferDone);
+	while (!jerryFrameDone);
+
+	PerfCountSwitch(perfUnit);
 }
 
 
-void DSPSampleCallback(void)
+//
+// Run JERRY for one video frame (525 halflines of 31.777 usec, or 625 of 32
+// usec), after JaguarExecuteNew()
+//
+void DACRunFrame(void)
 {
-	((uint16_t *)sampleBuffer)[bufferIndex + 0] = ltxd;
-	((uint16_t *)sampleBuffer)[bufferIndex + 1] = rtxd;
-	bufferIndex += 2;
+	DACRunJERRY(vjs.hardwareTypeNTSC ? (525 * 31.777777777) : (625 * 32.0));
+}
 
-	if (bufferIndex == numberOfSamples)
-	{
-		bufferDone = true;
-		return;
-	}
 
-	SetCallbackTime(DSPSampleCallback, 1000000.0 / (double)DAC_AUDIO_RATE, EVENT_JERRY);
+static void DACFrameCallback(void)
+{
+	jerryFrameDone = true;
 }
 
 
@@ -266,7 +422,7 @@ int GetCalculatedFrequency(void)
 //
 void DACWriteByte(uint32_t offset, uint8_t data, uint32_t who/*= UNKNOWN*/)
 {
-	WriteLog("DAC: %s writing BYTE %02X at %08X\n", whoName[who], data, offset);
+	LOGCAT(LOG_CAT_DAC, LOG_LEVEL_DEBUG, "DAC: %s writing BYTE %02X at %08X\n", whoName[who], data, offset);
 	if (offset == SCLK + 3)
 		DACWriteWord(offset - 3, (uint16_t)data);
 }
@@ -284,7 +440,7 @@ void DACWriteWord(uint32_t offset, uint16_t data, uint32_t who/*= UNKNOWN*/)
 	}
 	else if (offset == SCLK + 2)					// Sample rate
 	{
-		WriteLog("DAC: Writing %u to SCLK (by %s)...\n", data, whoName[who]);
+		LOGCAT(LOG_CAT_DAC, LOG_LEVEL_DEBUG, "DAC: Writing %u to SCLK (by %s)...\n", data, whoName[who]);
 
 		sclk = data & 0xFF;
 		JERRYI2SInterruptTimer = -1;
@@ -295,7 +451,7 @@ void DACWriteWord(uint32_t offset, uint16_t data, uint32_t who/*= UNKNOWN*/)
 	{
 //		serialMode = data;
 		smode = data;
-		WriteLog("DAC: %s writing to SMODE. Bits: %s%s%s%s%s%s [68K PC=%08X]\n", whoName[who],
+		LOGCAT(LOG_CAT_DAC, LOG_LEVEL_DEBUG, "DAC: %s writing to SMODE. Bits: %s%s%s%s%s%s [68K PC=%08X]\n", whoName[who],
 			(data & 0x01 ? "INTERNAL " : ""), (data & 0x02 ? "MODE " : ""),
 			(data & 0x04 ? "WSEN " : ""), (data & 0x08 ? "RISING " : ""),
 			(data & 0x10 ? "FALLING " : ""), (data & 0x20 ? "EVERYWORD" : ""),
@@ -11,8 +11,13 @@ void DACInit(void);
 void DACReset(void);
 void DACPauseAudioThread(bool state = true);
 void DACDone(void);
+void DACRunFrame(void);
+void DACSetFastForward(bool state);
+void DACI2SSample(double period);
 //int GetCalculatedFrequency(void);
 
+extern bool dacHostAudio;
+
 // DAC memory access
 
 void DACWriteByte(uint32_t offset, uint8_t data, uint32_t who = UNKNOWN);
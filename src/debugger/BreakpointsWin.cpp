@@ -114,6 +114,18 @@ void BreakpointsWindow::UpdateInfos(void)
 			model->setItem((i + 1), 2, new QStandardItem(QString("%1").arg(brkInfo[i].HitCounts)));
 		}
 	}
+
+	// Display all watchpoints, after the user breakpoints
+	for (size_t i = 0; i < watchNbr; i++)
+	{
+		if (watchInfo[i].Used)
+		{
+			model->setItem((brkNbr + i + 1), 0, new QStandardItem(QString("%1").arg(watchInfo[i].Active ? "On" : "Off")));
+			sprintf(Addresse, "%s%s%s 0x%06X-0x%06X", ((watchInfo[i].Type & WATCH_READ) ? "R" : ""), ((watchInfo[i].Type & WATCH_WRITE) ? "W" : ""), ((watchInfo[i].Type & WATCH_CHANGE) ? "C" : ""), watchInfo[i].Start, watchInfo[i].End);
+			model->setItem((brkNbr + i + 1), 1, new QStandardItem(QString("%1").arg(Addresse)));
+			model->setItem((brkNbr + i + 1), 2, new QStandardItem(QString("%1").arg(watchInfo[i].HitCounts)));
+		}
+	}
 }
 
 
@@ -130,7 +142,7 @@ void BreakpointsWindow::UpdateTable(bool refresh)
 	if (refresh)
 	{
 		model->setRowCount(0);
-		model->insertRow(brkNbr + 1);
+		model->insertRow(brkNbr + watchNbr + 1);
 	}
 }
 
@@ -158,6 +158,8 @@ void DBGManager_Init(void)
 	DBGType = DBG_NO_TYPE;
 	DBGManager_SourceFileSearchPathsInit();
 
+	// HW labels initialisation
+	HWLABELManager_Init();
 	// ELF initialisation 
 	ELFManager_Init();
 	// DWARF initialisation
@@ -686,7 +688,7 @@ char *DBGManager_GetFunctionName(size_t Adr)
 
 	if ((DBGType & DBG_ELF) && (Symbolname == NULL))
 	{
-		Symbolname = ELFManager_GetFunctionName(Adr);
+		Symbolname = ELFManager_GetFunctionNameFromAdr(Adr, NULL);
 	}
 
 	return	Symbolname;
@@ -749,15 +751,15 @@ char *DBGManager_GetSymbolNameFromAdr(size_t Adr)
 
 
 // Get source line based on the Address and his Tag
-// Return text pointer on the source line found
+// Return text pointer on the source line found, not finished with 0; its length is returned in Length
 // Return NULL if no source line has been found
-char *DBGManager_GetLineSrcFromAdr(size_t Adr, size_t Tag)
+char *DBGManager_GetLineSrcFromAdr(size_t Adr, size_t Tag, size_t *Length)
 {
 	char *TextLine = NULL;
 
 	if ((DBGType & DBG_ELFDWARF))
 	{
-		TextLine = DWARFManager_GetLineSrcFromAdr(Adr, Tag);
+		TextLine = DWARFManager_GetLineSrcFromAdr(Adr, Tag, Length);
 	}
 
 	return	TextLine;
@@ -765,14 +767,15 @@ char *DBGManager_GetLineSrcFromAdr(size_t Adr, size_t Tag)
 
 
 // Get text line from source based on address and num line (starting from 1)
+// The text line is not finished with 0, its length is returned in Length
 // Return NULL if no text line has been found
-char *DBGManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine)
+char *DBGManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine, size_t *Length)
 {
 	char *TextLine = NULL;
 
 	if ((DBGType & DBG_ELFDWARF))
 	{
-		TextLine = DWARFManager_GetLineSrcFromAdrNumLine(Adr, NumLine);
+		TextLine = DWARFManager_GetLineSrcFromAdrNumLine(Adr, NumLine, Length);
 	}
 
 	return	TextLine;
@@ -780,14 +783,15 @@ char *DBGManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine)
 
 
 // Get text line from source based on address and num line (starting from 1)
+// The text line is not finished with 0, its length is returned in Length
 // Return NULL if no text line has been found
-char *DBGManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine)
+char *DBGManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine, size_t *Length)
 {
 	char *TextLine = NULL;
 
 	if ((DBGType & DBG_ELFDWARF))
 	{
-		TextLine = DWARFManager_GetLineSrcFromNumLineBaseAdr(Adr, NumLine);
+		TextLine = DWARFManager_GetLineSrcFromNumLineBaseAdr(Adr, NumLine, Length);
 	}
 
 	return	TextLine;
@@ -864,20 +868,50 @@ size_t *DBGManager_GetSrcNumLinesPtrFromIndex(size_t Index, bool Used)
 }
 
 
-// Get text source list pointers from source index
-char **DBGManager_GetSrcListPtrFromIndex(size_t Index, bool Used)
+// Get text source lines index from source index
+// The lines offsets are in the source code text (see DBGManager_GetSrcTextPtrFromIndex)
+DBGlinesrc *DBGManager_GetSrcListPtrFromIndex(size_t Index, bool Used)
 {
-	char **PtrSource = NULL;
+	DBGlinesrc *PtrSource = NULL;
 
 	if ((DBGType & DBG_ELFDWARF))
 	{
-		PtrSource = DWARFManager_GetSrcListPtrFromIndex(Index, Used);
+		PtrSource = (DBGlinesrc *)DWARFManager_GetSrcListPtrFromIndex(Index, Used);
 	}
 
 	return	PtrSource;
 }
 
 
+// Get source code text pointer from source index
+char *DBGManager_GetSrcTextPtrFromIndex(size_t Index)
+{
+	char *PtrText = NULL;
+
+	if ((DBGType & DBG_ELFDWARF))
+	{
+		PtrText = DWARFManager_GetSrcTextPtrFromIndex(Index);
+	}
+
+	return	PtrText;
+}
+
+
+// Get source code text load number from source index
+// The number changes each time the source code text is reloaded
+size_t DBGManager_GetSrcNumLoadFromIndex(size_t Index)
+{
+	size_t NumLoad = 0;
+
+	if ((DBGType & DBG_ELFDWARF))
+	{
+		NumLoad = DWARFManager_GetSrcNumLoadFromIndex(Index);
+	}
+
+	return	NumLoad;
+}
+
+
 // Get source language
 size_t DBGManager_GetSrcLanguageFromIndex(size_t Index)
 {
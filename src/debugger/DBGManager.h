@@ -14,6 +14,13 @@ typedef enum
 	DBGSTATUS_UNKNOWN = 0xff
 }DBGstatus;
 
+// Source code line, in the source code text; the line is not finished with 0
+typedef struct
+{
+	size_t Offset;			// Line's offset in the source code text
+	size_t Length;			// Line's length, without its new line code
+}DBGlinesrc;
+
 // Language tag based in the DW_TAG_... list from the dwarf.h
 typedef enum {
 	DBG_NO_LANG = 0x0,
@@ -271,10 +278,12 @@ extern size_t DBGManager_GetNbSources(void);
 
 // Source text lines manager
 extern size_t DBGManager_GetNumLineFromAdr(size_t Adr, size_t Tag);
-extern char *DBGManager_GetLineSrcFromAdr(size_t Adr, size_t Tag);
-extern char *DBGManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine);
-extern char *DBGManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine);
-extern char **DBGManager_GetSrcListPtrFromIndex(size_t Index, bool Used);
+extern char *DBGManager_GetLineSrcFromAdr(size_t Adr, size_t Tag, size_t *Length);
+extern char *DBGManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine, size_t *Length);
+extern char *DBGManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine, size_t *Length);
+extern char *DBGManager_GetSrcTextPtrFromIndex(size_t Index);
+extern size_t DBGManager_GetSrcNumLoadFromIndex(size_t Index);
+extern DBGlinesrc *DBGManager_GetSrcListPtrFromIndex(size_t Index, bool Used);
 extern size_t DBGManager_GetSrcNbListPtrFromIndex(size_t Index, bool Used);
 extern size_t *DBGManager_GetSrcNumLinesPtrFromIndex(size_t Index, bool Used);
 
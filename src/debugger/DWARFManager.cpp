@@ -30,9 +30,15 @@
 #include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#include "libelf.h"
 #include "libdwarf.h"
 #include "dwarf.h"
 #include "LEB128.h"
+#include "crc32.h"
+#include "file.h"
 #include "DWARFManager.h"
 
 // Definitions for debugging
@@ -42,9 +48,6 @@
 //#define DEBUG_TypeDef			DW_TAG_typedef		// Type def to look for or undefine it (not used / not supported)
 //#define DEBUG_Filename		"crt0"			// Filename to look for or undefine it
 
-// Definitions for handling data
-//#define CONVERT_QT_HML								// Text will be converted as HTML
-
 // Definitions for the variables's typetag
 #define	TypeTag_structure			0x01			// structure
 #define	TypeTag_pointer				0x02			// pointer
@@ -56,13 +59,18 @@
 #define TypeTag_subroutine_type		0x80			// subroutine
 #define TypeTag_union				0x100			// union
 
+// Debug information cache
+#define DWARFCACHE_EXTENSION		".dbgcache"
+#define DWARFCACHE_MAGIC			0x43444256		// "VBDC"
+#define DWARFCACHE_VERSION			1
+#define DWARFCACHE_HEADERSIZE		(5 * sizeof(uint32_t))	// Magic, version, ELF's CRC32 & size, number of records
+
 
 // Source line CU structure
 typedef struct CUStruct_LineSrc
 {
 	size_t StartPC;
 	size_t NumLineSrc;
-	char *PtrLineSrc;
 }S_CUStruct_LineSrc;
 
 // Source line internal structure
@@ -71,7 +79,6 @@ typedef struct DMIStruct_LineSrc
 	size_t Tag;
 	size_t StartPC;
 	size_t NumLineSrc;
-	char *PtrLineSrc;
 }S_DMIStruct_LineSrc;
 
 // Enumeration structure
@@ -131,10 +138,10 @@ typedef struct SubProgStruct
 	size_t StartPC;
 	size_t LowPC, HighPC;
 	size_t FrameBase;
-	char *PtrLineSrc;
 	char *PtrSubprogramName;						// Sub program name
 	size_t NbLinesSrc;								// Number of lines source used by the sub program
 	DMIStruct_LineSrc *PtrLinesSrc;					// Pointer of the lines source for the sub program
+	bool LinesSrcSorted;							// Lines source are sorted by address
 	size_t NbVariables;								// Variables number
 	VariablesStruct *PtrVariables;					// Pointer to the local variables list information structure
 }S_SubProgStruct;
@@ -150,9 +157,12 @@ typedef struct CUStruct
 	char *PtrSourceFileDirectory;					// Directory of the source file
 	char *PtrFullFilename;							// Pointer to full namefile (directory & filename)
 	size_t SizeLoadSrc;								// Source code text size
-	char *PtrLoadSrc;								// Pointer to the source code text
+	char *PtrLoadSrc;								// Pointer to the source code text (read only file mapping)
+	bool LoadedSrc;									// Source code text and lines index have been loaded
+	size_t NumLoadSrc;								// Source code text load number, changed by each (re)load
+	time_t CheckSrcTime;							// Last check of the source file modification
 	size_t NbLinesLoadSrc;							// Total number of lines in the source code text
-	char **PtrLinesLoadSrc;							// Pointer lists to each source line put in QT html/text conformity
+	DWARFlinesrc *PtrLinesLoadSrc;					// Lines index, with the offset and the length of each source line in the source code text
 	size_t NbSubProgs;								// Number of sub programs / routines
 	SubProgStruct *PtrSubProgs;						// Pointer to the sub programs / routines structure
 	size_t NbTypes;									// Number of types
@@ -163,12 +173,69 @@ typedef struct CUStruct
 	size_t NbUsedLinesSrc;							// Number of used source lines
 	size_t LastNumUsedLinesSrc;						// Last number line used
 	CUStruct_LineSrc *PtrUsedLinesSrc;				// Pointer to the used source lines list structure
-	char **PtrUsedLinesLoadSrc;						// Pointer lists to each used source line referenced by the CUStruct_LineSrc structure
+	DWARFlinesrc *PtrUsedLinesLoadSrc;				// Lines index of each used source line referenced by the CUStruct_LineSrc structure
 	size_t *PtrUsedNumLines;						// List of the number lines used
 	struct stat _statbuf;							// File information
 	DWARFstatus Status;								// File status
+	size_t Offset;									// Die's offset
+	bool Loaded;									// Die, source lines and source code have been loaded
 }S_CUStruct;
 
+// Address index item: a sub program, or the CU itself (SubProg is then the CU's number of sub programs)
+// The items come in the order the CU, and their sub programs, were scanned
+typedef struct AdrIndexItemStruct
+{
+	size_t CU;
+	size_t SubProg;
+}S_AdrIndexItemStruct;
+
+// Address index segment, and the items covering it
+typedef struct AdrIndexSegmentStruct
+{
+	size_t StartPC, EndPC;
+	size_t FirstItem;
+	size_t NbItems;
+}S_AdrIndexSegmentStruct;
+
+// Address index range, used to build the segments
+typedef struct AdrIndexRangeStruct
+{
+	size_t StartPC, EndPC;
+	AdrIndexItemStruct Item;
+}S_AdrIndexRangeStruct;
+
+// Address index entry for an exact address (sub program start, or used source line)
+typedef struct AdrIndexEntryStruct
+{
+	size_t StartPC;
+	size_t CU;
+	size_t Index;
+}S_AdrIndexEntryStruct;
+
+// Debug information cache record of a CU, in the records table following the cache header
+typedef struct CacheRecordStruct
+{
+	uint32_t Offset;								// CU Die's offset
+	uint32_t Position;								// Record's position in the cache file
+	uint32_t Size;									// Record's size
+}S_CacheRecordStruct;
+
+// Debug information cache buffer, used to build the cache
+typedef struct CacheBufferStruct
+{
+	size_t Size;
+	size_t SizeAlloc;
+	uint8_t *Ptr;
+}S_CacheBufferStruct;
+
+// Debug information cache read, of a CU record
+typedef struct CacheReadStruct
+{
+	uint8_t *Ptr;
+	uint8_t *PtrEnd;
+	bool Error;										// The read went beyond the record
+}S_CacheReadStruct;
+
 
 // Dwarf management
 uint32_t LibDwarf;
@@ -181,14 +248,57 @@ char **ListSearchPaths;
 size_t NbSearchPaths;
 struct stat FileElfExeInfo;
 
+// Address index
+static size_t NbAdrIndexSegments;
+static AdrIndexSegmentStruct *PtrAdrIndexSegments;
+static AdrIndexItemStruct *PtrAdrIndexItems;
+static size_t NbAdrIndexSubProgs;
+static AdrIndexEntryStruct *PtrAdrIndexSubProgs;
+static size_t NbAdrIndexUsedLines;
+static AdrIndexEntryStruct *PtrAdrIndexUsedLines;
+
+// Debug information cache
+static char *PtrCachePath;
+static uint8_t *PtrCache;							// Cache file mapping
+static uint32_t SizeCache;
+static size_t NbCacheRecords;
+static uint32_t CacheCRC, CacheSizeElf;				// ELF the cache is made for
+static bool CacheDirty;								// Some CU have been decoded from the DWARF
+
 
 // Function declarations
 Dwarf_Handler DWARFManager_ErrorHandler(Dwarf_Ptr perrarg);
 void DWARFManager_InitDMI(void);
 void DWARFManager_CloseDMI(void);
+bool DWARFManager_LoadCU(size_t NumCU);
+void DWARFManager_LoadAllCU(void);
+void DWARFManager_LoadSrcFromIndex(size_t Index);
+void DWARFManager_LoadCUSrc(size_t NumCU);
+void DWARFManager_CloseCUSrc(size_t NumCU);
+char *DWARFManager_GetCULineSrc(size_t NumCU, size_t NumLine, size_t *Length);
+void DWARFManager_CloseCUInfos(size_t NumCU);
+void DWARFManager_CacheInit(Elf *ElfPtr, const char *PathElf);
+void DWARFManager_CacheClose(void);
+CacheRecordStruct *DWARFManager_CacheGetRecord(size_t Offset);
+void DWARFManager_CachePut(CacheBufferStruct *PtrBuffer, const void *PtrData, size_t Size);
+void DWARFManager_CachePutValue(CacheBufferStruct *PtrBuffer, size_t Value);
+void DWARFManager_CachePutString(CacheBufferStruct *PtrBuffer, char *PtrString);
+void DWARFManager_CachePutVariable(CacheBufferStruct *PtrBuffer, VariablesStruct *PtrVariable);
+size_t DWARFManager_CacheGetValue(CacheReadStruct *PtrRead);
+size_t DWARFManager_CacheGetCount(CacheReadStruct *PtrRead);
+char *DWARFManager_CacheGetString(CacheReadStruct *PtrRead);
+void DWARFManager_CacheGetVariable(CacheReadStruct *PtrRead, VariablesStruct *PtrVariable);
+void DWARFManager_CacheSaveCU(CacheBufferStruct *PtrBuffer, size_t NumCU);
+bool DWARFManager_CacheLoadCU(size_t NumCU);
+void DWARFManager_InitAdrIndex(void);
+void DWARFManager_CloseAdrIndex(void);
+AdrIndexSegmentStruct *DWARFManager_FindAdrIndexSegment(size_t Adr);
+AdrIndexSegmentStruct *DWARFManager_GetAdrIndexSegment(size_t Adr);
+AdrIndexEntryStruct *DWARFManager_GetAdrIndexEntry(AdrIndexEntryStruct *PtrEntries, size_t NbEntries, size_t Adr, size_t CU);
+SubProgStruct *DWARFManager_GetSubProgFromAdr(size_t Adr);
+DMIStruct_LineSrc *DWARFManager_GetSubProgLineSrc(SubProgStruct *PtrSubProg, size_t Adr, size_t Tag);
 bool DWARFManager_ElfClose(void);
-char *DWARFManager_GetLineSrcFromNumLine(char *PtrSrcFile, size_t NumLine);
-void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables);
+void DWARFManager_InitInfosVariable(size_t NumCU, VariablesStruct *PtrVariables);
 void DWARFManager_SourceFileSearchPathsInit(void);
 void DWARFManager_SourceFileSearchPathsReset(void);
 void DWARFManager_SourceFileSearchPathsClose(void);
@@ -263,12 +373,15 @@ bool DWARFManager_Close(void)
 
 
 // Dwarf manager Elf init
-int	DWARFManager_ElfInit(Elf *ElfPtr, struct stat FileElfInfo)
+// The debug information cache is located next to the ELF file
+int	DWARFManager_ElfInit(Elf *ElfPtr, struct stat FileElfInfo, const char *PathElf)
 {
 	if ((LibDwarf = dwarf_elf_init(ElfPtr, DW_DLC_READ, (Dwarf_Handler)DWARFManager_ErrorHandler, errarg, &dbg, &error)) == DW_DLV_OK)
 	{
 		FileElfExeInfo = FileElfInfo;
+		DWARFManager_CacheInit(ElfPtr, PathElf);
 		DWARFManager_InitDMI();
+		DWARFManager_InitAdrIndex();
 	}
 
 	return LibDwarf;
@@ -302,262 +415,1204 @@ bool DWARFManager_ElfClose(void)
 // Dwarf manager Compilation Units close
 void DWARFManager_CloseDMI(void)
 {
+	DWARFManager_CacheClose();
+	DWARFManager_CloseAdrIndex();
+
 	// loop on all CU
 	while (NbCU--)
 	{
 		// free pointers
 		free(PtrCU[NbCU].PtrFullFilename);
-		free(PtrCU[NbCU].PtrLoadSrc);
 		free(PtrCU[NbCU].PtrProducer);
 		free(PtrCU[NbCU].PtrSourceFilename);
 		free(PtrCU[NbCU].PtrSourceFileDirectory);
-		free(PtrCU[NbCU].PtrUsedLinesSrc);
-		free(PtrCU[NbCU].PtrUsedLinesLoadSrc);
-		free(PtrCU[NbCU].PtrUsedNumLines);
 
-		// free lines from the source code
-		while (PtrCU[NbCU].NbLinesLoadSrc--)
-		{
-			free(PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].NbLinesLoadSrc]);
-		}
+		// free the source code text, and its lines index
+		FileUnmap((uint8_t *)PtrCU[NbCU].PtrLoadSrc, (uint32_t)PtrCU[NbCU].SizeLoadSrc);
 		free(PtrCU[NbCU].PtrLinesLoadSrc);
 
-		// free the functions information
-		while (PtrCU[NbCU].NbSubProgs--)
-		{
-			while (PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables--)
-			{
-				free(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].PtrName);
-				free(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].PtrTypeName);
-			}
-			free(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables);
+		// free the information decoded from the DWARF
+		DWARFManager_CloseCUInfos(NbCU);
+	}
+
+	// free the CU
+	free(PtrCU);
+}
 
-			free(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrLinesSrc);
-			free(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrSubprogramName);
+
+// Dwarf manager Compilation Unit close of the information decoded from the DWARF
+// The CU is left as before its load from the DWARF
+void DWARFManager_CloseCUInfos(size_t NumCU)
+{
+	free(PtrCU[NumCU].PtrUsedLinesSrc);
+	free(PtrCU[NumCU].PtrUsedLinesLoadSrc);
+	free(PtrCU[NumCU].PtrUsedNumLines);
+
+	// free the functions information
+	while (PtrCU[NumCU].NbSubProgs--)
+	{
+		while (PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables--)
+		{
+			free(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].PtrName);
+			free(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].PtrTypeName);
 		}
-		free(PtrCU[NbCU].PtrSubProgs);
+		free(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables);
+
+		free(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrLinesSrc);
+		free(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrSubprogramName);
+	}
+	free(PtrCU[NumCU].PtrSubProgs);
+
+	// free the types
+	while (PtrCU[NumCU].NbTypes--)
+	{
+		free(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrName);
 
-		// free the types
-		while (PtrCU[NbCU].NbTypes--)
+		// free the structure's members
+		while (PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers--)
 		{
-			free(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrName);
+			free(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].PtrName);
+		}
+		free(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers);
+	}
+	free(PtrCU[NumCU].PtrTypes);
 
-			// free the structure's members
-			while (PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers--)
-			{
-				free(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].PtrName);
-			}
-			free(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers);
+	// free variables
+	while (PtrCU[NumCU].NbVariables--)
+	{
+		free(PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrName);
+		free(PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrTypeName);
+
+		// free the variable's members
+		while (PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].NbTabVariables--)
+		{
+			free(PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].TabVariables[PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].NbTabVariables]);
 		}
-		free(PtrCU[NbCU].PtrTypes);
+	}
+	free(PtrCU[NumCU].PtrVariables);
+
+	PtrCU[NumCU].NbUsedLinesSrc = 0;
+	PtrCU[NumCU].PtrUsedLinesSrc = NULL;
+	PtrCU[NumCU].PtrUsedLinesLoadSrc = NULL;
+	PtrCU[NumCU].PtrUsedNumLines = NULL;
+	PtrCU[NumCU].NbSubProgs = 0;
+	PtrCU[NumCU].PtrSubProgs = NULL;
+	PtrCU[NumCU].NbTypes = 0;
+	PtrCU[NumCU].PtrTypes = NULL;
+	PtrCU[NumCU].NbVariables = 0;
+	PtrCU[NumCU].PtrVariables = NULL;
+	PtrCU[NumCU].NbFrames = 0;
+}
+
+
+// Debug information cache
+// The CU information decoded from the DWARF is kept in a file next to the ELF, and is used by the next runs instead of libdwarf
+// The cache is only valid for the ELF's CRC32 and size it has been saved with
+// Numbers are stored as unsigned LEB128, and strings by their length (0 for a NULL string) then their text
+// Only the information coming from the DWARF is stored; the source code and what is set from it, are set again at each load
+
+
+// Open the cache of the ELF, and check if it can be used
+void DWARFManager_CacheInit(Elf *ElfPtr, const char *PathElf)
+{
+	char *PtrRaw;
+	size_t SizeRaw;
+
+	// Initialisation for the cache
+	PtrCache = NULL;
+	SizeCache = 0;
+	NbCacheRecords = 0;
+	CacheDirty = false;
+	PtrCachePath = NULL;
+
+	// The cache is keyed by the ELF's content
+	if (PathElf && (PtrRaw = elf_rawfile(ElfPtr, &SizeRaw)))
+	{
+		CacheCRC = (uint32_t)crc32_calcCheckSum((unsigned char *)PtrRaw, (unsigned int)SizeRaw);
+		CacheSizeElf = (uint32_t)SizeRaw;
 
-		// free variables
-		while (PtrCU[NbCU].NbVariables--)
+		if ((PtrCachePath = (char *)calloc(strlen(PathElf) + sizeof(DWARFCACHE_EXTENSION), 1)))
 		{
-			free(PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrName);
-			free(PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrTypeName);
+			strcat(strcpy(PtrCachePath, PathElf), DWARFCACHE_EXTENSION);
 
-			// free the variable's members
-			while (PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].NbTabVariables--)
+			if ((PtrCache = FileMap(PtrCachePath, SizeCache)))
 			{
-				free(PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].TabVariables[PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].NbTabVariables]);
+				uint32_t *PtrHeader = (uint32_t *)PtrCache;
+
+				// Check the header, and the records table size
+				if ((SizeCache >= DWARFCACHE_HEADERSIZE) && (PtrHeader[0] == DWARFCACHE_MAGIC) && (PtrHeader[1] == DWARFCACHE_VERSION) && (PtrHeader[2] == CacheCRC) && (PtrHeader[3] == CacheSizeElf) && (PtrHeader[4] <= ((SizeCache - DWARFCACHE_HEADERSIZE) / sizeof(CacheRecordStruct))))
+				{
+					NbCacheRecords = PtrHeader[4];
+				}
+				else
+				{
+					FileUnmap(PtrCache, SizeCache);
+					PtrCache = NULL;
+					SizeCache = 0;
+				}
 			}
 		}
-		free(PtrCU[NbCU].PtrVariables);
 	}
-
-	// free the CU
-	free(PtrCU);
 }
 
 
-// Dwarf manager Compilation Units initialisations
-void DWARFManager_InitDMI(void)
+// Close the cache, and save it if some CU have been decoded from the DWARF
+// The CU not loaded in this run keep the record they have in the current cache
+void DWARFManager_CacheClose(void)
 {
-	Dwarf_Unsigned	next_cu_header, return_uvalue;
-	Dwarf_Error	error;
-	Dwarf_Attribute	*atlist;
-	Dwarf_Attribute	return_attr1;
-	Dwarf_Half return_tagval, return_attr;
-	Dwarf_Half version, offset_size;
-	Dwarf_Addr return_lowpc, return_highpc, return_lineaddr;
-	Dwarf_Block *return_block;
-	Dwarf_Signed atcnt, cnt, return_value;
-	Dwarf_Die return_sib, return_die, return_sub, return_subdie;
-	Dwarf_Off return_offset;
-	Dwarf_Line *linebuf;
-	Dwarf_Half form;
-	FILE *SrcFile;
-	char *return_string;
-	char *Ptr, *Ptr1;
-
-	// Initialisation for the Compilation Units table
-	NbCU = 0;
-	PtrCU = NULL;
-
-	// loop on the available Compilation Unit
-	while (dwarf_next_cu_header_b(dbg, NULL, &version, NULL, NULL, &offset_size, NULL, &next_cu_header, &error) == DW_DLV_OK)
+	CacheBufferStruct Buffer, Records;
+	CacheRecordStruct *PtrRecord;
+	uint32_t Header[5];
+	char *PtrTempPath;
+	FILE *CacheFile;
+	bool Saved;
+
+	if (CacheDirty && PtrCachePath)
 	{
-		// Allocation of an additional Compilation Unit structure in the table
-		if (Ptr = (char *)realloc(PtrCU, ((NbCU + 1) * sizeof(CUStruct))))
-		{
-			// Compilation Unit RAZ
-			PtrCU = (CUStruct *)Ptr;
-			memset(PtrCU + NbCU, 0, sizeof(CUStruct));
+		memset(&Buffer, 0, sizeof(Buffer));
+		memset(&Records, 0, sizeof(Records));
 
-			// Debug specific CU
-#ifdef DEBUG_NumCU
-			if (NbCU == DEBUG_NumCU)
-#endif
+		// Serialize the CU records, in the CU order
+		for (size_t i = 0; i < NbCU; i++)
+		{
+			if (PtrCU[i].Offset)
 			{
-				// Get 1st Die from the Compilation Unit
-				if (dwarf_siblingof(dbg, NULL, &return_sib, &error) == DW_DLV_OK)
+				CacheRecordStruct Record;
+
+				Record.Offset = (uint32_t)PtrCU[i].Offset;
+				Record.Position = (uint32_t)Buffer.Size;
+
+				if (PtrCU[i].Loaded)
 				{
-					// Get Die's Tag
-					if ((dwarf_tag(return_sib, &return_tagval, &error) == DW_DLV_OK))
+					DWARFManager_CacheSaveCU(&Buffer, i);
+				}
+				else
+				{
+					if ((PtrRecord = DWARFManager_CacheGetRecord(PtrCU[i].Offset)))
 					{
-						PtrCU[NbCU].Tag = return_tagval;
-
-						// Die type detection
-						switch (return_tagval)
-						{
-						case DW_TAG_compile_unit:
-							if (dwarf_attrlist(return_sib, &atlist, &atcnt, &error) == DW_DLV_OK)
-							{
-								for (Dwarf_Signed i = 0; i < atcnt; ++i)
-								{
-									if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
-									{
-										switch (return_attr)
-										{
-											// Start address
-										case DW_AT_low_pc:
-											if (dwarf_lowpc(return_sib, &return_lowpc, &error) == DW_DLV_OK)
-											{
-												PtrCU[NbCU].LowPC = return_lowpc;
-											}
-											break;
+						DWARFManager_CachePut(&Buffer, PtrCache + PtrRecord->Position, PtrRecord->Size);
+					}
+					else
+					{
+						continue;
+					}
+				}
 
-											// End address
-										case DW_AT_high_pc:
-											if (dwarf_highpc(return_sib, &return_highpc, &error) == DW_DLV_OK)
-											{
-												PtrCU[NbCU].HighPC = return_highpc;
-											}
-											break;
+				Record.Size = (uint32_t)(Buffer.Size - Record.Position);
+				DWARFManager_CachePut(&Records, &Record, sizeof(Record));
+			}
+		}
 
-											// compilation information
-										case DW_AT_producer:
-											if (dwarf_formstring(atlist[i], &return_string, &error) == DW_DLV_OK)
-											{
-												PtrCU[NbCU].PtrProducer = (char *)calloc(strlen(return_string) + 1, 1);
-												strcpy(PtrCU[NbCU].PtrProducer, return_string);
-												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-											}
-											break;
+		// Records positions are from the file's start
+		Header[0] = DWARFCACHE_MAGIC;
+		Header[1] = DWARFCACHE_VERSION;
+		Header[2] = CacheCRC;
+		Header[3] = CacheSizeElf;
+		Header[4] = (uint32_t)(Records.Size / sizeof(CacheRecordStruct));
 
-											// Filename
-										case DW_AT_name:
-											if (dwarf_formstring(atlist[i], &return_string, &error) == DW_DLV_OK)
-											{
-#ifdef DEBUG_Filename
-												if (strstr(return_string, DEBUG_Filename))
-#endif
-												{
-													PtrCU[NbCU].PtrSourceFilename = (char *)calloc((strlen(return_string) + 1), 1);
-													strcpy(PtrCU[NbCU].PtrSourceFilename, return_string);
-												}
-												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-											}
-											break;
+		for (size_t i = 0; i < Header[4]; i++)
+		{
+			((CacheRecordStruct *)Records.Ptr)[i].Position += (uint32_t)(DWARFCACHE_HEADERSIZE + Records.Size);
+		}
 
-											// Directory name
-										case DW_AT_comp_dir:
-											if (dwarf_formstring(atlist[i], &return_string, &error) == DW_DLV_OK)
-											{
-												PtrCU[NbCU].PtrSourceFileDirectory = (char *)calloc((strlen(return_string) + 1), 1);
-												strcpy(PtrCU[NbCU].PtrSourceFileDirectory, return_string);
-												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-											}
-											break;
+		// Write the cache in a temporary file, and replace the cache with it
+		Saved = false;
 
-											// Language
-										case DW_AT_language:
-											if (dwarf_formudata(atlist[i], &return_uvalue, &error) == DW_DLV_OK)
-											{
-												PtrCU[NbCU].Language = return_uvalue;
-											}
-											break;
+		if ((PtrTempPath = (char *)calloc(strlen(PtrCachePath) + 5, 1)))
+		{
+			strcat(strcpy(PtrTempPath, PtrCachePath), ".tmp");
 
-										default:
-											break;
-										}
-									}
-									dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
-								}
-								dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
-							}
+			if ((CacheFile = fopen(PtrTempPath, "wb")))
+			{
+				Saved = (fwrite(Header, sizeof(Header), 1, CacheFile) == 1);
+				Saved = (!Records.Size || (fwrite(Records.Ptr, Records.Size, 1, CacheFile) == 1)) && Saved;
+				Saved = (!Buffer.Size || (fwrite(Buffer.Ptr, Buffer.Size, 1, CacheFile) == 1)) && Saved;
+				Saved = (fclose(CacheFile) == 0) && Saved;
 
-							// Check filename presence
-							if (!PtrCU[NbCU].PtrSourceFilename)
-							{
-								PtrCU[NbCU].PtrSourceFilename = (char *)calloc(1, 1);
-							}
+				// The cache file is mapped, and must be released before being replaced
+				if (PtrCache)
+				{
+					FileUnmap(PtrCache, SizeCache);
+					PtrCache = NULL;
+				}
 
-							// Check directory presence
-							if (!PtrCU[NbCU].PtrSourceFileDirectory)
-							{
-								// Check if file exists in the search paths
-								for (size_t i = 0; i < NbSearchPaths; i++)
-								{
-									PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + strlen((const char *)ListSearchPaths[i]) + 2);
 #if defined(_WIN32)
-									sprintf(PtrCU[NbCU].PtrFullFilename, "%s\\%s", ListSearchPaths[i], PtrCU[NbCU].PtrSourceFilename);
-									if (!fopen_s(&SrcFile, PtrCU[NbCU].PtrFullFilename, "rb"))
+				Saved = Saved && MoveFileExA(PtrTempPath, PtrCachePath, MOVEFILE_REPLACE_EXISTING);
 #else
-									sprintf(PtrCU[NbCU].PtrFullFilename, "%s/%s", ListSearchPaths[i], PtrCU[NbCU].PtrSourceFilename);
-									SrcFile = fopen(PtrCU[NbCU].PtrFullFilename, "rb");
-									if (SrcFile == NULL)
+				Saved = Saved && (rename(PtrTempPath, PtrCachePath) == 0);
 #endif
-									{
-										PtrCU[NbCU].PtrSourceFileDirectory = (char *)realloc(PtrCU[NbCU].PtrSourceFileDirectory, strlen(ListSearchPaths[i]) + 1);
-										strcpy(PtrCU[NbCU].PtrSourceFileDirectory, ListSearchPaths[i]);
-									}
-								}
+				if (!Saved)
+				{
+					remove(PtrTempPath);
+				}
+			}
 
-								// File directory doesn't exits
-								if (!PtrCU[NbCU].PtrSourceFileDirectory)
-								{
-									PtrCU[NbCU].PtrSourceFileDirectory = (char *)realloc(PtrCU[NbCU].PtrSourceFileDirectory, 2);
-									strcpy(PtrCU[NbCU].PtrSourceFileDirectory, ".");
-								}
-							}
+			free(PtrTempPath);
+		}
 
-							// Conform slashes / backslashes for the filename
-							DWARFManager_ConformSlachesBackslashes(PtrCU[NbCU].PtrSourceFilename);
+		free(Buffer.Ptr);
+		free(Records.Ptr);
+	}
 
-							// Check if filename contains already the complete directory
-							if (PtrCU[NbCU].PtrSourceFilename[1] == ':')
-							{
-								// Copy the filename as the full filename
-								PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + 1);
-								strcpy(PtrCU[NbCU].PtrFullFilename, PtrCU[NbCU].PtrSourceFilename);
-							}
-							else
-							{
-								// Create full filename and Conform slashes / backslashes
-								PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + strlen(PtrCU[NbCU].PtrSourceFileDirectory) + 2);
-#if defined(_WIN32)
-								sprintf(PtrCU[NbCU].PtrFullFilename, "%s\\%s", PtrCU[NbCU].PtrSourceFileDirectory, PtrCU[NbCU].PtrSourceFilename);
-#else
-								sprintf(PtrCU[NbCU].PtrFullFilename, "%s/%s", PtrCU[NbCU].PtrSourceFileDirectory, PtrCU[NbCU].PtrSourceFilename);
-#endif
-							}
+	if (PtrCache)
+	{
+		FileUnmap(PtrCache, SizeCache);
+	}
 
-							DWARFManager_ConformSlachesBackslashes(PtrCU[NbCU].PtrFullFilename);
+	free(PtrCachePath);
+	PtrCache = NULL;
+	SizeCache = 0;
+	NbCacheRecords = 0;
+	CacheDirty = false;
+	PtrCachePath = NULL;
+}
 
-							// Directory path clean-up
-#if defined(_WIN32)
+
+// Get the cache record of a CU, based on its Die's offset
+// Return NULL if the CU doesn't have a record, or if its record doesn't fit in the cache
+CacheRecordStruct *DWARFManager_CacheGetRecord(size_t Offset)
+{
+	CacheRecordStruct *PtrCacheRecords;
+	size_t Low = 0, High = NbCacheRecords;
+
+	if (!PtrCache)
+	{
+		return NULL;
+	}
+
+	PtrCacheRecords = (CacheRecordStruct *)(PtrCache + DWARFCACHE_HEADERSIZE);
+
+	// the records are sorted by Die's offset
+	while (Low < High)
+	{
+		size_t Middle = (Low + High) / 2;
+
+		if (PtrCacheRecords[Middle].Offset < Offset)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	if ((Low < NbCacheRecords) && (PtrCacheRecords[Low].Offset == Offset) && (PtrCacheRecords[Low].Position <= SizeCache) && (PtrCacheRecords[Low].Size <= (SizeCache - PtrCacheRecords[Low].Position)))
+	{
+		return &PtrCacheRecords[Low];
+	}
+	else
+	{
+		return NULL;
+	}
+}
+
+
+// Add data to a cache buffer
+void DWARFManager_CachePut(CacheBufferStruct *PtrBuffer, const void *PtrData, size_t Size)
+{
+	if ((PtrBuffer->Size + Size) > PtrBuffer->SizeAlloc)
+	{
+		PtrBuffer->SizeAlloc = (PtrBuffer->Size + Size) * 2;
+		PtrBuffer->Ptr = (uint8_t *)realloc(PtrBuffer->Ptr, PtrBuffer->SizeAlloc);
+	}
+
+	memcpy(PtrBuffer->Ptr + PtrBuffer->Size, PtrData, Size);
+	PtrBuffer->Size += Size;
+}
+
+
+// Add a number to a cache buffer
+void DWARFManager_CachePutValue(CacheBufferStruct *PtrBuffer, size_t Value)
+{
+	uint8_t Byte;
+
+	do
+	{
+		Byte = (Value & 0x7f);
+		if ((Value >>= 7))
+		{
+			Byte |= 0x80;
+		}
+		DWARFManager_CachePut(PtrBuffer, &Byte, 1);
+	}
+	while ((Byte & 0x80));
+}
+
+
+// Add a string to a cache buffer
+void DWARFManager_CachePutString(CacheBufferStruct *PtrBuffer, char *PtrString)
+{
+	if (PtrString)
+	{
+		DWARFManager_CachePutValue(PtrBuffer, strlen(PtrString) + 1);
+		DWARFManager_CachePut(PtrBuffer, PtrString, strlen(PtrString));
+	}
+	else
+	{
+		DWARFManager_CachePutValue(PtrBuffer, 0);
+	}
+}
+
+
+// Add a variable to a cache buffer
+void DWARFManager_CachePutVariable(CacheBufferStruct *PtrBuffer, VariablesStruct *PtrVariable)
+{
+	DWARFManager_CachePutValue(PtrBuffer, PtrVariable->Op);
+	DWARFManager_CachePutValue(PtrBuffer, PtrVariable->Addr);
+	DWARFManager_CachePutValue(PtrBuffer, PtrVariable->TypeOffset);
+	DWARFManager_CachePutString(PtrBuffer, PtrVariable->PtrName);
+}
+
+
+// Get a number from the cache
+// The read is set in error if the number goes beyond the record
+size_t DWARFManager_CacheGetValue(CacheReadStruct *PtrRead)
+{
+	size_t Value = 0;
+	size_t Shift = 0;
+	uint8_t Byte;
+
+	do
+	{
+		if (PtrRead->Ptr >= PtrRead->PtrEnd)
+		{
+			PtrRead->Error = true;
+			return 0;
+		}
+
+		Byte = *PtrRead->Ptr++;
+		if (Shift < (8 * sizeof(Value)))
+		{
+			Value |= ((size_t)(Byte & 0x7f) << Shift);
+		}
+		Shift += 7;
+	}
+	while ((Byte & 0x80));
+
+	return Value;
+}
+
+
+// Get a number of items from the cache
+// Each item takes at least one byte, so the read is set in error if there are more items than remaining bytes
+size_t DWARFManager_CacheGetCount(CacheReadStruct *PtrRead)
+{
+	size_t Count = DWARFManager_CacheGetValue(PtrRead);
+
+	if (Count > (size_t)(PtrRead->PtrEnd - PtrRead->Ptr))
+	{
+		PtrRead->Error = true;
+		return 0;
+	}
+
+	return Count;
+}
+
+
+// Get a string from the cache
+// Return NULL for a NULL string, or if the read is in error
+char *DWARFManager_CacheGetString(CacheReadStruct *PtrRead)
+{
+	size_t Length = DWARFManager_CacheGetCount(PtrRead);
+	char *PtrString = NULL;
+
+	if (Length--)
+	{
+		if (Length <= (size_t)(PtrRead->PtrEnd - PtrRead->Ptr))
+		{
+			if ((PtrString = (char *)calloc(Length + 1, 1)))
+			{
+				memcpy(PtrString, PtrRead->Ptr, Length);
+			}
+			PtrRead->Ptr += Length;
+		}
+		else
+		{
+			PtrRead->Error = true;
+		}
+	}
+
+	return PtrString;
+}
+
+
+// Get a variable from the cache
+void DWARFManager_CacheGetVariable(CacheReadStruct *PtrRead, VariablesStruct *PtrVariable)
+{
+	PtrVariable->Op = DWARFManager_CacheGetValue(PtrRead);
+	PtrVariable->Addr = DWARFManager_CacheGetValue(PtrRead);
+	PtrVariable->TypeOffset = DWARFManager_CacheGetValue(PtrRead);
+	PtrVariable->PtrName = DWARFManager_CacheGetString(PtrRead);
+}
+
+
+// Serialize a CU decoded information in a cache buffer
+void DWARFManager_CacheSaveCU(CacheBufferStruct *PtrBuffer, size_t NumCU)
+{
+	// The used source lines are only read from a source file found; a found source file may have no used lines
+	DWARFManager_CachePutValue(PtrBuffer, (PtrCU[NumCU].PtrUsedLinesSrc || (PtrCU[NumCU].Status == DWARFSTATUS_OK)) ? 1 : 0);
+	DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].NbUsedLinesSrc);
+	for (size_t i = 0; i < PtrCU[NumCU].NbUsedLinesSrc; i++)
+	{
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrUsedLinesSrc[i].StartPC);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc);
+	}
+
+	// Global variables
+	DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].NbVariables);
+	for (size_t i = 0; i < PtrCU[NumCU].NbVariables; i++)
+	{
+		DWARFManager_CachePutVariable(PtrBuffer, PtrCU[NumCU].PtrVariables + i);
+	}
+
+	// Types, and their structure's members
+	DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].NbTypes);
+	for (size_t i = 0; i < PtrCU[NumCU].NbTypes; i++)
+	{
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].Tag);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].Offset);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].TypeOffset);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].ByteSize);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].Encoding);
+		DWARFManager_CachePutString(PtrBuffer, PtrCU[NumCU].PtrTypes[i].PtrName);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].NbStructureMembers);
+		for (size_t j = 0; j < PtrCU[NumCU].PtrTypes[i].NbStructureMembers; j++)
+		{
+			DWARFManager_CachePutString(PtrBuffer, PtrCU[NumCU].PtrTypes[i].PtrStructureMembers[j].PtrName);
+			DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].PtrStructureMembers[j].TypeOffset);
+			DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrTypes[i].PtrStructureMembers[j].DataMemberLocation);
+		}
+	}
+
+	// Sub programs, their source lines and their local variables
+	DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].NbFrames);
+	DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].NbSubProgs);
+	for (size_t i = 0; i < PtrCU[NumCU].NbSubProgs; i++)
+	{
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].Tag);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].NumLineSrc);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].StartPC);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].LowPC);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].HighPC);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].FrameBase);
+		DWARFManager_CachePutString(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].PtrSubprogramName);
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].NbLinesSrc);
+		for (size_t j = 0; j < PtrCU[NumCU].PtrSubProgs[i].NbLinesSrc; j++)
+		{
+			DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].PtrLinesSrc[j].Tag);
+			DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].PtrLinesSrc[j].StartPC);
+			DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].PtrLinesSrc[j].NumLineSrc);
+		}
+		DWARFManager_CachePutValue(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].NbVariables);
+		for (size_t j = 0; j < PtrCU[NumCU].PtrSubProgs[i].NbVariables; j++)
+		{
+			DWARFManager_CachePutVariable(PtrBuffer, PtrCU[NumCU].PtrSubProgs[i].PtrVariables + j);
+		}
+	}
+}
+
+
+// Load a CU decoded information from the cache
+// Return false if the CU has no usable record; the CU is then left as it was
+bool DWARFManager_CacheLoadCU(size_t NumCU)
+{
+	CacheRecordStruct *PtrRecord;
+	CacheReadStruct Read;
+	size_t Nb;
+
+	if (!(PtrRecord = DWARFManager_CacheGetRecord(PtrCU[NumCU].Offset)))
+	{
+		return false;
+	}
+
+	Read.Ptr = PtrCache + PtrRecord->Position;
+	Read.PtrEnd = Read.Ptr + PtrRecord->Size;
+	Read.Error = false;
+
+	// The record has been made with, or without, the source file; it has to be the same now
+	if (DWARFManager_CacheGetValue(&Read) != ((PtrCU[NumCU].Status == DWARFSTATUS_OK) ? 1 : 0))
+	{
+		return false;
+	}
+
+	// Used source lines
+	if ((Nb = DWARFManager_CacheGetCount(&Read)))
+	{
+		PtrCU[NumCU].PtrUsedLinesSrc = (CUStruct_LineSrc *)calloc(Nb, sizeof(CUStruct_LineSrc));
+		PtrCU[NumCU].PtrUsedLinesLoadSrc = (DWARFlinesrc *)calloc(Nb, sizeof(DWARFlinesrc));
+		PtrCU[NumCU].PtrUsedNumLines = (size_t *)calloc(Nb, sizeof(size_t));
+		PtrCU[NumCU].NbUsedLinesSrc = Nb;
+		for (size_t i = 0; i < Nb; i++)
+		{
+			PtrCU[NumCU].PtrUsedLinesSrc[i].StartPC = DWARFManager_CacheGetValue(&Read);
+			PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc = DWARFManager_CacheGetValue(&Read);
+		}
+	}
+
+	// Global variables
+	if ((Nb = DWARFManager_CacheGetCount(&Read)))
+	{
+		PtrCU[NumCU].PtrVariables = (VariablesStruct *)calloc(Nb, sizeof(VariablesStruct));
+		for (; PtrCU[NumCU].NbVariables < Nb; PtrCU[NumCU].NbVariables++)
+		{
+			DWARFManager_CacheGetVariable(&Read, PtrCU[NumCU].PtrVariables + PtrCU[NumCU].NbVariables);
+		}
+	}
+
+	// Types, and their structure's members
+	if ((Nb = DWARFManager_CacheGetCount(&Read)))
+	{
+		PtrCU[NumCU].PtrTypes = (BaseTypeStruct *)calloc(Nb, sizeof(BaseTypeStruct));
+		for (; PtrCU[NumCU].NbTypes < Nb; PtrCU[NumCU].NbTypes++)
+		{
+			BaseTypeStruct *PtrType = PtrCU[NumCU].PtrTypes + PtrCU[NumCU].NbTypes;
+			size_t NbMembers;
+
+			PtrType->Tag = DWARFManager_CacheGetValue(&Read);
+			PtrType->Offset = DWARFManager_CacheGetValue(&Read);
+			PtrType->TypeOffset = DWARFManager_CacheGetValue(&Read);
+			PtrType->ByteSize = DWARFManager_CacheGetValue(&Read);
+			PtrType->Encoding = DWARFManager_CacheGetValue(&Read);
+			PtrType->PtrName = DWARFManager_CacheGetString(&Read);
+			if ((NbMembers = DWARFManager_CacheGetCount(&Read)))
+			{
+				PtrType->PtrStructureMembers = (StructureMembersStruct *)calloc(NbMembers, sizeof(StructureMembersStruct));
+				for (; PtrType->NbStructureMembers < NbMembers; PtrType->NbStructureMembers++)
+				{
+					PtrType->PtrStructureMembers[PtrType->NbStructureMembers].PtrName = DWARFManager_CacheGetString(&Read);
+					PtrType->PtrStructureMembers[PtrType->NbStructureMembers].TypeOffset = DWARFManager_CacheGetValue(&Read);
+					PtrType->PtrStructureMembers[PtrType->NbStructureMembers].DataMemberLocation = DWARFManager_CacheGetValue(&Read);
+				}
+			}
+		}
+	}
+
+	// Sub programs, their source lines and their local variables
+	PtrCU[NumCU].NbFrames = DWARFManager_CacheGetValue(&Read);
+	if ((Nb = DWARFManager_CacheGetCount(&Read)))
+	{
+		PtrCU[NumCU].PtrSubProgs = (SubProgStruct *)calloc(Nb, sizeof(SubProgStruct));
+		for (; PtrCU[NumCU].NbSubProgs < Nb; PtrCU[NumCU].NbSubProgs++)
+		{
+			SubProgStruct *PtrSubProg = PtrCU[NumCU].PtrSubProgs + PtrCU[NumCU].NbSubProgs;
+			size_t NbItems;
+
+			PtrSubProg->Tag = DWARFManager_CacheGetValue(&Read);
+			PtrSubProg->NumLineSrc = DWARFManager_CacheGetValue(&Read);
+			PtrSubProg->StartPC = DWARFManager_CacheGetValue(&Read);
+			PtrSubProg->LowPC = DWARFManager_CacheGetValue(&Read);
+			PtrSubProg->HighPC = DWARFManager_CacheGetValue(&Read);
+			PtrSubProg->FrameBase = DWARFManager_CacheGetValue(&Read);
+			PtrSubProg->PtrSubprogramName = DWARFManager_CacheGetString(&Read);
+			if ((NbItems = DWARFManager_CacheGetCount(&Read)))
+			{
+				PtrSubProg->PtrLinesSrc = (DMIStruct_LineSrc *)calloc(NbItems, sizeof(DMIStruct_LineSrc));
+				for (; PtrSubProg->NbLinesSrc < NbItems; PtrSubProg->NbLinesSrc++)
+				{
+					PtrSubProg->PtrLinesSrc[PtrSubProg->NbLinesSrc].Tag = DWARFManager_CacheGetValue(&Read);
+					PtrSubProg->PtrLinesSrc[PtrSubProg->NbLinesSrc].StartPC = DWARFManager_CacheGetValue(&Read);
+					PtrSubProg->PtrLinesSrc[PtrSubProg->NbLinesSrc].NumLineSrc = DWARFManager_CacheGetValue(&Read);
+				}
+			}
+			if ((NbItems = DWARFManager_CacheGetCount(&Read)))
+			{
+				PtrSubProg->PtrVariables = (VariablesStruct *)calloc(NbItems, sizeof(VariablesStruct));
+				for (; PtrSubProg->NbVariables < NbItems; PtrSubProg->NbVariables++)
+				{
+					DWARFManager_CacheGetVariable(&Read, PtrSubProg->PtrVariables + PtrSubProg->NbVariables);
+				}
+			}
+		}
+	}
+
+	// A damaged record is dropped, and the CU will be decoded from the DWARF
+	if (Read.Error)
+	{
+		DWARFManager_CloseCUInfos(NumCU);
+		return false;
+	}
+
+	return true;
+}
+
+
+// Address index comparisons
+static int DWARFManager_CompareAdr(const void *PtrA, const void *PtrB)
+{
+	size_t A = *(const size_t *)PtrA, B = *(const size_t *)PtrB;
+	return (A < B) ? -1 : (A > B);
+}
+
+
+static int DWARFManager_CompareAdrIndexEntry(const void *PtrA, const void *PtrB)
+{
+	const AdrIndexEntryStruct *A = (const AdrIndexEntryStruct *)PtrA, *B = (const AdrIndexEntryStruct *)PtrB;
+
+	if (A->StartPC != B->StartPC)
+	{
+		return (A->StartPC < B->StartPC) ? -1 : 1;
+	}
+	else
+	{
+		if (A->CU != B->CU)
+		{
+			return (A->CU < B->CU) ? -1 : 1;
+		}
+		else
+		{
+			return (A->Index < B->Index) ? -1 : (A->Index > B->Index);
+		}
+	}
+}
+
+
+// Position of an address in the sorted boundaries
+static size_t DWARFManager_GetAdrBoundary(size_t *PtrBoundaries, size_t NbBoundaries, size_t Adr)
+{
+	size_t Low = 0, High = NbBoundaries;
+
+	while (Low < High)
+	{
+		size_t Mid = (Low + High) / 2;
+
+		if (PtrBoundaries[Mid] < Adr)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	return Low;
+}
+
+
+// Dwarf manager address index initialisations
+// The CU and sub programs address ranges are cut into segments, which are not overlapping, and each segment keeps the list of the CU / sub programs covering it, in the CU / sub programs order
+// An address look up is then a binary search, giving the same result as scanning the CU and sub programs in order
+void DWARFManager_InitAdrIndex(void)
+{
+	size_t NbRanges = 0, NbBoundaries = 0, NbUniqueBoundaries = 0, NbItems = 0;
+	AdrIndexRangeStruct *PtrRanges;
+	size_t *PtrBoundaries;
+
+	// count the ranges, the sub programs and the used source lines
+	NbAdrIndexSubProgs = NbAdrIndexUsedLines = 0;
+	for (size_t i = 0; i < NbCU; i++)
+	{
+		if (PtrCU[i].LowPC < PtrCU[i].HighPC)
+		{
+			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
+			{
+				if ((PtrCU[i].PtrSubProgs[j].LowPC < PtrCU[i].HighPC) && (PtrCU[i].PtrSubProgs[j].HighPC > PtrCU[i].LowPC) && (PtrCU[i].PtrSubProgs[j].LowPC < PtrCU[i].PtrSubProgs[j].HighPC))
+				{
+					NbRanges++;
+				}
+			}
+
+			NbRanges++;
+		}
+
+		NbAdrIndexSubProgs += PtrCU[i].NbSubProgs;
+		NbAdrIndexUsedLines += PtrCU[i].NbUsedLinesSrc;
+	}
+
+	// ranges, in the CU / sub programs order, the CU itself coming after its sub programs
+	PtrRanges = (AdrIndexRangeStruct *)calloc(NbRanges + 1, sizeof(AdrIndexRangeStruct));
+	PtrBoundaries = (size_t *)calloc((NbRanges * 2) + 1, sizeof(size_t));
+	NbRanges = 0;
+	for (size_t i = 0; i < NbCU; i++)
+	{
+		if (PtrCU[i].LowPC < PtrCU[i].HighPC)
+		{
+			for (size_t j = 0; j <= PtrCU[i].NbSubProgs; j++)
+			{
+				size_t LowPC = PtrCU[i].LowPC, HighPC = PtrCU[i].HighPC;
+
+				if (j < PtrCU[i].NbSubProgs)
+				{
+					LowPC = (PtrCU[i].PtrSubProgs[j].LowPC > LowPC) ? PtrCU[i].PtrSubProgs[j].LowPC : LowPC;
+					HighPC = (PtrCU[i].PtrSubProgs[j].HighPC < HighPC) ? PtrCU[i].PtrSubProgs[j].HighPC : HighPC;
+				}
+
+				if (LowPC < HighPC)
+				{
+					PtrRanges[NbRanges].StartPC = PtrBoundaries[NbBoundaries++] = LowPC;
+					PtrRanges[NbRanges].EndPC = PtrBoundaries[NbBoundaries++] = HighPC;
+					PtrRanges[NbRanges].Item.CU = i;
+					PtrRanges[NbRanges++].Item.SubProg = j;
+				}
+			}
+		}
+	}
+
+	// segments between the sorted boundaries
+	qsort(PtrBoundaries, NbBoundaries, sizeof(size_t), DWARFManager_CompareAdr);
+	for (size_t i = 0; i < NbBoundaries; i++)
+	{
+		if (!NbUniqueBoundaries || (PtrBoundaries[i] != PtrBoundaries[NbUniqueBoundaries - 1]))
+		{
+			PtrBoundaries[NbUniqueBoundaries++] = PtrBoundaries[i];
+		}
+	}
+	NbAdrIndexSegments = NbUniqueBoundaries ? (NbUniqueBoundaries - 1) : 0;
+	PtrAdrIndexSegments = (AdrIndexSegmentStruct *)calloc(NbAdrIndexSegments + 1, sizeof(AdrIndexSegmentStruct));
+	for (size_t i = 0; i < NbAdrIndexSegments; i++)
+	{
+		PtrAdrIndexSegments[i].StartPC = PtrBoundaries[i];
+		PtrAdrIndexSegments[i].EndPC = PtrBoundaries[i + 1];
+	}
+
+	// count, then fill, the items covering each segment; the ranges being in order, so are the items
+	for (size_t i = 0; i < NbRanges; i++)
+	{
+		size_t First = DWARFManager_GetAdrBoundary(PtrBoundaries, NbAdrIndexSegments + 1, PtrRanges[i].StartPC);
+		size_t Last = DWARFManager_GetAdrBoundary(PtrBoundaries, NbAdrIndexSegments + 1, PtrRanges[i].EndPC);
+
+		while (First < Last)
+		{
+			PtrAdrIndexSegments[First++].NbItems++;
+		}
+	}
+	for (size_t i = 0; i < NbAdrIndexSegments; i++)
+	{
+		PtrAdrIndexSegments[i].FirstItem = NbItems;
+		NbItems += PtrAdrIndexSegments[i].NbItems;
+		PtrAdrIndexSegments[i].NbItems = 0;
+	}
+	PtrAdrIndexItems = (AdrIndexItemStruct *)calloc(NbItems + 1, sizeof(AdrIndexItemStruct));
+	for (size_t i = 0; i < NbRanges; i++)
+	{
+		size_t First = DWARFManager_GetAdrBoundary(PtrBoundaries, NbAdrIndexSegments + 1, PtrRanges[i].StartPC);
+		size_t Last = DWARFManager_GetAdrBoundary(PtrBoundaries, NbAdrIndexSegments + 1, PtrRanges[i].EndPC);
+
+		while (First < Last)
+		{
+			PtrAdrIndexItems[PtrAdrIndexSegments[First].FirstItem + PtrAdrIndexSegments[First].NbItems++] = PtrRanges[i].Item;
+			First++;
+		}
+	}
+	free(PtrBoundaries);
+	free(PtrRanges);
+
+	// sub programs starts, for the ones in their CU range, and the used source lines
+	PtrAdrIndexSubProgs = (AdrIndexEntryStruct *)calloc(NbAdrIndexSubProgs + 1, sizeof(AdrIndexEntryStruct));
+	PtrAdrIndexUsedLines = (AdrIndexEntryStruct *)calloc(NbAdrIndexUsedLines + 1, sizeof(AdrIndexEntryStruct));
+	NbAdrIndexSubProgs = NbAdrIndexUsedLines = 0;
+	for (size_t i = 0; i < NbCU; i++)
+	{
+		for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
+		{
+			SubProgStruct *PtrSubProg = &PtrCU[i].PtrSubProgs[j];
+
+			if ((PtrSubProg->StartPC >= PtrCU[i].LowPC) && (PtrSubProg->StartPC < PtrCU[i].HighPC))
+			{
+				PtrAdrIndexSubProgs[NbAdrIndexSubProgs].StartPC = PtrSubProg->StartPC;
+				PtrAdrIndexSubProgs[NbAdrIndexSubProgs].CU = i;
+				PtrAdrIndexSubProgs[NbAdrIndexSubProgs++].Index = j;
+			}
+
+			PtrSubProg->LinesSrcSorted = true;
+			for (size_t k = 1; k < PtrSubProg->NbLinesSrc; k++)
+			{
+				if (PtrSubProg->PtrLinesSrc[k].StartPC < PtrSubProg->PtrLinesSrc[k - 1].StartPC)
+				{
+					PtrSubProg->LinesSrcSorted = false;
+					break;
+				}
+			}
+		}
+
+		for (size_t j = 0; j < PtrCU[i].NbUsedLinesSrc; j++)
+		{
+			PtrAdrIndexUsedLines[NbAdrIndexUsedLines].StartPC = PtrCU[i].PtrUsedLinesSrc[j].StartPC;
+			PtrAdrIndexUsedLines[NbAdrIndexUsedLines].CU = i;
+			PtrAdrIndexUsedLines[NbAdrIndexUsedLines++].Index = j;
+		}
+	}
+	qsort(PtrAdrIndexSubProgs, NbAdrIndexSubProgs, sizeof(AdrIndexEntryStruct), DWARFManager_CompareAdrIndexEntry);
+	qsort(PtrAdrIndexUsedLines, NbAdrIndexUsedLines, sizeof(AdrIndexEntryStruct), DWARFManager_CompareAdrIndexEntry);
+}
+
+
+// Dwarf manager address index close
+void DWARFManager_CloseAdrIndex(void)
+{
+	free(PtrAdrIndexSegments);
+	free(PtrAdrIndexItems);
+	free(PtrAdrIndexSubProgs);
+	free(PtrAdrIndexUsedLines);
+	PtrAdrIndexSegments = NULL;
+	PtrAdrIndexItems = NULL;
+	PtrAdrIndexSubProgs = PtrAdrIndexUsedLines = NULL;
+	NbAdrIndexSegments = NbAdrIndexSubProgs = NbAdrIndexUsedLines = 0;
+}
+
+
+// Find the address index segment including the address
+// Return NULL if no CU includes the address
+AdrIndexSegmentStruct *DWARFManager_FindAdrIndexSegment(size_t Adr)
+{
+	size_t Low = 0, High = NbAdrIndexSegments;
+
+	// look for the last segment starting at, or before, the address
+	while (Low < High)
+	{
+		size_t Mid = (Low + High) / 2;
+
+		if (PtrAdrIndexSegments[Mid].StartPC <= Adr)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	if (Low && (Adr < PtrAdrIndexSegments[Low - 1].EndPC) && PtrAdrIndexSegments[Low - 1].NbItems)
+	{
+		return &PtrAdrIndexSegments[Low - 1];
+	}
+	else
+	{
+		return NULL;
+	}
+}
+
+
+// Load all the CU not loaded yet, and rebuild the address index if needed
+void DWARFManager_LoadAllCU(void)
+{
+	bool Loaded = false;
+
+	for (size_t i = 0; i < NbCU; i++)
+	{
+		Loaded |= DWARFManager_LoadCU(i);
+	}
+
+	if (Loaded)
+	{
+		DWARFManager_CloseAdrIndex();
+		DWARFManager_InitAdrIndex();
+	}
+}
+
+
+// Get the address index segment including the address, once the CU including the address have been loaded
+// The address index is rebuilt if a CU has been loaded, to get its sub programs and used source lines
+// Return NULL if no CU includes the address
+AdrIndexSegmentStruct *DWARFManager_GetAdrIndexSegment(size_t Adr)
+{
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_FindAdrIndexSegment(Adr);
+	bool Loaded = false;
+
+	if (PtrSegment)
+	{
+		for (size_t i = 0; i < PtrSegment->NbItems; i++)
+		{
+			Loaded |= DWARFManager_LoadCU(PtrAdrIndexItems[PtrSegment->FirstItem + i].CU);
+		}
+
+		if (Loaded)
+		{
+			DWARFManager_CloseAdrIndex();
+			DWARFManager_InitAdrIndex();
+			PtrSegment = DWARFManager_FindAdrIndexSegment(Adr);
+		}
+	}
+
+	return PtrSegment;
+}
+
+
+// Get the first index entry at the address for the CU
+// Return NULL if there is none
+AdrIndexEntryStruct *DWARFManager_GetAdrIndexEntry(AdrIndexEntryStruct *PtrEntries, size_t NbEntries, size_t Adr, size_t CU)
+{
+	size_t Low = 0, High = NbEntries;
+
+	while (Low < High)
+	{
+		size_t Mid = (Low + High) / 2;
+
+		if ((PtrEntries[Mid].StartPC < Adr) || ((PtrEntries[Mid].StartPC == Adr) && (PtrEntries[Mid].CU < CU)))
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	if ((Low < NbEntries) && (PtrEntries[Low].StartPC == Adr) && (PtrEntries[Low].CU == CU))
+	{
+		return &PtrEntries[Low];
+	}
+	else
+	{
+		return NULL;
+	}
+}
+
+
+// Get the first sub program, within its CU range, including the address
+// Return NULL if no sub program has been found
+SubProgStruct *DWARFManager_GetSubProgFromAdr(size_t Adr)
+{
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
+
+	if (PtrSegment)
+	{
+		for (size_t i = 0; i < PtrSegment->NbItems; i++)
+		{
+			AdrIndexItemStruct *PtrItem = &PtrAdrIndexItems[PtrSegment->FirstItem + i];
+
+			if (PtrItem->SubProg < PtrCU[PtrItem->CU].NbSubProgs)
+			{
+				return &PtrCU[PtrItem->CU].PtrSubProgs[PtrItem->SubProg];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+
+// Get the sub program's source line for the address and a tag, as found by scanning the lines in order
+// The scan stops on the line at the address (with the tag, if not 0), or on the line before the first one above the address
+// Return NULL if the scan doesn't stop
+DMIStruct_LineSrc *DWARFManager_GetSubProgLineSrc(SubProgStruct *PtrSubProg, size_t Adr, size_t Tag)
+{
+	size_t k = 0;
+
+	// sorted lines below the address can't stop the scan, so it can start at the first line at the address
+	if (PtrSubProg->LinesSrcSorted)
+	{
+		size_t High = PtrSubProg->NbLinesSrc;
+
+		while (k < High)
+		{
+			size_t Mid = (k + High) / 2;
+
+			if (PtrSubProg->PtrLinesSrc[Mid].StartPC < Adr)
+			{
+				k = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+	}
+
+	for (; k < PtrSubProg->NbLinesSrc; k++)
+	{
+		if (PtrSubProg->PtrLinesSrc[k].StartPC <= Adr)
+		{
+			if ((PtrSubProg->PtrLinesSrc[k].StartPC == Adr) && (!Tag || (PtrSubProg->PtrLinesSrc[k].Tag == Tag)))
+			{
+				return &PtrSubProg->PtrLinesSrc[k];
+			}
+		}
+		else
+		{
+			return k ? &PtrSubProg->PtrLinesSrc[k - 1] : NULL;
+		}
+	}
+
+	return NULL;
+}
+
+
+// Dwarf manager Compilation Units initialisations
+void DWARFManager_InitDMI(void)
+{
+	Dwarf_Unsigned	next_cu_header, return_uvalue;
+	Dwarf_Error	error;
+	Dwarf_Attribute	*atlist;
+	Dwarf_Half return_tagval, return_attr;
+	Dwarf_Half version, offset_size;
+	Dwarf_Addr return_lowpc, return_highpc;
+	Dwarf_Signed atcnt;
+	Dwarf_Die return_sib;
+	Dwarf_Off return_offset;
+	FILE *SrcFile;
+	char *return_string;
+	char *Ptr, *Ptr1;
+
+	// Initialisation for the Compilation Units table
+	NbCU = 0;
+	PtrCU = NULL;
+
+	// loop on the available Compilation Unit
+	while (dwarf_next_cu_header_b(dbg, NULL, &version, NULL, NULL, &offset_size, NULL, &next_cu_header, &error) == DW_DLV_OK)
+	{
+		// Allocation of an additional Compilation Unit structure in the table
+		if (Ptr = (char *)realloc(PtrCU, ((NbCU + 1) * sizeof(CUStruct))))
+		{
+			// Compilation Unit RAZ
+			PtrCU = (CUStruct *)Ptr;
+			memset(PtrCU + NbCU, 0, sizeof(CUStruct));
+			PtrCU[NbCU].Loaded = true;
+
+			// Debug specific CU
+#ifdef DEBUG_NumCU
+			if (NbCU == DEBUG_NumCU)
+#endif
+			{
+				// Get 1st Die from the Compilation Unit
+				if (dwarf_siblingof(dbg, NULL, &return_sib, &error) == DW_DLV_OK)
+				{
+					// Get Die's Tag
+					if ((dwarf_tag(return_sib, &return_tagval, &error) == DW_DLV_OK))
+					{
+						PtrCU[NbCU].Tag = return_tagval;
+
+						// Die type detection
+						switch (return_tagval)
+						{
+						case DW_TAG_compile_unit:
+							if (dwarf_attrlist(return_sib, &atlist, &atcnt, &error) == DW_DLV_OK)
+							{
+								for (Dwarf_Signed i = 0; i < atcnt; ++i)
+								{
+									if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+									{
+										switch (return_attr)
+										{
+											// Start address
+										case DW_AT_low_pc:
+											if (dwarf_lowpc(return_sib, &return_lowpc, &error) == DW_DLV_OK)
+											{
+												PtrCU[NbCU].LowPC = return_lowpc;
+											}
+											break;
+
+											// End address
+										case DW_AT_high_pc:
+											if (dwarf_highpc(return_sib, &return_highpc, &error) == DW_DLV_OK)
+											{
+												PtrCU[NbCU].HighPC = return_highpc;
+											}
+											break;
+
+											// compilation information
+										case DW_AT_producer:
+											if (dwarf_formstring(atlist[i], &return_string, &error) == DW_DLV_OK)
+											{
+												PtrCU[NbCU].PtrProducer = (char *)calloc(strlen(return_string) + 1, 1);
+												strcpy(PtrCU[NbCU].PtrProducer, return_string);
+												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
+											}
+											break;
+
+											// Filename
+										case DW_AT_name:
+											if (dwarf_formstring(atlist[i], &return_string, &error) == DW_DLV_OK)
+											{
+#ifdef DEBUG_Filename
+												if (strstr(return_string, DEBUG_Filename))
+#endif
+												{
+													PtrCU[NbCU].PtrSourceFilename = (char *)calloc((strlen(return_string) + 1), 1);
+													strcpy(PtrCU[NbCU].PtrSourceFilename, return_string);
+												}
+												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
+											}
+											break;
+
+											// Directory name
+										case DW_AT_comp_dir:
+											if (dwarf_formstring(atlist[i], &return_string, &error) == DW_DLV_OK)
+											{
+												PtrCU[NbCU].PtrSourceFileDirectory = (char *)calloc((strlen(return_string) + 1), 1);
+												strcpy(PtrCU[NbCU].PtrSourceFileDirectory, return_string);
+												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
+											}
+											break;
+
+											// Language
+										case DW_AT_language:
+											if (dwarf_formudata(atlist[i], &return_uvalue, &error) == DW_DLV_OK)
+											{
+												PtrCU[NbCU].Language = return_uvalue;
+											}
+											break;
+
+										default:
+											break;
+										}
+									}
+									dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+								}
+								dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+							}
+
+							// Check filename presence
+							if (!PtrCU[NbCU].PtrSourceFilename)
+							{
+								PtrCU[NbCU].PtrSourceFilename = (char *)calloc(1, 1);
+							}
+
+							// Check directory presence
+							if (!PtrCU[NbCU].PtrSourceFileDirectory)
+							{
+								// Check if file exists in the search paths
+								for (size_t i = 0; i < NbSearchPaths; i++)
+								{
+									PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + strlen((const char *)ListSearchPaths[i]) + 2);
+#if defined(_WIN32)
+									sprintf(PtrCU[NbCU].PtrFullFilename, "%s\\%s", ListSearchPaths[i], PtrCU[NbCU].PtrSourceFilename);
+									if (!fopen_s(&SrcFile, PtrCU[NbCU].PtrFullFilename, "rb"))
+#else
+									sprintf(PtrCU[NbCU].PtrFullFilename, "%s/%s", ListSearchPaths[i], PtrCU[NbCU].PtrSourceFilename);
+									SrcFile = fopen(PtrCU[NbCU].PtrFullFilename, "rb");
+									if (SrcFile == NULL)
+#endif
+									{
+										PtrCU[NbCU].PtrSourceFileDirectory = (char *)realloc(PtrCU[NbCU].PtrSourceFileDirectory, strlen(ListSearchPaths[i]) + 1);
+										strcpy(PtrCU[NbCU].PtrSourceFileDirectory, ListSearchPaths[i]);
+									}
+								}
+
+								// File directory doesn't exits
+								if (!PtrCU[NbCU].PtrSourceFileDirectory)
+								{
+									PtrCU[NbCU].PtrSourceFileDirectory = (char *)realloc(PtrCU[NbCU].PtrSourceFileDirectory, 2);
+									strcpy(PtrCU[NbCU].PtrSourceFileDirectory, ".");
+								}
+							}
+
+							// Conform slashes / backslashes for the filename
+							DWARFManager_ConformSlachesBackslashes(PtrCU[NbCU].PtrSourceFilename);
+
+							// Check if filename contains already the complete directory
+							if (PtrCU[NbCU].PtrSourceFilename[1] == ':')
+							{
+								// Copy the filename as the full filename
+								PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + 1);
+								strcpy(PtrCU[NbCU].PtrFullFilename, PtrCU[NbCU].PtrSourceFilename);
+							}
+							else
+							{
+								// Create full filename and Conform slashes / backslashes
+								PtrCU[NbCU].PtrFullFilename = (char *)realloc(PtrCU[NbCU].PtrFullFilename, strlen(PtrCU[NbCU].PtrSourceFilename) + strlen(PtrCU[NbCU].PtrSourceFileDirectory) + 2);
+#if defined(_WIN32)
+								sprintf(PtrCU[NbCU].PtrFullFilename, "%s\\%s", PtrCU[NbCU].PtrSourceFileDirectory, PtrCU[NbCU].PtrSourceFilename);
+#else
+								sprintf(PtrCU[NbCU].PtrFullFilename, "%s/%s", PtrCU[NbCU].PtrSourceFileDirectory, PtrCU[NbCU].PtrSourceFilename);
+#endif
+							}
+
+							DWARFManager_ConformSlachesBackslashes(PtrCU[NbCU].PtrFullFilename);
+
+							// Directory path clean-up
+#if defined(_WIN32)
 							while ((Ptr1 = Ptr = strstr(PtrCU[NbCU].PtrFullFilename, "\\..\\")))
 #else
 							while ((Ptr1 = Ptr = strstr(PtrCU[NbCU].PtrFullFilename, "/../")))
@@ -575,84 +1630,7 @@ void DWARFManager_InitDMI(void)
 							if (!stat(PtrCU[NbCU].PtrFullFilename, &PtrCU[NbCU]._statbuf))
 							{
 								// check the time stamp with the executable
-								if (PtrCU[NbCU]._statbuf.st_mtime <= FileElfExeInfo.st_mtime)
-								{
-									// Open the source file as a binary file
-#if defined(_WIN32)
-									if (!fopen_s(&SrcFile, PtrCU[NbCU].PtrFullFilename, "rb"))
-#else
-                                    SrcFile = fopen(PtrCU[NbCU].PtrFullFilename, "rb");
-									if (SrcFile == NULL)
-#endif
-									{
-										if (!fseek(SrcFile, 0, SEEK_END))
-										{
-											if ((PtrCU[NbCU].SizeLoadSrc = ftell(SrcFile)) > 0)
-											{
-												if (!fseek(SrcFile, 0, SEEK_SET))
-												{
-													if (PtrCU[NbCU].PtrLoadSrc = Ptr = Ptr1 = (char *)calloc(1, (PtrCU[NbCU].SizeLoadSrc + 2)))
-													{
-														// Read whole file
-#if defined(_WIN32)	&& defined(_MSC_VER)													
-														if (fread_s(PtrCU[NbCU].PtrLoadSrc, PtrCU[NbCU].SizeLoadSrc, PtrCU[NbCU].SizeLoadSrc, 1, SrcFile) != 1)
-#else
-														if (fread(PtrCU[NbCU].PtrLoadSrc, PtrCU[NbCU].SizeLoadSrc, 1, SrcFile) != 1)
-#endif
-														{
-															free(PtrCU[NbCU].PtrLoadSrc);
-															PtrCU[NbCU].PtrLoadSrc = NULL;
-															PtrCU[NbCU].SizeLoadSrc = 0;
-														}
-														else
-														{
-															// Eliminate all carriage return code '\r' (oxd)
-															do
-															{
-																if ((*Ptr = *Ptr1) != '\r')
-																{
-																	Ptr++;
-																}
-															} while (*Ptr1++);
-
-															// Get back the new text file size
-															PtrCU[NbCU].SizeLoadSrc = strlen(Ptr = PtrCU[NbCU].PtrLoadSrc);
-
-															// Make sure the text file finish with a new line code '\n' (0xa)
-															if (PtrCU[NbCU].PtrLoadSrc[PtrCU[NbCU].SizeLoadSrc - 1] != '\n')
-															{
-																PtrCU[NbCU].PtrLoadSrc[PtrCU[NbCU].SizeLoadSrc++] = '\n';
-																PtrCU[NbCU].PtrLoadSrc[PtrCU[NbCU].SizeLoadSrc] = 0;
-															}
-
-															// Reallocate text file
-															if (PtrCU[NbCU].PtrLoadSrc = Ptr = (char *)realloc(PtrCU[NbCU].PtrLoadSrc, (PtrCU[NbCU].SizeLoadSrc + 1)))
-															{
-																// Count line numbers, based on the new line code '\n' (0xa), and finish each line with 0
-																do
-																{
-																	if (*Ptr == '\n')
-																	{
-																		PtrCU[NbCU].NbLinesLoadSrc++;
-																		*Ptr = 0;
-																	}
-																} while (*++Ptr);
-															}
-														}
-													}
-												}
-											}
-										}
-
-										fclose(SrcFile);
-									}
-									else
-									{
-										// Source file doesn't exist
-										PtrCU[NbCU].Status = DWARFSTATUS_NOFILE;
-									}
-								}
-								else
+								if (PtrCU[NbCU]._statbuf.st_mtime > FileElfExeInfo.st_mtime)
 								{
 									// Source file is outdated
 									PtrCU[NbCU].Status = DWARFSTATUS_OUTDATEDFILE;
@@ -670,709 +1648,800 @@ void DWARFManager_InitDMI(void)
 						}
 					}
 
-					// Get the source lines table located in the CU
-					if ((dwarf_srclines(return_sib, &linebuf, &cnt, &error) == DW_DLV_OK) && (PtrCU[NbCU].Status == DWARFSTATUS_OK))
+					// Keep the Die's offset, the CU will be loaded at its first look up
+					if (dwarf_dieoffset(return_sib, &return_offset, &error) == DW_DLV_OK)
 					{
-						if (cnt)
-						{
-							PtrCU[NbCU].NbUsedLinesSrc = cnt;
-							PtrCU[NbCU].PtrUsedLinesSrc = (CUStruct_LineSrc *)calloc(cnt, sizeof(CUStruct_LineSrc));
-							PtrCU[NbCU].PtrUsedLinesLoadSrc = (char **)calloc(cnt, sizeof(char *));
-							PtrCU[NbCU].PtrUsedNumLines = (size_t *)calloc(cnt, sizeof(size_t));
+						PtrCU[NbCU].Offset = return_offset;
+						PtrCU[NbCU].Loaded = false;
+					}
+				}
+			}
 
-							// Get the addresses and their source line numbers
-							for (Dwarf_Signed i = 0; i < cnt; i++)
-							{
-								if (dwarf_lineaddr(linebuf[i], &return_lineaddr, &error) == DW_DLV_OK)
-								{
-									// Get the source line number
-									if (dwarf_lineno(linebuf[i], &return_uvalue, &error) == DW_DLV_OK)
-									{
-										PtrCU[NbCU].PtrUsedLinesSrc[i].StartPC = return_lineaddr;
-										PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc = return_uvalue;
-									}
-								}
-							}
-						}
+			++NbCU;
+		}
+	}
+
+	// The CU without memory range take it from their used source lines, so they have to be loaded now
+	for (size_t i = 0; i < NbCU; i++)
+	{
+		if (!PtrCU[i].LowPC && (!PtrCU[i].HighPC || (PtrCU[i].HighPC == ~0)))
+		{
+			DWARFManager_LoadCU(i);
+		}
+	}
+}
+
+
+// Dwarf manager Compilation Unit load, done at the first look up landing in the CU
+// Get the source lines table, the variables, the types and the sub programs; the source code is loaded at the first look up of its text
+// Return true if the CU has been loaded, false if it was already loaded
+bool DWARFManager_LoadCU(size_t NumCU)
+{
+	Dwarf_Unsigned	return_uvalue;
+	Dwarf_Error	error;
+	Dwarf_Attribute	*atlist;
+	Dwarf_Attribute	return_attr1;
+	Dwarf_Half return_tagval, return_attr;
+	Dwarf_Addr return_lowpc = 0, return_highpc = 0, return_lineaddr;
+	Dwarf_Block *return_block;
+	Dwarf_Signed atcnt, cnt = 0, return_value;
+	Dwarf_Die return_sib, return_die, return_sub, return_subdie;
+	Dwarf_Off return_offset;
+	Dwarf_Line *linebuf;
+	Dwarf_Half form;
+	char *return_string;
+
+	if (PtrCU[NumCU].Loaded)
+	{
+		return false;
+	}
+
+	PtrCU[NumCU].Loaded = true;
+
+	// Get the CU's information from the cache, or else get back the CU's Die
+	if (!DWARFManager_CacheLoadCU(NumCU) && (dwarf_offdie(dbg, PtrCU[NumCU].Offset, &return_sib, &error) == DW_DLV_OK))
+	{
+		CacheDirty = true;
 
-						// Release the memory used by the source lines table located in the CU
-						dwarf_srclines_dealloc(dbg, linebuf, cnt);
+		// Get the source lines table located in the CU
+		if ((dwarf_srclines(return_sib, &linebuf, &cnt, &error) == DW_DLV_OK) && (PtrCU[NumCU].Status == DWARFSTATUS_OK))
+		{
+			if (cnt)
+			{
+				PtrCU[NumCU].NbUsedLinesSrc = cnt;
+				PtrCU[NumCU].PtrUsedLinesSrc = (CUStruct_LineSrc *)calloc(cnt, sizeof(CUStruct_LineSrc));
+				PtrCU[NumCU].PtrUsedLinesLoadSrc = (DWARFlinesrc *)calloc(cnt, sizeof(DWARFlinesrc));
+				PtrCU[NumCU].PtrUsedNumLines = (size_t *)calloc(cnt, sizeof(size_t));
+
+				// Get the addresses and their source line numbers
+				for (Dwarf_Signed i = 0; i < cnt; i++)
+				{
+					if (dwarf_lineaddr(linebuf[i], &return_lineaddr, &error) == DW_DLV_OK)
+					{
+						// Get the source line number
+						if (dwarf_lineno(linebuf[i], &return_uvalue, &error) == DW_DLV_OK)
+						{
+							PtrCU[NumCU].PtrUsedLinesSrc[i].StartPC = return_lineaddr;
+							PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc = return_uvalue;
+						}
 					}
+				}
+			}
+
+			// Release the memory used by the source lines table located in the CU
+			dwarf_srclines_dealloc(dbg, linebuf, cnt);
+		}
 
-					// Check if the CU has child
-					if (dwarf_child(return_sib, &return_die, &error) == DW_DLV_OK)
+		// Check if the CU has child
+		if (dwarf_child(return_sib, &return_die, &error) == DW_DLV_OK)
+		{
+			do
+			{
+				return_sib = return_die;
+				if ((dwarf_tag(return_die, &return_tagval, &error) == DW_DLV_OK))
+				{
+					switch (return_tagval)
 					{
-						do
+					case DW_TAG_lexical_block:
+						break;
+
+					case DW_TAG_variable:
+						if (dwarf_attrlist(return_die, &atlist, &atcnt, &error) == DW_DLV_OK)
 						{
-							return_sib = return_die;
-							if ((dwarf_tag(return_die, &return_tagval, &error) == DW_DLV_OK))
+							PtrCU[NumCU].PtrVariables = (VariablesStruct *)realloc(PtrCU[NumCU].PtrVariables, ((PtrCU[NumCU].NbVariables + 1) * sizeof(VariablesStruct)));
+							memset(PtrCU[NumCU].PtrVariables + PtrCU[NumCU].NbVariables, 0, sizeof(VariablesStruct));
+
+							for (Dwarf_Signed i = 0; i < atcnt; ++i)
 							{
-								switch (return_tagval)
+								if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
 								{
-								case DW_TAG_lexical_block:
-									break;
-
-								case DW_TAG_variable:
-									if (dwarf_attrlist(return_die, &atlist, &atcnt, &error) == DW_DLV_OK)
+									if (dwarf_attr(return_die, return_attr, &return_attr1, &error) == DW_DLV_OK)
 									{
-										PtrCU[NbCU].PtrVariables = (VariablesStruct *)realloc(PtrCU[NbCU].PtrVariables, ((PtrCU[NbCU].NbVariables + 1) * sizeof(VariablesStruct)));
-										memset(PtrCU[NbCU].PtrVariables + PtrCU[NbCU].NbVariables, 0, sizeof(VariablesStruct));
-
-										for (Dwarf_Signed i = 0; i < atcnt; ++i)
+										switch (return_attr)
 										{
-											if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+										case DW_AT_location:
+											if (dwarf_formblock(return_attr1, &return_block, &error) == DW_DLV_OK)
 											{
-												if (dwarf_attr(return_die, return_attr, &return_attr1, &error) == DW_DLV_OK)
-												{
-													switch (return_attr)
-													{
-													case DW_AT_location:
-														if (dwarf_formblock(return_attr1, &return_block, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].Op = (*((unsigned char *)(return_block->bl_data)));
+												PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].Op = (*((unsigned char *)(return_block->bl_data)));
 
-															switch (return_block->bl_len)
-															{
-															case 5:
-																PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].Addr = (*((unsigned char *)(return_block->bl_data) + 1) << 24) + (*((unsigned char *)(return_block->bl_data) + 2) << 16) + (*((unsigned char *)(return_block->bl_data) + 3) << 8) + (*((unsigned char *)(return_block->bl_data) + 4));
-																break;
+												switch (return_block->bl_len)
+												{
+												case 5:
+													PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].Addr = (*((unsigned char *)(return_block->bl_data) + 1) << 24) + (*((unsigned char *)(return_block->bl_data) + 2) << 16) + (*((unsigned char *)(return_block->bl_data) + 3) << 8) + (*((unsigned char *)(return_block->bl_data) + 4));
+													break;
 
-															default:
-																break;
-															}
-															dwarf_dealloc(dbg, return_block, DW_DLA_BLOCK);
-														}
-														break;
+												default:
+													break;
+												}
+												dwarf_dealloc(dbg, return_block, DW_DLA_BLOCK);
+											}
+											break;
 
-													case DW_AT_type:
-														if (dwarf_global_formref(return_attr1, &return_offset, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].TypeOffset = return_offset;
-														}
-														break;
+										case DW_AT_type:
+											if (dwarf_global_formref(return_attr1, &return_offset, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].TypeOffset = return_offset;
+											}
+											break;
 
-														// Variable name
-													case DW_AT_name:
-														if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
-														{
+											// Variable name
+										case DW_AT_name:
+											if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
+											{
 #ifdef DEBUG_VariableName
-															if (!strcmp(return_string, DEBUG_VariableName))
+												if (!strcmp(return_string, DEBUG_VariableName))
 #endif
-															{
-																PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
-																strcpy(PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrName, return_string);
-															}
-															dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-														}
-														break;
-
-														default:
-														break;
-													}
+												{
+													PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
+													strcpy(PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrName, return_string);
 												}
+												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
 											}
+											break;
 
-											dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+											default:
+											break;
 										}
+									}
+								}
 
-										// Check variable's name validity
-										if (PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrName)
-										{
-											// Check variable's memory address validity
-											if (PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].Addr)
-											{
-												// Valid variable
-												PtrCU[NbCU].NbVariables++;
-											}
-											else
-											{
-												// Invalid variable
-												free(PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrName);
-												PtrCU[NbCU].PtrVariables[PtrCU[NbCU].NbVariables].PtrName = NULL;
-											}
-										}
+								dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+							}
 
-										dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
-									}
-									break;
-
-								case DW_TAG_base_type:
-								case DW_TAG_typedef:
-								case DW_TAG_union_type:
-								case DW_TAG_structure_type:
-								case DW_TAG_pointer_type:
-								case DW_TAG_const_type:
-								case DW_TAG_array_type:
-								case DW_TAG_subrange_type:
-								case DW_TAG_subroutine_type:
-								case DW_TAG_enumeration_type:
-									if (dwarf_attrlist(return_die, &atlist, &atcnt, &error) == DW_DLV_OK)
-									{
-										// Allocate memory for this type
-										PtrCU[NbCU].PtrTypes = (BaseTypeStruct *)realloc(PtrCU[NbCU].PtrTypes, ((PtrCU[NbCU].NbTypes + 1) * sizeof(BaseTypeStruct)));
-										memset(PtrCU[NbCU].PtrTypes + PtrCU[NbCU].NbTypes, 0, sizeof(BaseTypeStruct));
-										PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].Tag = return_tagval;
+							// Check variable's name validity
+							if (PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrName)
+							{
+								// Check variable's memory address validity
+								if (PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].Addr)
+								{
+									// Valid variable
+									PtrCU[NumCU].NbVariables++;
+								}
+								else
+								{
+									// Invalid variable
+									free(PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrName);
+									PtrCU[NumCU].PtrVariables[PtrCU[NumCU].NbVariables].PtrName = NULL;
+								}
+							}
 
-										if (dwarf_dieoffset(return_die, &return_offset, &error) == DW_DLV_OK)
-										{
-											PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].Offset = return_offset;
-										}
+							dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+						}
+						break;
+
+					case DW_TAG_base_type:
+					case DW_TAG_typedef:
+					case DW_TAG_union_type:
+					case DW_TAG_structure_type:
+					case DW_TAG_pointer_type:
+					case DW_TAG_const_type:
+					case DW_TAG_array_type:
+					case DW_TAG_subrange_type:
+					case DW_TAG_subroutine_type:
+					case DW_TAG_enumeration_type:
+						if (dwarf_attrlist(return_die, &atlist, &atcnt, &error) == DW_DLV_OK)
+						{
+							// Allocate memory for this type
+							PtrCU[NumCU].PtrTypes = (BaseTypeStruct *)realloc(PtrCU[NumCU].PtrTypes, ((PtrCU[NumCU].NbTypes + 1) * sizeof(BaseTypeStruct)));
+							memset(PtrCU[NumCU].PtrTypes + PtrCU[NumCU].NbTypes, 0, sizeof(BaseTypeStruct));
+							PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].Tag = return_tagval;
+
+							if (dwarf_dieoffset(return_die, &return_offset, &error) == DW_DLV_OK)
+							{
+								PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].Offset = return_offset;
+							}
 
-										for (Dwarf_Signed i = 0; i < atcnt; ++i)
+							for (Dwarf_Signed i = 0; i < atcnt; ++i)
+							{
+								if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+								{
+									if (dwarf_attr(return_die, return_attr, &return_attr1, &error) == DW_DLV_OK)
+									{
+										switch (return_attr)
 										{
-											if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
-											{
-												if (dwarf_attr(return_die, return_attr, &return_attr1, &error) == DW_DLV_OK)
-												{
-													switch (return_attr)
-													{
-														// 
-													case DW_AT_sibling:
-														break;
+											// 
+										case DW_AT_sibling:
+											break;
 
-														// Type's type offset
-													case DW_AT_type:
-														if (dwarf_global_formref(return_attr1, &return_offset, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].TypeOffset = return_offset;
-														}
-														break;
+											// Type's type offset
+										case DW_AT_type:
+											if (dwarf_global_formref(return_attr1, &return_offset, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].TypeOffset = return_offset;
+											}
+											break;
 
-														// Type's byte size
-													case DW_AT_byte_size:
-														if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].ByteSize = return_uvalue;
-														}
-														break;
+											// Type's byte size
+										case DW_AT_byte_size:
+											if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].ByteSize = return_uvalue;
+											}
+											break;
 
-														// Type's encoding
-													case DW_AT_encoding:
-														if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].Encoding = return_uvalue;
-														}
-														break;
+											// Type's encoding
+										case DW_AT_encoding:
+											if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].Encoding = return_uvalue;
+											}
+											break;
 
-														// Type's name
-													case DW_AT_name:
-														if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
-														{
+											// Type's name
+										case DW_AT_name:
+											if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
+											{
 #ifdef DEBUG_TypeName
-															if (!strcmp(return_string, DEBUG_TypeName))
+												if (!strcmp(return_string, DEBUG_TypeName))
 #endif
-															{
-																PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
-																strcpy(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrName, return_string);
-															}
-															dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-														}
-														break;
-
-														// Type's file number
-													case DW_AT_decl_file:
-														break;
-
-														// Type's line number
-													case DW_AT_decl_line:
-														break;
-
-													default:
-														break;
-													}
+												{
+													PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
+													strcpy(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrName, return_string);
 												}
+												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
 											}
+											break;
+
+											// Type's file number
+										case DW_AT_decl_file:
+											break;
 
-											dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+											// Type's line number
+										case DW_AT_decl_line:
+											break;
+
+										default:
+											break;
 										}
+									}
+								}
 
-										dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+								dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+							}
 
-										switch (return_tagval)
+							dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+
+							switch (return_tagval)
+							{
+							case DW_TAG_structure_type:
+							case DW_TAG_union_type:
+								if (dwarf_child(return_die, &return_subdie, &error) == DW_DLV_OK)
+								{
+									do
+									{
+										return_sub = return_subdie;
+										if ((dwarf_tag(return_subdie, &return_tagval, &error) == DW_DLV_OK))
 										{
-										case DW_TAG_structure_type:
-										case DW_TAG_union_type:
-											if (dwarf_child(return_die, &return_subdie, &error) == DW_DLV_OK)
+											switch (return_tagval)
 											{
-												do
+											case DW_TAG_member:
+												if (dwarf_attrlist(return_subdie, &atlist, &atcnt, &error) == DW_DLV_OK)
 												{
-													return_sub = return_subdie;
-													if ((dwarf_tag(return_subdie, &return_tagval, &error) == DW_DLV_OK))
+													// Allocate memory for this member
+													PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers = (StructureMembersStruct *)realloc(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers, ((PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers + 1) * sizeof(StructureMembersStruct)));
+													memset(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers + PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers, 0, sizeof(StructureMembersStruct));
+
+													for (Dwarf_Signed i = 0; i < atcnt; ++i)
 													{
-														switch (return_tagval)
+														if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
 														{
-														case DW_TAG_member:
-															if (dwarf_attrlist(return_subdie, &atlist, &atcnt, &error) == DW_DLV_OK)
+															if (dwarf_attr(return_subdie, return_attr, &return_attr1, &error) == DW_DLV_OK)
 															{
-																// Allocate memory for this member
-																PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers = (StructureMembersStruct *)realloc(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers, ((PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers + 1) * sizeof(StructureMembersStruct)));
-																memset(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers + PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers, 0, sizeof(StructureMembersStruct));
-
-																for (Dwarf_Signed i = 0; i < atcnt; ++i)
+																switch (return_attr)
 																{
-																	if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+																case DW_AT_data_member_location:
+																	if (dwarf_whatform(return_attr1, &form, &error) == DW_DLV_OK)
 																	{
-																		if (dwarf_attr(return_subdie, return_attr, &return_attr1, &error) == DW_DLV_OK)
+																		if ((form == DW_FORM_data1) || (form == DW_FORM_data2) || (form == DW_FORM_data2) || (form == DW_FORM_data4) || (form == DW_FORM_data8) || (form == DW_FORM_udata))
+																		{
+																			if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+																			{
+																				PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].DataMemberLocation = return_uvalue;
+																			}
+																		}
+																		else
 																		{
-																			switch (return_attr)
+																			if (form == DW_FORM_sdata)
 																			{
-																			case DW_AT_data_member_location:
-																				if (dwarf_whatform(return_attr1, &form, &error) == DW_DLV_OK)
+																				if (dwarf_formsdata(return_attr1, &return_value, &error) == DW_DLV_OK)
 																				{
-																					if ((form == DW_FORM_data1) || (form == DW_FORM_data2) || (form == DW_FORM_data2) || (form == DW_FORM_data4) || (form == DW_FORM_data8) || (form == DW_FORM_udata))
-																					{
-																						if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
-																						{
-																							PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].DataMemberLocation = return_uvalue;
-																						}
-																					}
-																					else
-																					{
-																						if (form == DW_FORM_sdata)
-																						{
-																							if (dwarf_formsdata(return_attr1, &return_value, &error) == DW_DLV_OK)
-																							{
-																								PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].DataMemberLocation = return_value;
-																							}
-																						}
-																						else
-																						{
-																							if (dwarf_formblock(return_attr1, &return_block, &error) == DW_DLV_OK)
-																							{
-																								switch (return_block->bl_len)
-																								{
-																								case 2:
-																								case 3:
-																								case 4:
-																									PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].DataMemberLocation = ReadULEB128((char *)return_block->bl_data + 1);
-																									break;
-
-																								default:
-																									break;
-																								}
-
-																								dwarf_dealloc(dbg, return_block, DW_DLA_BLOCK);
-																							}
-																						}
-																					}
+																					PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].DataMemberLocation = return_value;
 																				}
-																				break;
-
-																			case DW_AT_type:
-																				//dwarf_whatform(return_attr1, &form, &error);
-																				if (dwarf_global_formref(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+																			}
+																			else
+																			{
+																				if (dwarf_formblock(return_attr1, &return_block, &error) == DW_DLV_OK)
 																				{
-																					PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].TypeOffset = return_uvalue;
-																				}
-																				break;
+																					switch (return_block->bl_len)
+																					{
+																					case 2:
+																					case 3:
+																					case 4:
+																						PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].DataMemberLocation = ReadULEB128((char *)return_block->bl_data + 1);
+																						break;
 
-																			case DW_AT_name:
-																				if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
-																				{
-																					PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
-																					strcpy(PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].PtrStructureMembers[PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers].PtrName, return_string);
+																					default:
+																						break;
+																					}
 
-																					dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
+																					dwarf_dealloc(dbg, return_block, DW_DLA_BLOCK);
 																				}
-																				break;
+																			}
+																		}
+																	}
+																	break;
 
-																				// Member's file number
-																			case DW_AT_decl_file:
-																				break;
+																case DW_AT_type:
+																	//dwarf_whatform(return_attr1, &form, &error);
+																	if (dwarf_global_formref(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+																	{
+																		PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].TypeOffset = return_uvalue;
+																	}
+																	break;
 
-																				// Member's line number
-																			case DW_AT_decl_line:
-																				break;
+																case DW_AT_name:
+																	if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
+																	{
+																		PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
+																		strcpy(PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].PtrStructureMembers[PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers].PtrName, return_string);
 
-																			default:
-																				break;
-																			}
-																		}
+																		dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
 																	}
-																}
-																dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+																	break;
+
+																	// Member's file number
+																case DW_AT_decl_file:
+																	break;
 
-																PtrCU[NbCU].PtrTypes[PtrCU[NbCU].NbTypes].NbStructureMembers++;
+																	// Member's line number
+																case DW_AT_decl_line:
+																	break;
+
+																default:
+																	break;
+																}
 															}
-															break;
 														}
 													}
-												} while (dwarf_siblingof(dbg, return_sub, &return_subdie, &error) == DW_DLV_OK);
+													dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+
+													PtrCU[NumCU].PtrTypes[PtrCU[NumCU].NbTypes].NbStructureMembers++;
+												}
+												break;
 											}
-											break;
 										}
+									} while (dwarf_siblingof(dbg, return_sub, &return_subdie, &error) == DW_DLV_OK);
+								}
+								break;
+							}
 
-										PtrCU[NbCU].NbTypes++;
-									}
-									break;
+							PtrCU[NumCU].NbTypes++;
+						}
+						break;
 
-								case DW_TAG_subprogram:
-									if (dwarf_attrlist(return_die, &atlist, &atcnt, &error) == DW_DLV_OK)
-									{
-										PtrCU[NbCU].PtrSubProgs = (SubProgStruct *)realloc(PtrCU[NbCU].PtrSubProgs, ((PtrCU[NbCU].NbSubProgs + 1) * sizeof(SubProgStruct)));
-										memset((void *)(PtrCU[NbCU].PtrSubProgs + PtrCU[NbCU].NbSubProgs), 0, sizeof(SubProgStruct));
-										PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].Tag = return_tagval;
+					case DW_TAG_subprogram:
+						if (dwarf_attrlist(return_die, &atlist, &atcnt, &error) == DW_DLV_OK)
+						{
+							PtrCU[NumCU].PtrSubProgs = (SubProgStruct *)realloc(PtrCU[NumCU].PtrSubProgs, ((PtrCU[NumCU].NbSubProgs + 1) * sizeof(SubProgStruct)));
+							memset((void *)(PtrCU[NumCU].PtrSubProgs + PtrCU[NumCU].NbSubProgs), 0, sizeof(SubProgStruct));
+							PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].Tag = return_tagval;
 
-										for (Dwarf_Signed i = 0; i < atcnt; ++i)
+							for (Dwarf_Signed i = 0; i < atcnt; ++i)
+							{
+								if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+								{
+									if (dwarf_attr(return_die, return_attr, &return_attr1, &error) == DW_DLV_OK)
+									{
+										switch (return_attr)
 										{
-											if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+											// start address
+										case DW_AT_low_pc:
+											if (dwarf_lowpc(return_die, &return_lowpc, &error) == DW_DLV_OK)
 											{
-												if (dwarf_attr(return_die, return_attr, &return_attr1, &error) == DW_DLV_OK)
-												{
-													switch (return_attr)
-													{
-														// start address
-													case DW_AT_low_pc:
-														if (dwarf_lowpc(return_die, &return_lowpc, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].StartPC = return_lowpc;
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].LowPC = return_lowpc;
-														}
-														break;
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].StartPC = return_lowpc;
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].LowPC = return_lowpc;
+											}
+											break;
 
-														// end address
-													case DW_AT_high_pc:
-														if (dwarf_highpc(return_die, &return_highpc, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].HighPC = return_highpc;
-														}
-														break;
+											// end address
+										case DW_AT_high_pc:
+											if (dwarf_highpc(return_die, &return_highpc, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].HighPC = return_highpc;
+											}
+											break;
 
-														// Line number
-													case DW_AT_decl_line:
-														if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NumLineSrc = return_uvalue;
-														}
-														break;
+											// Line number
+										case DW_AT_decl_line:
+											if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NumLineSrc = return_uvalue;
+											}
+											break;
 
-														// Frame
-													case DW_AT_frame_base:
-														if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].FrameBase = return_uvalue;
-															PtrCU[NbCU].NbFrames++;
-														}
-														break;
+											// Frame
+										case DW_AT_frame_base:
+											if (dwarf_formudata(return_attr1, &return_uvalue, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].FrameBase = return_uvalue;
+												PtrCU[NumCU].NbFrames++;
+											}
+											break;
 
-														// function name
-													case DW_AT_name:
-														if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
-														{
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrSubprogramName = (char *)calloc(strlen(return_string) + 1, 1);
-															strcpy(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrSubprogramName, return_string);
-															dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-														}
-														break;
+											// function name
+										case DW_AT_name:
+											if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
+											{
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrSubprogramName = (char *)calloc(strlen(return_string) + 1, 1);
+												strcpy(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrSubprogramName, return_string);
+												dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
+											}
+											break;
 
-													case DW_AT_sibling:
-														break;
+										case DW_AT_sibling:
+											break;
 
-													case DW_AT_GNU_all_tail_call_sites:
-														break;
+										case DW_AT_GNU_all_tail_call_sites:
+											break;
 
-													case DW_AT_type:
-														break;
+										case DW_AT_type:
+											break;
 
-													case DW_AT_prototyped:
-														break;
+										case DW_AT_prototyped:
+											break;
 
-														// File number
-													case DW_AT_decl_file:
-														break;
+											// File number
+										case DW_AT_decl_file:
+											break;
 
-													case DW_AT_external:
-														break;
+										case DW_AT_external:
+											break;
 
-													default:
-														break;
-													}
-												}
-											}
-											dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+										default:
+											break;
 										}
-										dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+									}
+								}
+								dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+							}
+							dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
 
-										// Get source line number and associated block of address
-										for (Dwarf_Signed i = 0; i < cnt; ++i)
-										{
-											// Check the presence of the line in the memory frame
-											if (PtrCU[NbCU].PtrUsedLinesSrc && (PtrCU[NbCU].PtrUsedLinesSrc[i].StartPC >= return_lowpc) && (PtrCU[NbCU].PtrUsedLinesSrc[i].StartPC <= return_highpc))
-											{
-												PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrLinesSrc = (DMIStruct_LineSrc *)realloc(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrLinesSrc, (PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbLinesSrc + 1) * sizeof(DMIStruct_LineSrc));
-												memset((void *)(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrLinesSrc + PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbLinesSrc), 0, sizeof(DMIStruct_LineSrc));
-												PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrLinesSrc[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbLinesSrc].StartPC = PtrCU[NbCU].PtrUsedLinesSrc[i].StartPC;
-												PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrLinesSrc[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbLinesSrc].NumLineSrc = PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc;
-												PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbLinesSrc++;
-											}
-										}
+							// Get source line number and associated block of address
+							for (Dwarf_Signed i = 0; i < cnt; ++i)
+							{
+								// Check the presence of the line in the memory frame
+								if (PtrCU[NumCU].PtrUsedLinesSrc && (PtrCU[NumCU].PtrUsedLinesSrc[i].StartPC >= return_lowpc) && (PtrCU[NumCU].PtrUsedLinesSrc[i].StartPC <= return_highpc))
+								{
+									PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrLinesSrc = (DMIStruct_LineSrc *)realloc(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrLinesSrc, (PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbLinesSrc + 1) * sizeof(DMIStruct_LineSrc));
+									memset((void *)(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrLinesSrc + PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbLinesSrc), 0, sizeof(DMIStruct_LineSrc));
+									PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrLinesSrc[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbLinesSrc].StartPC = PtrCU[NumCU].PtrUsedLinesSrc[i].StartPC;
+									PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrLinesSrc[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbLinesSrc].NumLineSrc = PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc;
+									PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbLinesSrc++;
+								}
+							}
 
-										if (dwarf_child(return_die, &return_subdie, &error) == DW_DLV_OK)
+							if (dwarf_child(return_die, &return_subdie, &error) == DW_DLV_OK)
+							{
+								do
+								{
+									return_sub = return_subdie;
+									if ((dwarf_tag(return_subdie, &return_tagval, &error) == DW_DLV_OK))
+									{
+										switch (return_tagval)
 										{
-											do
+										case DW_TAG_formal_parameter:
+										case DW_TAG_variable:
+											if (dwarf_attrlist(return_subdie, &atlist, &atcnt, &error) == DW_DLV_OK)
 											{
-												return_sub = return_subdie;
-												if ((dwarf_tag(return_subdie, &return_tagval, &error) == DW_DLV_OK))
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables = (VariablesStruct *)realloc(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables, ((PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables + 1) * sizeof(VariablesStruct)));
+												memset(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables + PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables, 0, sizeof(VariablesStruct));
+
+												for (Dwarf_Signed i = 0; i < atcnt; ++i)
 												{
-													switch (return_tagval)
+													if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
 													{
-													case DW_TAG_formal_parameter:
-													case DW_TAG_variable:
-														if (dwarf_attrlist(return_subdie, &atlist, &atcnt, &error) == DW_DLV_OK)
+														if (dwarf_attr(return_subdie, return_attr, &return_attr1, &error) == DW_DLV_OK)
 														{
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables = (VariablesStruct *)realloc(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables, ((PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables + 1) * sizeof(VariablesStruct)));
-															memset(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables + PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables, 0, sizeof(VariablesStruct));
-
-															for (Dwarf_Signed i = 0; i < atcnt; ++i)
+															switch (return_attr)
 															{
-																if (dwarf_whatattr(atlist[i], &return_attr, &error) == DW_DLV_OK)
+															case DW_AT_location:
+																if (dwarf_formblock(return_attr1, &return_block, &error) == DW_DLV_OK)
 																{
-																	if (dwarf_attr(return_subdie, return_attr, &return_attr1, &error) == DW_DLV_OK)
-																	{
-																		switch (return_attr)
-																		{
-																		case DW_AT_location:
-																			if (dwarf_formblock(return_attr1, &return_block, &error) == DW_DLV_OK)
-																			{
-																				PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].Op = *((unsigned char *)(return_block->bl_data));
-
-																				switch (return_block->bl_len)
-																				{
-																				case 1:
-																					break;
-
-																				case 2:
-																				case 3:
-																					switch (return_tagval)
-																					{
-																					case DW_TAG_variable:
-																						PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].Offset = ReadLEB128((char *)return_block->bl_data + 1);
-																						break;
-
-																					case DW_TAG_formal_parameter:
-																						PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].Offset = ReadULEB128((char *)return_block->bl_data + 1);
-																						break;
+																	PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].Op = *((unsigned char *)(return_block->bl_data));
 
-																					default:
-																						break;
-																					}
-																					break;
+																	switch (return_block->bl_len)
+																	{
+																	case 1:
+																		break;
 
-																				default:
-																					break;
-																				}
-																				dwarf_dealloc(dbg, return_block, DW_DLA_BLOCK);
-																			}
+																	case 2:
+																	case 3:
+																		switch (return_tagval)
+																		{
+																		case DW_TAG_variable:
+																			PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].Offset = ReadLEB128((char *)return_block->bl_data + 1);
 																			break;
 
-																		case DW_AT_type:
-																			if (dwarf_global_formref(return_attr1, &return_offset, &error) == DW_DLV_OK)
-																			{
-																				PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].TypeOffset = return_offset;
-																			}
+																		case DW_TAG_formal_parameter:
+																			PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].Offset = ReadULEB128((char *)return_block->bl_data + 1);
 																			break;
 
-																		case DW_AT_name:
-																			if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
-																			{
-#ifdef DEBUG_VariableName
-																				if (!strcmp(return_string, DEBUG_VariableName))
-#endif
-																				{
-																					PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
-																					strcpy(PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].PtrVariables[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables].PtrName, return_string);
-																				}
-																				dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
-																			}
+																		default:
 																			break;
+																		}
+																		break;
 
-																		case DW_AT_decl_file:
-																			break;
+																	default:
+																		break;
+																	}
+																	dwarf_dealloc(dbg, return_block, DW_DLA_BLOCK);
+																}
+																break;
 
-																		case DW_AT_decl_line:
-																			break;
+															case DW_AT_type:
+																if (dwarf_global_formref(return_attr1, &return_offset, &error) == DW_DLV_OK)
+																{
+																	PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].TypeOffset = return_offset;
+																}
+																break;
 
-																		default:
-																			break;
-																		}
+															case DW_AT_name:
+																if (dwarf_formstring(return_attr1, &return_string, &error) == DW_DLV_OK)
+																{
+#ifdef DEBUG_VariableName
+																	if (!strcmp(return_string, DEBUG_VariableName))
+#endif
+																	{
+																		PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].PtrName = (char *)calloc(strlen(return_string) + 1, 1);
+																		strcpy(PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].PtrVariables[PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables].PtrName, return_string);
 																	}
+																	dwarf_dealloc(dbg, return_string, DW_DLA_STRING);
 																}
+																break;
 
-																dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
-															}
+															case DW_AT_decl_file:
+																break;
 
-															PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs].NbVariables++;
+															case DW_AT_decl_line:
+																break;
 
-															dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+															default:
+																break;
+															}
 														}
-														break;
+													}
+
+													dwarf_dealloc(dbg, atlist[i], DW_DLA_ATTR);
+												}
+
+												PtrCU[NumCU].PtrSubProgs[PtrCU[NumCU].NbSubProgs].NbVariables++;
+
+												dwarf_dealloc(dbg, atlist, DW_DLA_LIST);
+											}
+											break;
+
+										case DW_TAG_label:
+											break;
+
+										default:
+											break;
+										}
+									}
+								}
+								while (dwarf_siblingof(dbg, return_sub, &return_subdie, &error) == DW_DLV_OK);
+							}
+
+							PtrCU[NumCU].NbSubProgs++;
+						}
+						break;
+
+					default:
+						break;
+					}
+				}
+			}
+			while (dwarf_siblingof(dbg, return_sib, &return_die, &error) == DW_DLV_OK);
+		}
+	}
+
+	// Set information based on used line numbers
+	if (PtrCU[NumCU].PtrUsedLinesSrc)
+	{
+		for (size_t i = 0; i < PtrCU[NumCU].NbUsedLinesSrc; i++)
+		{
+			PtrCU[NumCU].PtrUsedNumLines[i] = PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc - 1;
+		}
+
+		// Setup memory range for the code if CU doesn't have already this information
+		// It is taken from the used lines structure
+		if (!PtrCU[NumCU].LowPC && (!PtrCU[NumCU].HighPC || (PtrCU[NumCU].HighPC == ~0)))
+		{
+			PtrCU[NumCU].LowPC = PtrCU[NumCU].PtrUsedLinesSrc[0].StartPC;
+			PtrCU[NumCU].HighPC = PtrCU[NumCU].PtrUsedLinesSrc[PtrCU[NumCU].NbUsedLinesSrc - 1].StartPC;
+		}
+	}
+
+	// Init global variables information based on types information
+	for (size_t i = 0; i < PtrCU[NumCU].NbVariables; i++)
+	{
+		DWARFManager_InitInfosVariable(NumCU, PtrCU[NumCU].PtrVariables + i);
+	}
+
+	// Init local variables information based on types information
+	for (size_t i = 0; i < PtrCU[NumCU].NbSubProgs; i++)
+	{
+		for (size_t j = 0; j < PtrCU[NumCU].PtrSubProgs[i].NbVariables; j++)
+		{
+			DWARFManager_InitInfosVariable(NumCU, PtrCU[NumCU].PtrSubProgs[i].PtrVariables + j);
+		}
+	}
+
+	return true;
+}
+
+
+// Dwarf manager Compilation Unit source code load, done at the first look up of its text
+// The source file is mapped read only, and its lines index keeps the offset and the length of each line in the mapping
+// A loaded source file is checked again, at most once a second, and is reloaded if it has been modified
+void DWARFManager_LoadCUSrc(size_t NumCU)
+{
+	struct stat _statbuf;
+	time_t CheckTime = time(NULL);
+	uint32_t Size;
+	char *Ptr, *PtrEnd;
+
+	// Check the source file modification
+	if (PtrCU[NumCU].LoadedSrc && (PtrCU[NumCU].CheckSrcTime != CheckTime) && ((PtrCU[NumCU].Status == DWARFSTATUS_OK) || (PtrCU[NumCU].Status == DWARFSTATUS_OUTDATEDFILE)))
+	{
+		PtrCU[NumCU].CheckSrcTime = CheckTime;
+
+		if (!stat(PtrCU[NumCU].PtrFullFilename, &_statbuf) && ((_statbuf.st_mtime != PtrCU[NumCU]._statbuf.st_mtime) || (_statbuf.st_size != PtrCU[NumCU]._statbuf.st_size)))
+		{
+			// check again the time stamp with the executable
+			PtrCU[NumCU]._statbuf = _statbuf;
+			PtrCU[NumCU].Status = (_statbuf.st_mtime > FileElfExeInfo.st_mtime) ? DWARFSTATUS_OUTDATEDFILE : DWARFSTATUS_OK;
+			DWARFManager_CloseCUSrc(NumCU);
+		}
+	}
+
+	if (PtrCU[NumCU].LoadedSrc)
+	{
+		return;
+	}
+
+	PtrCU[NumCU].LoadedSrc = true;
+	PtrCU[NumCU].NumLoadSrc++;
+	PtrCU[NumCU].CheckSrcTime = CheckTime;
+
+	// Map the source file
+	if (PtrCU[NumCU].Status == DWARFSTATUS_OK)
+	{
+		if ((PtrCU[NumCU].PtrLoadSrc = (char *)FileMap(PtrCU[NumCU].PtrFullFilename, Size, true)))
+		{
+			PtrCU[NumCU].SizeLoadSrc = Size;
+		}
+		else
+		{
+			// Source file doesn't exist, unless it is empty
+			if (PtrCU[NumCU]._statbuf.st_size)
+			{
+				PtrCU[NumCU].Status = DWARFSTATUS_NOFILE;
+			}
+		}
+	}
 
-													case DW_TAG_label:
-														break;
+	// Set the lines index
+	if (PtrCU[NumCU].PtrLoadSrc)
+	{
+		PtrEnd = PtrCU[NumCU].PtrLoadSrc + PtrCU[NumCU].SizeLoadSrc;
 
-													default:
-														break;
-													}
-												}
-											}
-											while (dwarf_siblingof(dbg, return_sub, &return_subdie, &error) == DW_DLV_OK);
-										}
+		// Count line numbers, based on the new line code '\n' (0xa)
+		for (Ptr = PtrCU[NumCU].PtrLoadSrc; Ptr < PtrEnd; Ptr++)
+		{
+			if ((Ptr = (char *)memchr(Ptr, '\n', (PtrEnd - Ptr))))
+			{
+				PtrCU[NumCU].NbLinesLoadSrc++;
+			}
+			else
+			{
+				PtrCU[NumCU].NbLinesLoadSrc++;
+				break;
+			}
+		}
 
-										PtrCU[NbCU].NbSubProgs++;
-									}
-									break;
+		// Set each line, without its new line code '\n' (0xa), and its carriage return code '\r' (0xd)
+		if ((PtrCU[NumCU].PtrLinesLoadSrc = (DWARFlinesrc *)calloc(PtrCU[NumCU].NbLinesLoadSrc, sizeof(DWARFlinesrc))))
+		{
+			Ptr = PtrCU[NumCU].PtrLoadSrc;
 
-								default:
-									break;
-								}
-							}
-						}
-						while (dwarf_siblingof(dbg, return_sib, &return_die, &error) == DW_DLV_OK);
-					}
-				}
+			for (size_t i = 0; i < PtrCU[NumCU].NbLinesLoadSrc; i++)
+			{
+				char *PtrNewLine = (char *)memchr(Ptr, '\n', (PtrEnd - Ptr));
 
-				// Set the source code lines
-				if (PtrCU[NbCU].NbLinesLoadSrc)
+				if (!PtrNewLine)
 				{
-					if (PtrCU[NbCU].PtrLinesLoadSrc = (char **)calloc(PtrCU[NbCU].NbLinesLoadSrc, sizeof(char *)))
-					{
-						for (size_t j = 0; j < PtrCU[NbCU].NbLinesLoadSrc; j++)
-						{
-							if (PtrCU[NbCU].PtrLinesLoadSrc[j] = (char *)calloc(10000, sizeof(char)))
-							{
-								if (Ptr = DWARFManager_GetLineSrcFromNumLine(PtrCU[NbCU].PtrLoadSrc, (j + 1)))
-								{
-#ifndef CONVERT_QT_HML
-									strcpy(PtrCU[NbCU].PtrLinesLoadSrc[j], Ptr);
-#else
-									size_t i = 0;
-
-									while (*Ptr)
-									{
-										switch (*Ptr)
-										{
-										case 9:
-											strcat(PtrCU[NbCU].PtrLinesLoadSrc[j], "&nbsp;");
-											i += 6;
-											break;
+					PtrNewLine = PtrEnd;
+				}
 
-										case '<':
-											strcat(PtrCU[NbCU].PtrLinesLoadSrc[j], "&lt;");
-											i += 4;
-											break;
+				PtrCU[NumCU].PtrLinesLoadSrc[i].Offset = Ptr - PtrCU[NumCU].PtrLoadSrc;
+				PtrCU[NumCU].PtrLinesLoadSrc[i].Length = ((PtrNewLine > Ptr) && (PtrNewLine[-1] == '\r')) ? (PtrNewLine - Ptr - 1) : (PtrNewLine - Ptr);
+				Ptr = PtrNewLine + 1;
+			}
+		}
+		else
+		{
+			PtrCU[NumCU].NbLinesLoadSrc = 0;
+		}
+	}
 
-										case '>':
-											strcat(PtrCU[NbCU].PtrLinesLoadSrc[j], "&gt;");
-											i += 4;
-											break;
-#if 0
-										case '&':
-											strcpy(PtrCU[NbCU].PtrLinesLoadSrc[j], "&amp;");
-											i += strlen("&amp;");
-											break;
-#endif
-#if 0
-										case '"':
-											strcpy(PtrCU[NbCU].PtrLinesLoadSrc[j], "&quot;");
-											i += strlen("&quot;");
-											break;
-#endif
-										default:
-											PtrCU[NbCU].PtrLinesLoadSrc[j][i++] = *Ptr;
-											break;
-										}
-										Ptr++;
-									}
-#endif
-								}
-								PtrCU[NbCU].PtrLinesLoadSrc[j] = (char *)realloc(PtrCU[NbCU].PtrLinesLoadSrc[j], strlen(PtrCU[NbCU].PtrLinesLoadSrc[j]) + 1);
-							}
-						}
+	// Init lines source information for each used lines
+	for (size_t i = 0; i < PtrCU[NumCU].NbUsedLinesSrc; i++)
+	{
+		if (PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc && (PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc <= PtrCU[NumCU].NbLinesLoadSrc))
+		{
+			PtrCU[NumCU].PtrUsedLinesLoadSrc[i] = PtrCU[NumCU].PtrLinesLoadSrc[PtrCU[NumCU].PtrUsedLinesSrc[i].NumLineSrc - 1];
+		}
+	}
+}
 
-						// Init lines source information for each source code line numbers and for each subprogs
-						for (size_t j = 0; j < PtrCU[NbCU].NbSubProgs; j++)
-						{
-							// Check if the subprog / function's line exists in the source code
-							if (PtrCU[NbCU].PtrSubProgs[j].NumLineSrc <= PtrCU[NbCU].NbLinesLoadSrc)
-							{
-								PtrCU[NbCU].PtrSubProgs[j].PtrLineSrc = PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].PtrSubProgs[j].NumLineSrc - 1];
-							}
 
-							for (size_t k = 0; k < PtrCU[NbCU].PtrSubProgs[j].NbLinesSrc; k++)
-							{
-								if (PtrCU[NbCU].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc <= PtrCU[NbCU].NbLinesLoadSrc)
-								{
-									PtrCU[NbCU].PtrSubProgs[j].PtrLinesSrc[k].PtrLineSrc = PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc - 1];
-								}
-							}
-						}
-					}
-				}
-				else
-				{
-					// Set each source lines pointer to NULL
-					if (PtrCU[NbCU].NbSubProgs)
-					{
-						// Check the presence of source lines dedicated to the sub progs
-						if (PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs - 1].NbLinesSrc)
-						{
-							size_t i = PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs - 1].PtrLinesSrc[PtrCU[NbCU].PtrSubProgs[PtrCU[NbCU].NbSubProgs - 1].NbLinesSrc - 1].NumLineSrc;
-							if (PtrCU[NbCU].PtrLinesLoadSrc = (char **)calloc(i, sizeof(char *)))
-							{
-								for (size_t j = 0; j < i; j++)
-								{
-									PtrCU[NbCU].PtrLinesLoadSrc[j] = NULL;
-								}
-							}
-						}
-					}
-				}
+// Dwarf manager Compilation Unit source code close, before its reload
+// The text is unmapped, and the lines source information are reset
+void DWARFManager_CloseCUSrc(size_t NumCU)
+{
+	FileUnmap((uint8_t *)PtrCU[NumCU].PtrLoadSrc, (uint32_t)PtrCU[NumCU].SizeLoadSrc);
+	free(PtrCU[NumCU].PtrLinesLoadSrc);
 
-				// Check validity between used number lines and number lines in the source file
-				if (PtrCU[NbCU].LastNumUsedLinesSrc <= PtrCU[NbCU].NbLinesLoadSrc)
-				{
-					// Set information based on used line numbers
-					if (PtrCU[NbCU].PtrUsedLinesSrc)
-					{
-						// Set the line source pointers for each used line numbers
-						if (PtrCU[NbCU].PtrLinesLoadSrc)
-						{
-							for (size_t i = 0; i < PtrCU[NbCU].NbUsedLinesSrc; i++)
-							{
-								PtrCU[NbCU].PtrUsedNumLines[i] = PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc - 1;
-								PtrCU[NbCU].PtrUsedLinesLoadSrc[i] = PtrCU[NbCU].PtrUsedLinesSrc[i].PtrLineSrc = PtrCU[NbCU].PtrLinesLoadSrc[PtrCU[NbCU].PtrUsedLinesSrc[i].NumLineSrc - 1];
-							}
+	PtrCU[NumCU].SizeLoadSrc = 0;
+	PtrCU[NumCU].PtrLoadSrc = NULL;
+	PtrCU[NumCU].NbLinesLoadSrc = 0;
+	PtrCU[NumCU].PtrLinesLoadSrc = NULL;
+	PtrCU[NumCU].LoadedSrc = false;
 
-							// Setup memory range for the code if CU doesn't have already this information
-							// It is taken from the used lines structure
-							if (!PtrCU[NbCU].LowPC && (!PtrCU[NbCU].HighPC || (PtrCU[NbCU].HighPC == ~0)))
-							{
-								PtrCU[NbCU].LowPC = PtrCU[NbCU].PtrUsedLinesSrc[0].StartPC;
-								PtrCU[NbCU].HighPC = PtrCU[NbCU].PtrUsedLinesSrc[PtrCU[NbCU].NbUsedLinesSrc - 1].StartPC;
-							}
-						}
-					}
-				}
+	for (size_t i = 0; i < PtrCU[NumCU].NbUsedLinesSrc; i++)
+	{
+		PtrCU[NumCU].PtrUsedLinesLoadSrc[i].Offset = PtrCU[NumCU].PtrUsedLinesLoadSrc[i].Length = 0;
+	}
+}
 
-				// Init global variables information based on types information
-				for (size_t i = 0; i < PtrCU[NbCU].NbVariables; i++)
-				{
-					DWARFManager_InitInfosVariable(PtrCU[NbCU].PtrVariables + i);
-				}
 
-				// Init local variables information based on types information
-				for (size_t i = 0; i < PtrCU[NbCU].NbSubProgs; i++)
-				{
-					for (size_t j = 0; j < PtrCU[NbCU].PtrSubProgs[i].NbVariables; j++)
-					{
-						DWARFManager_InitInfosVariable(PtrCU[NbCU].PtrSubProgs[i].PtrVariables + j);
-					}
-				}
-			}
+// Get a text line, and its length, from a CU's source code based on the line number (starting from 1)
+// The text line is not finished with 0, and is valid until the source code text is reloaded
+// Return NULL if the line number is not in the source code text
+char *DWARFManager_GetCULineSrc(size_t NumCU, size_t NumLine, size_t *Length)
+{
+	DWARFManager_LoadCUSrc(NumCU);
 
-			++NbCU;
-		}
-	} 
+	if (NumLine && (NumLine <= PtrCU[NumCU].NbLinesLoadSrc))
+	{
+		*Length = PtrCU[NumCU].PtrLinesLoadSrc[NumLine - 1].Length;
+		return PtrCU[NumCU].PtrLoadSrc + PtrCU[NumCU].PtrLinesLoadSrc[NumLine - 1].Offset;
+	}
+	else
+	{
+		*Length = 0;
+		return NULL;
+	}
 }
 
 
@@ -1398,7 +2467,7 @@ void DWARFManager_ConformSlachesBackslashes(char *Ptr)
 
 
 // Variables information initialisation
-void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
+void DWARFManager_InitInfosVariable(size_t NumCU, VariablesStruct *PtrVariables)
 {
 #ifdef DEBUG_VariableName
 	if (PtrVariables->PtrName && !strcmp(PtrVariables->PtrName, DEBUG_VariableName))
@@ -1407,11 +2476,11 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 		PtrVariables->PtrTypeName = (char *)calloc(1000, 1);
 		size_t TypeOffset = PtrVariables->TypeOffset;
 
-		for (size_t j = 0; j < PtrCU[NbCU].NbTypes; j++)
+		for (size_t j = 0; j < PtrCU[NumCU].NbTypes; j++)
 		{
-			if (TypeOffset == PtrCU[NbCU].PtrTypes[j].Offset)
+			if (TypeOffset == PtrCU[NumCU].PtrTypes[j].Offset)
 			{
-				switch (PtrCU[NbCU].PtrTypes[j].Tag)
+				switch (PtrCU[NumCU].PtrTypes[j].Tag)
 				{
 					// subroutine / function pointer
 				case DW_TAG_subroutine_type:
@@ -1422,15 +2491,15 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 					// structure & union type tag
 				case DW_TAG_structure_type:
 				case DW_TAG_union_type:
-					PtrVariables->TypeTag |= (PtrCU[NbCU].PtrTypes[j].Tag == DW_TAG_structure_type) ? TypeTag_structure : TypeTag_union;
+					PtrVariables->TypeTag |= (PtrCU[NumCU].PtrTypes[j].Tag == DW_TAG_structure_type) ? TypeTag_structure : TypeTag_union;
 					if (!(PtrVariables->TypeTag & TypeTag_typedef))
 					{
-						if (PtrCU[NbCU].PtrTypes[j].PtrName)
+						if (PtrCU[NumCU].PtrTypes[j].PtrName)
 						{
-							strcat(PtrVariables->PtrTypeName, PtrCU[NbCU].PtrTypes[j].PtrName);
+							strcat(PtrVariables->PtrTypeName, PtrCU[NumCU].PtrTypes[j].PtrName);
 						}
 					}
-					if ((TypeOffset = PtrCU[NbCU].PtrTypes[j].TypeOffset))
+					if ((TypeOffset = PtrCU[NumCU].PtrTypes[j].TypeOffset))
 					{
 						j = -1;
 					}
@@ -1444,16 +2513,16 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 						if (PtrVariables->Op)
 						{
 							// fill the structure members
-							PtrVariables->TabVariables = (VariablesStruct**)calloc(PtrCU[NbCU].PtrTypes[j].NbStructureMembers, sizeof(VariablesStruct*));
-							for (size_t i = 0; i < PtrCU[NbCU].PtrTypes[j].NbStructureMembers; i++)
+							PtrVariables->TabVariables = (VariablesStruct**)calloc(PtrCU[NumCU].PtrTypes[j].NbStructureMembers, sizeof(VariablesStruct*));
+							for (size_t i = 0; i < PtrCU[NumCU].PtrTypes[j].NbStructureMembers; i++)
 							{
-								//if (PtrVariables->PtrName != PtrCU[NbCU].PtrTypes[j].PtrStructureMembers[i].PtrName)
+								//if (PtrVariables->PtrName != PtrCU[NumCU].PtrTypes[j].PtrStructureMembers[i].PtrName)
 								{
 									PtrVariables->TabVariables[PtrVariables->NbTabVariables] = (VariablesStruct*)calloc(1, sizeof(VariablesStruct));
-									PtrVariables->TabVariables[PtrVariables->NbTabVariables]->PtrName = PtrCU[NbCU].PtrTypes[j].PtrStructureMembers[i].PtrName;
-									PtrVariables->TabVariables[PtrVariables->NbTabVariables]->TypeOffset = PtrCU[NbCU].PtrTypes[j].PtrStructureMembers[i].TypeOffset;
-									PtrVariables->TabVariables[PtrVariables->NbTabVariables]->Offset = (int)PtrCU[NbCU].PtrTypes[j].PtrStructureMembers[i].DataMemberLocation;
-									DWARFManager_InitInfosVariable(PtrVariables->TabVariables[PtrVariables->NbTabVariables++]);
+									PtrVariables->TabVariables[PtrVariables->NbTabVariables]->PtrName = PtrCU[NumCU].PtrTypes[j].PtrStructureMembers[i].PtrName;
+									PtrVariables->TabVariables[PtrVariables->NbTabVariables]->TypeOffset = PtrCU[NumCU].PtrTypes[j].PtrStructureMembers[i].TypeOffset;
+									PtrVariables->TabVariables[PtrVariables->NbTabVariables]->Offset = (int)PtrCU[NumCU].PtrTypes[j].PtrStructureMembers[i].DataMemberLocation;
+									DWARFManager_InitInfosVariable(NumCU, PtrVariables->TabVariables[PtrVariables->NbTabVariables++]);
 								}
 							}
 						}
@@ -1463,9 +2532,9 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 					// pointer type tag
 				case DW_TAG_pointer_type:
 					PtrVariables->TypeTag |= TypeTag_pointer;
-					PtrVariables->TypeByteSize = PtrCU[NbCU].PtrTypes[j].ByteSize;
+					PtrVariables->TypeByteSize = PtrCU[NumCU].PtrTypes[j].ByteSize;
 					PtrVariables->TypeEncoding = 0x10;
-					if (!(TypeOffset = PtrCU[NbCU].PtrTypes[j].TypeOffset))
+					if (!(TypeOffset = PtrCU[NumCU].PtrTypes[j].TypeOffset))
 					{
 						strcat(PtrVariables->PtrTypeName, "void* ");
 					}
@@ -1477,8 +2546,8 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 
 				case DW_TAG_enumeration_type:
 					PtrVariables->TypeTag |= TypeTag_enumeration_type;
-					PtrVariables->TypeByteSize = PtrCU[NbCU].PtrTypes[j].ByteSize;
-					if (!(PtrVariables->TypeEncoding = PtrCU[NbCU].PtrTypes[j].Encoding))
+					PtrVariables->TypeByteSize = PtrCU[NumCU].PtrTypes[j].ByteSize;
+					if (!(PtrVariables->TypeEncoding = PtrCU[NumCU].PtrTypes[j].Encoding))
 					{
 						// Try to determine the possible size
 						switch (PtrVariables->TypeByteSize)
@@ -1498,9 +2567,9 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 					if (!(PtrVariables->TypeTag & TypeTag_typedef))
 					{
 						PtrVariables->TypeTag |= TypeTag_typedef;
-						strcat(PtrVariables->PtrTypeName, PtrCU[NbCU].PtrTypes[j].PtrName);
+						strcat(PtrVariables->PtrTypeName, PtrCU[NumCU].PtrTypes[j].PtrName);
 					}
-					if ((TypeOffset = PtrCU[NbCU].PtrTypes[j].TypeOffset))
+					if ((TypeOffset = PtrCU[NumCU].PtrTypes[j].TypeOffset))
 					{
 						j = -1;
 					}
@@ -1514,7 +2583,7 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 					// Array type tag
 				case DW_TAG_array_type:
 					PtrVariables->TypeTag |= TypeTag_arraytype;
-					if ((TypeOffset = PtrCU[NbCU].PtrTypes[j].TypeOffset))
+					if ((TypeOffset = PtrCU[NumCU].PtrTypes[j].TypeOffset))
 					{
 						j = -1;
 					}
@@ -1524,7 +2593,7 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 				case DW_TAG_const_type:
 					PtrVariables->TypeTag |= TypeTag_consttype;
 					strcat(PtrVariables->PtrTypeName, "const ");
-					if ((TypeOffset = PtrCU[NbCU].PtrTypes[j].TypeOffset))
+					if ((TypeOffset = PtrCU[NumCU].PtrTypes[j].TypeOffset))
 					{
 						j = -1;
 					}
@@ -1534,7 +2603,7 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 				case DW_TAG_base_type:
 					if (!(PtrVariables->TypeTag & TypeTag_typedef))
 					{
-						strcat(PtrVariables->PtrTypeName, PtrCU[NbCU].PtrTypes[j].PtrName);
+						strcat(PtrVariables->PtrTypeName, PtrCU[NumCU].PtrTypes[j].PtrName);
 					}
 					if ((PtrVariables->TypeTag & TypeTag_pointer))
 					{
@@ -1542,8 +2611,8 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 					}
 					else
 					{
-						PtrVariables->TypeByteSize = PtrCU[NbCU].PtrTypes[j].ByteSize;
-						PtrVariables->TypeEncoding = PtrCU[NbCU].PtrTypes[j].Encoding;
+						PtrVariables->TypeByteSize = PtrCU[NumCU].PtrTypes[j].ByteSize;
+						PtrVariables->TypeEncoding = PtrCU[NumCU].PtrTypes[j].Encoding;
 					}
 					if ((PtrVariables->TypeTag & TypeTag_arraytype))
 					{
@@ -1564,16 +2633,19 @@ void DWARFManager_InitInfosVariable(VariablesStruct *PtrVariables)
 // Return NULL if no symbol name exists
 char *DWARFManager_GetSymbolnameFromAdr(size_t Adr)
 {
-	for (size_t i = 0; i < NbCU; i++)
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
+	AdrIndexEntryStruct *PtrEntry;
+
+	// the sub program's CU includes the address, so it is one of the segment's CU
+	if (PtrSegment)
 	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
+		for (size_t i = 0; i < PtrSegment->NbItems; i++)
 		{
-			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
+			AdrIndexItemStruct *PtrItem = &PtrAdrIndexItems[PtrSegment->FirstItem + i];
+
+			if ((PtrItem->SubProg == PtrCU[PtrItem->CU].NbSubProgs) && (PtrEntry = DWARFManager_GetAdrIndexEntry(PtrAdrIndexSubProgs, NbAdrIndexSubProgs, Adr, PtrItem->CU)))
 			{
-				if ((PtrCU[i].PtrSubProgs[j].StartPC == Adr))
-				{
-					return PtrCU[i].PtrSubProgs[j].PtrSubprogramName;
-				}
+				return PtrCU[PtrEntry->CU].PtrSubProgs[PtrEntry->Index].PtrSubprogramName;
 			}
 		}
 	}
@@ -1587,41 +2659,22 @@ char *DWARFManager_GetSymbolnameFromAdr(size_t Adr)
 // Return the existence status in Status if pointer not NULL
 char *DWARFManager_GetFullSourceFilenameFromAdr(size_t Adr, DWARFstatus *Status)
 {
-	for (size_t i = 0; i < NbCU; i++)
-	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
-		{
-			if (Status)
-			{
-				*Status = PtrCU[i].Status;
-			}
-
-			return PtrCU[i].PtrFullFilename;
-		}
-	}
-
-	return	NULL;
-}
-
-
-// Get text line source based on line number (starting from 1)
-// Return NULL if no text line exists or if line number is 0
-char *DWARFManager_GetLineSrcFromNumLine(char *PtrSrcFile, size_t NumLine)
-{
-	size_t i = 0;
-	char *PtrLineSrc = NULL;
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
 
-	if (PtrSrcFile)
+	// the first item is in the first CU including the address
+	if (PtrSegment)
 	{
-		while (i != NumLine)
+		size_t i = PtrAdrIndexItems[PtrSegment->FirstItem].CU;
+
+		if (Status)
 		{
-			PtrLineSrc = PtrSrcFile;
-			while (*PtrSrcFile++);
-			i++;
+			*Status = PtrCU[i].Status;
 		}
+
+		return PtrCU[i].PtrFullFilename;
 	}
 
-	return PtrLineSrc;
+	return	NULL;
 }
 
 
@@ -1632,24 +2685,18 @@ size_t DWARFManager_GetNbVariables(size_t Adr)
 	// check the address
 	if (Adr)
 	{
-		for (size_t i = 0; i < NbCU; i++)
+		SubProgStruct *PtrSubProg = DWARFManager_GetSubProgFromAdr(Adr);
+
+		if (PtrSubProg)
 		{
-			if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
-			{
-				for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
-				{
-					if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
-					{
-						return PtrCU[i].PtrSubProgs[j].NbVariables;
-					}
-				}
-			}
+			return PtrSubProg->NbVariables;
 		}
 	}
 	else
 	{
 		size_t NbVariables = 0;
 
+		DWARFManager_LoadAllCU();
 		for (size_t i = 0; i < NbCU; i++)
 		{
 			NbVariables += PtrCU[i].NbVariables;
@@ -1673,23 +2720,17 @@ void* DWARFManager_GetInfosVariable(size_t Adr, size_t Index)
 	if (Adr)
 	{
 		// get the pointer's information from a local variable
-		for (size_t i = 0; i < NbCU; i++)
+		SubProgStruct *PtrSubProg = DWARFManager_GetSubProgFromAdr(Adr);
+
+		if (PtrSubProg)
 		{
-			if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
-			{
-				for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
-				{
-					if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
-					{
-						return &PtrCU[i].PtrSubProgs[j].PtrVariables[Index - 1];
-					}
-				}
-			}
+			return &PtrSubProg->PtrVariables[Index - 1];
 		}
 	}
 	else
 	{
 		// get the pointer's information from a global variable
+		DWARFManager_LoadAllCU();
 		for (size_t i = 0; i < NbCU; i++)
 		{
 			if (PtrCU[i].NbVariables)
@@ -1714,6 +2755,8 @@ void* DWARFManager_GetInfosVariable(size_t Adr, size_t Index)
 // Return 0 if not found, or will return the first occurence found
 size_t DWARFManager_GetGlobalVariableAdrFromName(char *VariableName)
 {
+	DWARFManager_LoadAllCU();
+
 	for (size_t i = 0; i < NbCU; i++)
 	{
 		if (PtrCU[i].NbVariables)
@@ -2069,37 +3112,32 @@ char *DWARFManager_GetGlobalVariableName(size_t Index)
 // Get text line from source based on address and his tag
 // A tag can be either 0 or a DW_TAG_subprogram
 // DW_TAG_subprogram will look for the line pointing to the function
+// The text line is not finished with 0, its length is returned in Length
 // Return NULL if no text line has been found
-char *DWARFManager_GetLineSrcFromAdr(size_t Adr, size_t Tag)
+char *DWARFManager_GetLineSrcFromAdr(size_t Adr, size_t Tag, size_t *Length)
 {
-	for (size_t i = 0; i < NbCU; i++)
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
+	DMIStruct_LineSrc *PtrLineSrc;
+
+	if (PtrSegment)
 	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
+		for (size_t i = 0; i < PtrSegment->NbItems; i++)
 		{
-			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
+			AdrIndexItemStruct *PtrItem = &PtrAdrIndexItems[PtrSegment->FirstItem + i];
+
+			if (PtrItem->SubProg < PtrCU[PtrItem->CU].NbSubProgs)
 			{
-				if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
+				SubProgStruct *PtrSubProg = &PtrCU[PtrItem->CU].PtrSubProgs[PtrItem->SubProg];
+
+				if ((PtrSubProg->StartPC == Adr) && (!Tag || (Tag == DW_TAG_subprogram)))
 				{
-					if ((PtrCU[i].PtrSubProgs[j].StartPC == Adr) && (!Tag || (Tag == DW_TAG_subprogram)))
-					{
-						return PtrCU[i].PtrSubProgs[j].PtrLineSrc;
-					}
-					else
+					return DWARFManager_GetCULineSrc(PtrItem->CU, PtrSubProg->NumLineSrc, Length);
+				}
+				else
+				{
+					if ((PtrLineSrc = DWARFManager_GetSubProgLineSrc(PtrSubProg, Adr, Tag)))
 					{
-						for (size_t k = 0; k < PtrCU[i].PtrSubProgs[j].NbLinesSrc; k++)
-						{
-							if (PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].StartPC <= Adr)
-							{
-								if ((PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].StartPC == Adr) && (!Tag || (PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].Tag == Tag)))
-								{
-									return PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].PtrLineSrc;
-								}
-							}
-							else
-							{
-								return PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k - 1].PtrLineSrc;
-							}
-						}
+						return DWARFManager_GetCULineSrc(PtrItem->CU, PtrLineSrc->NumLineSrc, Length);
 					}
 				}
 			}
@@ -2116,50 +3154,38 @@ char *DWARFManager_GetLineSrcFromAdr(size_t Adr, size_t Tag)
 // Return 0 if no line number has been found
 size_t DWARFManager_GetNumLineFromAdr(size_t Adr, size_t Tag)
 {
-	for (size_t i = 0; i < NbCU; i++)
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
+	DMIStruct_LineSrc *PtrLineSrc;
+	AdrIndexEntryStruct *PtrEntry;
+
+	if (PtrSegment)
 	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
+		for (size_t i = 0; i < PtrSegment->NbItems; i++)
 		{
-			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
+			AdrIndexItemStruct *PtrItem = &PtrAdrIndexItems[PtrSegment->FirstItem + i];
+
+			if (PtrItem->SubProg < PtrCU[PtrItem->CU].NbSubProgs)
 			{
-				if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
+				SubProgStruct *PtrSubProg = &PtrCU[PtrItem->CU].PtrSubProgs[PtrItem->SubProg];
+
+				if ((PtrSubProg->StartPC == Adr) && (!Tag || (Tag == DW_TAG_subprogram)))
 				{
-					if ((PtrCU[i].PtrSubProgs[j].StartPC == Adr) && (!Tag || (Tag == DW_TAG_subprogram)))
-					{
-						return PtrCU[i].PtrSubProgs[j].NumLineSrc;
-					}
-					else
-					{
-						for (size_t k = 0; k < PtrCU[i].PtrSubProgs[j].NbLinesSrc; k++)
-						{
-							if (PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].StartPC <= Adr)
-							{
-								if ((PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].StartPC == Adr) && (!Tag || (PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].Tag == Tag)))
-								{
-									return PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc;
-								}
-							}
-							else
-							{
-								return PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k - 1].NumLineSrc;
-							}
-						}
-					}
-#if 0
-					if (!Tag || (Tag == DW_TAG_subprogram))
+					return PtrSubProg->NumLineSrc;
+				}
+				else
+				{
+					if ((PtrLineSrc = DWARFManager_GetSubProgLineSrc(PtrSubProg, Adr, Tag)))
 					{
-						return PtrCU[i].PtrSubProgs[j].NumLineSrc;
+						return PtrLineSrc->NumLineSrc;
 					}
-#endif
 				}
 			}
-
-			// Check if a used line is found with the address
-			for (size_t j = 0; j < PtrCU[i].NbUsedLinesSrc; j++)
+			else
 			{
-				if (PtrCU[i].PtrUsedLinesSrc[j].StartPC == Adr)
+				// Check if a used line is found with the address
+				if ((PtrEntry = DWARFManager_GetAdrIndexEntry(PtrAdrIndexUsedLines, NbAdrIndexUsedLines, Adr, PtrItem->CU)))
 				{
-					return PtrCU[i].PtrUsedLinesSrc[j].NumLineSrc;
+					return PtrCU[PtrEntry->CU].PtrUsedLinesSrc[PtrEntry->Index].NumLineSrc;
 				}
 			}
 		}
@@ -2173,27 +3199,31 @@ size_t DWARFManager_GetNumLineFromAdr(size_t Adr, size_t Tag)
 // Return NULL if no function name has been found, otherwise will return the function name in the range of the provided address
 char *DWARFManager_GetFunctionName(size_t Adr)
 {
-	for (size_t i = 0; i < NbCU; i++)
+	SubProgStruct *PtrSubProg = DWARFManager_GetSubProgFromAdr(Adr);
+
+	return PtrSubProg ? PtrSubProg->PtrSubprogramName : NULL;
+}
+
+
+// Load the CU from source index, and rebuild the address index if needed
+// Load then its source code
+void DWARFManager_LoadSrcFromIndex(size_t Index)
+{
+	if (DWARFManager_LoadCU(Index))
 	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
-		{
-			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
-			{
-				if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
-				{
-					return PtrCU[i].PtrSubProgs[j].PtrSubprogramName;
-				}
-			}
-		}
+		DWARFManager_CloseAdrIndex();
+		DWARFManager_InitAdrIndex();
 	}
 
-	return NULL;
+	DWARFManager_LoadCUSrc(Index);
 }
 
 
 // Get number of lines of texts source list from source index
 size_t DWARFManager_GetSrcNbListPtrFromIndex(size_t Index, bool Used)
 {
+	DWARFManager_LoadSrcFromIndex(Index);
+
 	if (!Used)
 	{
 		return PtrCU[Index].NbLinesLoadSrc;
@@ -2209,6 +3239,8 @@ size_t DWARFManager_GetSrcNbListPtrFromIndex(size_t Index, bool Used)
 // Return NULL for the text source used list 
 size_t *DWARFManager_GetSrcNumLinesPtrFromIndex(size_t Index, bool Used)
 {
+	DWARFManager_LoadSrcFromIndex(Index);
+
 	if (Used)
 	{
 		return	PtrCU[Index].PtrUsedNumLines;
@@ -2220,10 +3252,12 @@ size_t *DWARFManager_GetSrcNumLinesPtrFromIndex(size_t Index, bool Used)
 }
 
 
-// Get text source list pointers from source index
-// Return NULL for the text source used list 
-char **DWARFManager_GetSrcListPtrFromIndex(size_t Index, bool Used)
+// Get text source lines index from source index
+// The lines offsets are in the source code text (see DWARFManager_GetSrcTextPtrFromIndex)
+DWARFlinesrc *DWARFManager_GetSrcListPtrFromIndex(size_t Index, bool Used)
 {
+	DWARFManager_LoadSrcFromIndex(Index);
+
 	if (!Used)
 	{
 		return PtrCU[Index].PtrLinesLoadSrc;
@@ -2235,6 +3269,26 @@ char **DWARFManager_GetSrcListPtrFromIndex(size_t Index, bool Used)
 }
 
 
+// Get source code text pointer from source index
+// The text is valid until the source code text is reloaded (see DWARFManager_GetSrcNumLoadFromIndex)
+char *DWARFManager_GetSrcTextPtrFromIndex(size_t Index)
+{
+	DWARFManager_LoadSrcFromIndex(Index);
+
+	return PtrCU[Index].PtrLoadSrc;
+}
+
+
+// Get source code text load number from source index
+// The number changes each time the source code text is reloaded
+size_t DWARFManager_GetSrcNumLoadFromIndex(size_t Index)
+{
+	DWARFManager_LoadSrcFromIndex(Index);
+
+	return PtrCU[Index].NumLoadSrc;
+}
+
+
 // Get source language
 size_t DWARFManager_GetSrcLanguageFromIndex(size_t Index)
 {
@@ -2243,29 +3297,33 @@ size_t DWARFManager_GetSrcLanguageFromIndex(size_t Index)
 
 
 // Get text line from source based on address and num line (starting from 1)
+// The text line is not finished with 0, its length is returned in Length
 // Return NULL if no text line has been found
-char *DWARFManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine)
+char *DWARFManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine, size_t *Length)
 {
-	for (size_t i = 0; i < NbCU; i++)
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
+
+	if (PtrSegment)
 	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
+		for (size_t i = 0; i < PtrSegment->NbItems; i++)
 		{
-			for (size_t j = 0; j < PtrCU[i].NbSubProgs; j++)
+			AdrIndexItemStruct *PtrItem = &PtrAdrIndexItems[PtrSegment->FirstItem + i];
+
+			if (PtrItem->SubProg < PtrCU[PtrItem->CU].NbSubProgs)
 			{
-				if ((Adr >= PtrCU[i].PtrSubProgs[j].LowPC) && (Adr < PtrCU[i].PtrSubProgs[j].HighPC))
+				SubProgStruct *PtrSubProg = &PtrCU[PtrItem->CU].PtrSubProgs[PtrItem->SubProg];
+
+				if (PtrSubProg->NumLineSrc == NumLine)
 				{
-					if (PtrCU[i].PtrSubProgs[j].NumLineSrc == NumLine)
-					{
-						return PtrCU[i].PtrSubProgs[j].PtrLineSrc;
-					}
-					else
+					return DWARFManager_GetCULineSrc(PtrItem->CU, NumLine, Length);
+				}
+				else
+				{
+					for (size_t k = 0; k < PtrSubProg->NbLinesSrc; k++)
 					{
-						for (size_t k = 0; k < PtrCU[i].PtrSubProgs[j].NbLinesSrc; k++)
+						if (PtrSubProg->PtrLinesSrc[k].NumLineSrc == NumLine)
 						{
-							if (PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].NumLineSrc == NumLine)
-							{
-								return PtrCU[i].PtrSubProgs[j].PtrLinesSrc[k].PtrLineSrc;
-							}
+							return DWARFManager_GetCULineSrc(PtrItem->CU, NumLine, Length);
 						}
 					}
 				}
@@ -2278,22 +3336,16 @@ char *DWARFManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine)
 
 
 // Get text line pointer from source, based on address and line number (starting from 1)
+// The text line is not finished with 0, its length is returned in Length
 // Return NULL if no text line has been found, or if requested number line is above the source total number of lines
-char *DWARFManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine)
+char *DWARFManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine, size_t *Length)
 {
-	for (size_t i = 0; i < NbCU; i++)
+	AdrIndexSegmentStruct *PtrSegment = DWARFManager_GetAdrIndexSegment(Adr);
+
+	// the first item is in the first CU including the address
+	if (PtrSegment)
 	{
-		if ((Adr >= PtrCU[i].LowPC) && (Adr < PtrCU[i].HighPC))
-		{
-			if (NumLine <= PtrCU[i].NbLinesLoadSrc)
-			{
-				return PtrCU[i].PtrLinesLoadSrc[NumLine - 1];
-			}
-			else
-			{
-				return NULL;
-			}
-		}
+		return DWARFManager_GetCULineSrc(PtrAdrIndexItems[PtrSegment->FirstItem].CU, NumLine, Length);
 	}
 
 	return NULL;
@@ -14,11 +14,18 @@ typedef enum
 	DWARFSTATUS_UNKNOWN = 0xff
 }DWARFstatus;
 
+// Source code line, in the source code text; the line is not finished with 0
+typedef struct
+{
+	size_t Offset;			// Line's offset in the source code text
+	size_t Length;			// Line's length, without its new line code
+}DWARFlinesrc;
+
 // Internal manager
 extern bool	DWARFManager_Reset(void);
 extern bool	DWARFManager_Close(void);
 extern void	DWARFManager_Init(void);
-extern int DWARFManager_ElfInit(Elf *ElfPtr, struct stat FileElfInfo);
+extern int DWARFManager_ElfInit(Elf *ElfPtr, struct stat FileElfInfo, const char *PathElf);
 extern void DWARFManager_Set(size_t NbPathsInList, char **PtrListPaths);
 extern size_t DWARFManager_GetNbSources(void);
 
@@ -36,10 +43,12 @@ extern char	*DWARFManager_GetSymbolnameFromAdr(size_t Adr);
 
 // Source text lines manager
 extern size_t DWARFManager_GetNumLineFromAdr(size_t Adr, size_t Tag);
-extern char *DWARFManager_GetLineSrcFromAdr(size_t Adr, size_t Tag);
-extern char *DWARFManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine);
-extern char *DWARFManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine);
-extern char **DWARFManager_GetSrcListPtrFromIndex(size_t Index, bool Used);
+extern char *DWARFManager_GetLineSrcFromAdr(size_t Adr, size_t Tag, size_t *Length);
+extern char *DWARFManager_GetLineSrcFromAdrNumLine(size_t Adr, size_t NumLine, size_t *Length);
+extern char *DWARFManager_GetLineSrcFromNumLineBaseAdr(size_t Adr, size_t NumLine, size_t *Length);
+extern char *DWARFManager_GetSrcTextPtrFromIndex(size_t Index);
+extern size_t DWARFManager_GetSrcNumLoadFromIndex(size_t Index);
+extern DWARFlinesrc *DWARFManager_GetSrcListPtrFromIndex(size_t Index, bool Used);
 extern size_t DWARFManager_GetSrcNbListPtrFromIndex(size_t Index, bool Used);
 extern size_t *DWARFManager_GetSrcNumLinesPtrFromIndex(size_t Index, bool Used);
 
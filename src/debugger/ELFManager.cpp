@@ -19,6 +19,7 @@
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include "libelf.h"
 #include "gelf.h"
 #include "libdwarf.h"
@@ -44,6 +45,14 @@ typedef struct {
 	};
 }ELFTab;
 
+typedef struct {
+	size_t Adr;
+	size_t Size;
+	size_t Type;
+	size_t Index;						// Order in the symbol tables
+	char *SymbolName;
+}ELFSymbol;
+
 
 // Section type list
 ELFSectionType	ELFTabSectionType[] =	{
@@ -84,8 +93,20 @@ bool	ElfDwarf;
 size_t	NbELFtabStruct;
 ELFTab **ELFtab;
 
+// Symbols index, sorted by address, and names hash table (symbols index + 1, 0 if free)
+size_t NbELFSymbols;
+ELFSymbol *ELFSymbols;
+size_t ELFSymbolsHashSize;
+size_t *ELFSymbolsHash;
+
+// Functions index, the function symbols of the symbols index in the same order
+size_t NbELFFunctions;
+ELFSymbol **ELFFunctions;
+
 
 char *ELFManager_GetSymbolnameFromSymbolindex(size_t Index);
+size_t ELFManager_GetSymbolsHash(char *SymbolName);
+size_t ELFManager_GetSymbolsUpperBound(size_t Adr);
 
 
 // ELF section type detection
@@ -145,13 +166,16 @@ void	ELFManager_Init(void)
 	ELFtab = NULL;
 	ElfMem = NULL;
 	ElfDwarf = false;
+	NbELFSymbols = ELFSymbolsHashSize = 0;
+	ELFSymbols = NULL;
+	ELFSymbolsHash = NULL;
 }
 
 
 // ELF manager Dwarf Initialisation
-bool	ELFManager_DwarfInit(Elf *PtrElfMem, struct stat FileElfInfo)
+bool	ELFManager_DwarfInit(Elf *PtrElfMem, struct stat FileElfInfo, const char *PathElf)
 {
-	return (ElfDwarf = (DWARFManager_ElfInit(PtrElfMem, FileElfInfo) == DW_DLV_OK) ? true : false);
+	return (ElfDwarf = (DWARFManager_ElfInit(PtrElfMem, FileElfInfo, PathElf) == DW_DLV_OK) ? true : false);
 }
 
 
@@ -164,11 +188,7 @@ void	ELFManager_Reset(void)
 		ElfDwarf = false;
 	}
 
-	if (PtrExec != NULL)
-	{
-		free(PtrExec);
-		PtrExec = NULL;
-	}
+	ELFManager_SymbolsClose();
 
 	if (ELFtab != NULL)
 	{
@@ -182,6 +202,12 @@ void	ELFManager_Reset(void)
 	}
 
 	ELFManager_MemEnd();
+
+	if (PtrExec != NULL)
+	{
+		free(PtrExec);
+		PtrExec = NULL;
+	}
 }
 
 
@@ -224,14 +250,46 @@ bool ELFManager_AddTab(void *Ptr, size_t type)
 }
 
 
-// Get Address from his Symbol Name
-// Return 0 if Symbol name is not found
-size_t ELFManager_GetAdrFromSymbolName(char *SymbolName)
+// Symbols sort by address, then by order in the symbol tables
+static int ELFManager_CompareSymbols(const void *PtrA, const void *PtrB)
+{
+	const ELFSymbol *A = (const ELFSymbol *)PtrA, *B = (const ELFSymbol *)PtrB;
+
+	if (A->Adr != B->Adr)
+	{
+		return (A->Adr < B->Adr) ? -1 : 1;
+	}
+	else
+	{
+		return (A->Index < B->Index) ? -1 : (A->Index > B->Index);
+	}
+}
+
+
+// Symbol name hash (FNV-1a)
+size_t ELFManager_GetSymbolsHash(char *SymbolName)
+{
+	uint32_t Hash = 2166136261u;
+
+	while (*SymbolName)
+	{
+		Hash = (Hash ^ (uint8_t)*SymbolName++) * 16777619u;
+	}
+
+	return Hash & (ELFSymbolsHashSize - 1);
+}
+
+
+// Symbols index initialisation, once the symbol & string tables have been added
+// The index is sorted by address, and the names are hashed, so the look ups don't have to walk the symbol tables
+void	ELFManager_SymbolsInit(void)
 {
-	size_t Adr = 0;
 	GElf_Sym *PtrST, ST;
+	size_t NbSymbols = 0;
 
-	if (ELFtab && SymbolName)
+	ELFManager_SymbolsClose();
+
+	if (ELFtab != NULL)
 	{
 		for (size_t i = 0; i < NbELFtabStruct; i++)
 		{
@@ -239,84 +297,185 @@ size_t ELFManager_GetAdrFromSymbolName(char *SymbolName)
 			{
 				int j = 0;
 
-				while ((PtrST = gelf_getsym(ELFtab[i]->PtrDataTab, j++, &ST)) != NULL)
+				while (gelf_getsym(ELFtab[i]->PtrDataTab, j++, &ST) != NULL)
 				{
-					if (!strcmp(ELFManager_GetSymbolnameFromSymbolindex(PtrST->st_name), SymbolName))
-					{
-						Adr = PtrST->st_value;
-					}
+					NbSymbols++;
 				}
 			}
 		}
 	}
 
-	return Adr;
-}
+	if (!NbSymbols || ((ELFSymbols = (ELFSymbol *)calloc(NbSymbols, sizeof(ELFSymbol))) == NULL))
+	{
+		return;
+	}
 
+	for (size_t i = 0; i < NbELFtabStruct; i++)
+	{
+		if ((ELFtab[i]->Type == ELF_symtab_TYPE) && ((ELFtab[i]->PtrDataTab) != NULL))
+		{
+			int j = 0;
 
-// Get function name from his address
-// Return NULL if function name is not found
-char *ELFManager_GetFunctionName(size_t Adr)
-{
-	char *SymbolName = NULL;
-	GElf_Sym *PtrST, ST;
+			while ((NbELFSymbols < NbSymbols) && ((PtrST = gelf_getsym(ELFtab[i]->PtrDataTab, j++, &ST)) != NULL))
+			{
+#ifdef LOG_SUPPORT
+				WriteLog("ELF: .symtab: DATA: st_info=%0x, st_name=%0x, st_other=%0x, st_shndx=%0x, st_size=%0x, st_value=%0x\n", PtrST->st_info, PtrST->st_name, PtrST->st_other, PtrST->st_shndx, PtrST->st_size, PtrST->st_value);
+#endif
+				ELFSymbols[NbELFSymbols].Adr = PtrST->st_value;
+				ELFSymbols[NbELFSymbols].Size = PtrST->st_size;
+				ELFSymbols[NbELFSymbols].Type = ELF32_ST_TYPE(PtrST->st_info);
+				ELFSymbols[NbELFSymbols].Index = NbELFSymbols;
+				ELFSymbols[NbELFSymbols++].SymbolName = ELFManager_GetSymbolnameFromSymbolindex(PtrST->st_name);
+			}
+		}
+	}
 
-	if (ELFtab != NULL)
+	qsort(ELFSymbols, NbELFSymbols, sizeof(ELFSymbol), ELFManager_CompareSymbols);
+
+	// functions index
+	if ((ELFFunctions = (ELFSymbol **)calloc(NbELFSymbols, sizeof(ELFSymbol *))) != NULL)
 	{
-		for (size_t i = 0; i < NbELFtabStruct; i++)
+		for (size_t i = 0; i < NbELFSymbols; i++)
 		{
-			if ((ELFtab[i]->Type == ELF_symtab_TYPE) && ((ELFtab[i]->PtrDataTab) != NULL))
+			if (ELFSymbols[i].Type == STT_FUNC)
 			{
-				int j = 0;
+				ELFFunctions[NbELFFunctions++] = &ELFSymbols[i];
+			}
+		}
+	}
+
+	// names hash table, with at least twice as many slots as symbols
+	for (ELFSymbolsHashSize = 16; ELFSymbolsHashSize < (NbELFSymbols * 2); ELFSymbolsHashSize *= 2);
+	if ((ELFSymbolsHash = (size_t *)calloc(ELFSymbolsHashSize, sizeof(size_t))) != NULL)
+	{
+		for (size_t i = 0; i < NbELFSymbols; i++)
+		{
+			if (ELFSymbols[i].SymbolName)
+			{
+				size_t j = ELFManager_GetSymbolsHash(ELFSymbols[i].SymbolName);
+
+				// a name found several times keeps the last symbol in the symbol tables
+				while (ELFSymbolsHash[j] && strcmp(ELFSymbols[ELFSymbolsHash[j] - 1].SymbolName, ELFSymbols[i].SymbolName))
+				{
+					j = (j + 1) & (ELFSymbolsHashSize - 1);
+				}
 
-				while ((PtrST = gelf_getsym(ELFtab[i]->PtrDataTab, j++, &ST)) != NULL)
+				if (!ELFSymbolsHash[j] || (ELFSymbols[ELFSymbolsHash[j] - 1].Index < ELFSymbols[i].Index))
 				{
-					if (PtrST->st_value == Adr)
-					{
-						if (ELF32_ST_TYPE(PtrST->st_info) == STT_FUNC)
-						{
-							SymbolName = ELFManager_GetSymbolnameFromSymbolindex(PtrST->st_name);
-						}
-					}
+					ELFSymbolsHash[j] = i + 1;
 				}
 			}
 		}
 	}
+	else
+	{
+		ELFSymbolsHashSize = 0;
+	}
+}
 
-	return SymbolName;
+
+// Symbols index close
+void	ELFManager_SymbolsClose(void)
+{
+	free(ELFFunctions);
+	free(ELFSymbolsHash);
+	free(ELFSymbols);
+	ELFFunctions = NULL;
+	ELFSymbolsHash = NULL;
+	ELFSymbols = NULL;
+	NbELFSymbols = ELFSymbolsHashSize = NbELFFunctions = 0;
 }
 
 
-// Get Symbol name from his address
-// Return NULL if Symbol name is not found
-char *ELFManager_GetSymbolnameFromAdr(size_t Adr)
+// Get the index of the first symbol above the address
+size_t ELFManager_GetSymbolsUpperBound(size_t Adr)
 {
-	char *SymbolName = NULL;
-	GElf_Sym *PtrST, ST;
+	return std::upper_bound(ELFSymbols, (ELFSymbols + NbELFSymbols), Adr, [](size_t Adr, const ELFSymbol &Symbol) { return Adr < Symbol.Adr; }) - ELFSymbols;
+}
 
-	if (ELFtab != NULL)
+
+// Get Address from his Symbol Name
+// Return 0 if Symbol name is not found
+size_t ELFManager_GetAdrFromSymbolName(char *SymbolName)
+{
+	if (ELFSymbolsHash && SymbolName)
 	{
-		for (size_t i = 0; i < NbELFtabStruct; i++)
+		size_t i = ELFManager_GetSymbolsHash(SymbolName);
+
+		while (ELFSymbolsHash[i])
 		{
-			if ((ELFtab[i]->Type == ELF_symtab_TYPE) && ((ELFtab[i]->PtrDataTab) != NULL))
+			if (!strcmp(ELFSymbols[ELFSymbolsHash[i] - 1].SymbolName, SymbolName))
 			{
-				int j = 0;
-
-				while ((PtrST = gelf_getsym(ELFtab[i]->PtrDataTab, j++, &ST)) != NULL)
-				{
-					if (PtrST->st_value == Adr)
-					{
-#ifdef LOG_SUPPORT
-						WriteLog("ELF: .symtab: DATA: st_info=%0x, st_name=%0x, st_other=%0x, st_shndx=%0x, st_size=%0x, st_value=%0x\n", PtrST->st_info, PtrST->st_name, PtrST->st_other, PtrST->st_shndx, PtrST->st_size, PtrST->st_value);
-#endif
-						SymbolName = ELFManager_GetSymbolnameFromSymbolindex(PtrST->st_name);
-					}
-				}
+				return ELFSymbols[ELFSymbolsHash[i] - 1].Adr;
 			}
+
+			i = (i + 1) & (ELFSymbolsHashSize - 1);
+		}
+	}
+
+	return 0;
+}
+
+
+// Get function name from his address
+// Return NULL if function name is not found
+char *ELFManager_GetFunctionName(size_t Adr)
+{
+	// the last function symbol at the address, in the symbol tables order
+	for (size_t i = ELFManager_GetSymbolsUpperBound(Adr); i && (ELFSymbols[i - 1].Adr == Adr); i--)
+	{
+		if (ELFSymbols[i - 1].Type == STT_FUNC)
+		{
+			return ELFSymbols[i - 1].SymbolName;
 		}
 	}
 
-	return SymbolName;
+	return NULL;
+}
+
+
+// Get function name from an address inside the function, and the address offset in the function
+// The function is the nearest one starting at, or before, the address; its size is checked if known
+// Return NULL if function name is not found
+char *ELFManager_GetFunctionNameFromAdr(size_t Adr, size_t *Offset)
+{
+	// the last function symbol at, or before, the address, in the functions index
+	ELFSymbol **PtrFunction = std::upper_bound(ELFFunctions, (ELFFunctions + NbELFFunctions), Adr, [](size_t Adr, const ELFSymbol *Symbol) { return Adr < Symbol->Adr; });
+
+	if (PtrFunction != ELFFunctions)
+	{
+		ELFSymbol *Function = *(PtrFunction - 1);
+
+		if (Function->Size && (Adr >= (Function->Adr + Function->Size)))
+		{
+			return NULL;
+		}
+
+		if (Offset)
+		{
+			*Offset = Adr - Function->Adr;
+		}
+
+		return Function->SymbolName;
+	}
+
+	return NULL;
+}
+
+
+// Get Symbol name from his address
+// Return NULL if Symbol name is not found
+char *ELFManager_GetSymbolnameFromAdr(size_t Adr)
+{
+	// the last symbol at the address, in the symbol tables order
+	size_t i = ELFManager_GetSymbolsUpperBound(Adr);
+
+	if (i && (ELFSymbols[i - 1].Adr == Adr))
+	{
+		return ELFSymbols[i - 1].SymbolName;
+	}
+
+	return NULL;
 }
 
 
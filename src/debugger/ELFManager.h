@@ -35,7 +35,7 @@ typedef enum {
 
 // Internal manager
 extern void	ELFManager_Init(void);
-extern bool	ELFManager_DwarfInit(Elf *PtrElfMem, struct stat FileElfInfo);
+extern bool	ELFManager_DwarfInit(Elf *PtrElfMem, struct stat FileElfInfo, const char *PathElf);
 extern Elf *ELFManager_MemOpen(char *PtrELFExe, size_t Size);
 extern int	ELFManager_MemEnd(void);
 extern void	ELFManager_Reset(void);
@@ -47,11 +47,14 @@ extern void	*ELFManager_ExeCopy(void *src, size_t size);
 extern size_t ELFManager_GetSectionType(char *SectionName);
 
 // Symbols manager
+extern void	ELFManager_SymbolsInit(void);
+extern void	ELFManager_SymbolsClose(void);
 extern size_t ELFManager_GetAdrFromSymbolName(char *SymbolName);
 extern char *ELFManager_GetSymbolnameFromAdr(size_t Adr);
 
 // Functions manager
 extern char *ELFManager_GetFunctionName(size_t Adr);
+extern char *ELFManager_GetFunctionNameFromAdr(size_t Adr, size_t *Offset);
 
 
 #endif	// __ELFMANAGER_H__
@@ -190,20 +190,63 @@ HWLABELTab	HWLABELTabSectionType[] =	{
 //	{	(size_t)-1, NULL, NULL, HWLABEL_NO_SIZE, HWLABEL_NO_ACCESS }
 };
 
+// HW labels sorted by address, then by order in the memory map list
+HWLABELTab *HWLABELTabSorted[NBHWLABELS];
+
+
+// HW labels sort
+static int HWLABELManager_Compare(const void *PtrA, const void *PtrB)
+{
+	const HWLABELTab *A = *(const HWLABELTab **)PtrA, *B = *(const HWLABELTab **)PtrB;
+
+	if (A->HWLABELAdr != B->HWLABELAdr)
+	{
+		return (A->HWLABELAdr < B->HWLABELAdr) ? -1 : 1;
+	}
+	else
+	{
+		return (A < B) ? -1 : (A > B);
+	}
+}
+
+
+// HW labels initialisation
+void HWLABELManager_Init(void)
+{
+	for (size_t i = 0; i < NBHWLABELS; i++)
+	{
+		HWLABELTabSorted[i] = &HWLABELTabSectionType[i];
+	}
+
+	qsort(HWLABELTabSorted, NBHWLABELS, sizeof(HWLABELTab *), HWLABELManager_Compare);
+}
+
 
 // Get Symbol name from his address
 char *HWLABELManager_GetSymbolnameFromAdr(size_t Adr)
 {
-	size_t i;
+	size_t Low = 0, High = NBHWLABELS;
 
-	if ((Adr >= 0xF00000) && (Adr < 0xF1A124))
+	if ((Adr >= 0xF00000) && (Adr < 0xF1A124) && HWLABELTabSorted[0])
 	{
-		for (i = 0; i < NBHWLABELS; i++)
+		// look for the first label at the address
+		while (Low < High)
 		{
-			if ((HWLABELTabSectionType[i].HWLABELAdr == Adr))
+			size_t Mid = (Low + High) / 2;
+
+			if (HWLABELTabSorted[Mid]->HWLABELAdr < Adr)
 			{
-				return (char *)HWLABELTabSectionType[i].HWLABELSymbolName;
+				Low = Mid + 1;
 			}
+			else
+			{
+				High = Mid;
+			}
+		}
+
+		if ((Low < NBHWLABELS) && (HWLABELTabSorted[Low]->HWLABELAdr == Adr))
+		{
+			return (char *)HWLABELTabSorted[Low]->HWLABELSymbolName;
 		}
 	}
 
@@ -4,6 +4,7 @@
 #define __HWLABELMANAGER_H__
 
 
+extern	void HWLABELManager_Init(void);
 extern	char *HWLABELManager_GetSymbolnameFromAdr(size_t Adr);
 
 
@@ -113,7 +113,6 @@ void NewFnctBreakpointWindow::AddBreakpointAddress(void)
 			Brk.Name = DBGManager_GetSymbolNameFromAdr(adr);
 			Brk.Filename = DBGManager_GetFullSourceFilenameFromAdr(adr, NULL);
 			Brk.NumLine = DBGManager_GetNumLineFromAdr(adr, DBG_TAG_subprogram);
-			Brk.LineSrc = DBGManager_GetLineSrcFromAdrNumLine(adr, Brk.NumLine);
 
 			// In all cases, consider address as valid
 			Brk.Adr = adr;
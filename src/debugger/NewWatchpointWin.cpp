@@ -0,0 +1,197 @@
+//
+// NewWatchpointWin.cpp: New watchpoint
+//
+
+// Sets a watchpoint on an address range: the accesses to watch (read, write
+// or value change) and optionally the bus masters doing them.
+
+#include "debugger/NewWatchpointWin.h"
+#include "jaguar.h"
+#include "memory.h"
+#include "debugger/DBGManager.h"
+#include "settings.h"
+
+
+//
+NewWatchpointWindow::NewWatchpointWindow(QWidget * parent/*= 0*/): QWidget(parent, Qt::Dialog),
+layout(new QVBoxLayout),
+address(new QLineEdit),
+size(new QLineEdit),
+read(new QCheckBox(tr("Read"))),
+write(new QCheckBox(tr("Write"))),
+change(new QCheckBox(tr("Change"))),
+m68k(new QCheckBox(tr("M68K"))),
+gpu(new QCheckBox(tr("GPU"))),
+dsp(new QCheckBox(tr("DSP"))),
+blitter(new QCheckBox(tr("Blitter"))),
+op(new QCheckBox(tr("OP"))),
+add(new QPushButton(tr("Add"))),
+types(new QGroupBox(tr("Accesses"))),
+BPWin(NULL)
+{
+	setWindowTitle(tr("New watchpoint"));
+
+	address->setPlaceholderText("0x<value>, decimal value, symbol or variable name");
+	size->setPlaceholderText("Size in bytes");
+	size->setText("1");
+	write->setChecked(true);
+
+	QHBoxLayout * hbox1 = new QHBoxLayout;
+	hbox1->addWidget(address);
+	hbox1->addWidget(size);
+	hbox1->addWidget(add);
+
+	// Accesses types
+	QHBoxLayout * hbox2 = new QHBoxLayout;
+	hbox2->addWidget(read);
+	hbox2->addWidget(write);
+	hbox2->addWidget(change);
+	types->setLayout(hbox2);
+
+	// Bus masters, none of them checked means all of them
+	QHBoxLayout * hbox3 = new QHBoxLayout;
+	hbox3->addWidget(m68k);
+	hbox3->addWidget(gpu);
+	hbox3->addWidget(dsp);
+	hbox3->addWidget(blitter);
+	hbox3->addWidget(op);
+	QGroupBox * masters = new QGroupBox(tr("Bus masters (none for all)"));
+	masters->setLayout(hbox3);
+
+	layout->addLayout(hbox1);
+	layout->addWidget(types);
+	layout->addWidget(masters);
+	setLayout(layout);
+
+	connect(add, SIGNAL(clicked()), this, SLOT(AddWatchpoint()));
+	connect(address, SIGNAL(cursorPositionChanged(int, int)), this, SLOT(SelectWatchpointAddress()));
+	connect(size, SIGNAL(cursorPositionChanged(int, int)), this, SLOT(SelectWatchpointAddress()));
+	connect(read, SIGNAL(clicked()), this, SLOT(SelectWatchpointAddress()));
+	connect(write, SIGNAL(clicked()), this, SLOT(SelectWatchpointAddress()));
+	connect(change, SIGNAL(clicked()), this, SLOT(SelectWatchpointAddress()));
+}
+
+
+//
+void NewWatchpointWindow::keyPressEvent(QKeyEvent * e)
+{
+	if (e->key() == Qt::Key_Escape)
+	{
+		hide();
+	}
+	else
+	{
+		if (e->key() == Qt::Key_Return)
+		{
+			AddWatchpoint();
+		}
+	}
+}
+
+
+//
+void NewWatchpointWindow::SetWatchpointWin(BreakpointsWindow* BpW)
+{
+	BPWin = BpW;
+}
+
+
+void NewWatchpointWindow::SelectWatchpointAddress(void)
+{
+	address->setStyleSheet("color: black");
+	size->setStyleSheet("color: black");
+	types->setStyleSheet("color: black");
+}
+
+
+// Get a value from an edit field
+// Value can be an hexa, decimal, a symbol or a global variable name
+bool NewWatchpointWindow::GetAddress(QLineEdit *edit, size_t &adr)
+{
+	bool ok = false;
+	QString text = edit->text();
+
+	if (text.size() > 1 && (text.at(0) == QChar('0')) && (text.at(1) == QChar('x')))
+	{
+		adr = text.toUInt(&ok, 16);
+	}
+	else
+	{
+		if (text.size() && ((adr = DBGManager_GetAdrFromSymbolName(text.toLatin1().data())) || (adr = DBGManager_GetGlobalVariableAdrFromName(text.toLatin1().data()))))
+		{
+			ok = true;
+		}
+		else
+		{
+			adr = text.toUInt(&ok, 10);
+		}
+	}
+
+	return ok;
+}
+
+
+// Add a watchpoint on an addresses range
+void NewWatchpointWindow::AddWatchpoint(void)
+{
+	size_t adr, len;
+	S_WatchInfo Watch;
+
+	memset(&Watch, 0, sizeof(Watch));
+
+	if (address->text().size())
+	{
+		// Check validity address
+		if (GetAddress(address, adr) && (adr <= 0xffffff))
+		{
+			// Check validity size
+			if (GetAddress(size, len) && len && ((adr + len - 1) <= 0xffffff))
+			{
+				Watch.Start = (uint32_t)adr;
+				Watch.End = (uint32_t)(adr + len - 1);
+				Watch.Type = (read->isChecked() ? WATCH_READ : 0) | (write->isChecked() ? WATCH_WRITE : 0) | (change->isChecked() ? WATCH_CHANGE : 0);
+				Watch.WhoMask = (m68k->isChecked() ? (1 << M68K) : 0) | (gpu->isChecked() ? (1 << GPU) : 0) | (dsp->isChecked() ? (1 << DSP) : 0) | (blitter->isChecked() ? (1 << BLITTER) : 0) | (op->isChecked() ? (1 << OP) : 0);
+
+				// Add the watchpoint, an access type is required
+				if (Watch.Type)
+				{
+					if (!watch_add(&Watch))
+					{
+						address->setStyleSheet("color: green");
+					}
+					else
+					{
+						address->setText("");
+					}
+				}
+				else
+				{
+					// No access type
+					types->setStyleSheet("color: red");
+				}
+			}
+			else
+			{
+				// Size is not valid
+				size->setStyleSheet("color: red");
+			}
+		}
+		else
+		{
+			// Address is not valid
+			address->setStyleSheet("color: red");
+		}
+
+		// update the breakpoints window
+		if (BPWin)
+		{
+			BPWin->RefreshContents();
+		}
+	}
+}
+
+
+//
+NewWatchpointWindow::~NewWatchpointWindow()
+{
+}
@@ -0,0 +1,48 @@
+//
+// NewWatchpointWin.h: Header file
+//
+
+#ifndef __NEWWATCHPOINTWIN_H__
+#define __NEWWATCHPOINTWIN_H__
+
+#include <QtWidgets/QtWidgets>
+#include <stdint.h>
+#include "debugger/BreakpointsWin.h"
+
+class NewWatchpointWindow: public QWidget
+{
+	Q_OBJECT
+
+	public:
+		NewWatchpointWindow(QWidget * parent = 0);
+		void SetWatchpointWin(BreakpointsWindow* BpW);
+		~NewWatchpointWindow();
+
+	public slots:
+
+	protected:
+		void keyPressEvent(QKeyEvent *);
+		bool GetAddress(QLineEdit *edit, size_t &adr);
+
+	protected slots:
+		void AddWatchpoint(void);
+		void SelectWatchpointAddress(void);
+
+	private:
+		QVBoxLayout *layout;
+		QLineEdit *address;
+		QLineEdit *size;
+		QCheckBox *read;
+		QCheckBox *write;
+		QCheckBox *change;
+		QCheckBox *m68k;
+		QCheckBox *gpu;
+		QCheckBox *dsp;
+		QCheckBox *blitter;
+		QCheckBox *op;
+		QPushButton *add;
+		QGroupBox *types;
+		BreakpointsWindow* BPWin;
+};
+
+#endif	// __NEWWATCHPOINTWIN_H__
@@ -114,7 +114,7 @@ void SourceCWindow::RefreshContents(void)
 
 
 // Fill the tab with the source text
-void SourceCWindow::FillTab(size_t index, char **TextLines, size_t NbLines[], size_t *NumLinesUsed)
+void SourceCWindow::FillTab(size_t index, char *Text, DBGlinesrc *TextLines, size_t NbLines[], size_t *NumLinesUsed)
 {
 	int i, j, k;
 #ifdef SC_LAYOUTTEXTS
@@ -128,11 +128,13 @@ void SourceCWindow::FillTab(size_t index, char **TextLines, size_t NbLines[], si
 	{
 		NbLinesText[i] = NbLines[i];
 	}
+	PtrText = Text;
 	PtrTextLines = TextLines;
 	PtrNumLinesUsed = NumLinesUsed;
 
-	// Set columns
+	// Set columns, without the lines from a previous fill
 #ifndef SC_LAYOUTTEXTS
+	model->removeRows(0, model->rowCount());
 	model->insertRow((int)NbLinesText[0]);
 #endif
 
@@ -156,7 +158,7 @@ void SourceCWindow::FillTab(size_t index, char **TextLines, size_t NbLines[], si
 #endif
 		// display source code line
 #ifndef SC_LAYOUTTEXTS
-		model->setItem(i, 2, new QStandardItem(QString("%1").arg(PtrTextLines[i])));
+		model->setItem(i, 2, new QStandardItem(QString::fromUtf8((PtrText + PtrTextLines[i].Offset), (int)PtrTextLines[i].Length)));
 		model->item(i, 2)->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
 #endif
 		// Check line used by code
@@ -165,7 +167,7 @@ void SourceCWindow::FillTab(size_t index, char **TextLines, size_t NbLines[], si
 		{
 			// Line is used by code
 #ifdef SC_LAYOUTTEXTS
-			sprintf(string, "<font color='#000000'><b>%s</b></font>", PtrTextLines[i]);
+			sprintf(string, "<font color='#000000'><b>%.*s</b></font>", (int)PtrTextLines[i].Length, (PtrText + PtrTextLines[i].Offset));
 #else
 			model->item(i, 2)->setForeground(QColor(0, 0, 0));
 #endif
@@ -174,7 +176,7 @@ void SourceCWindow::FillTab(size_t index, char **TextLines, size_t NbLines[], si
 		{
 			// Line is not used by code (such as comments)
 #ifdef SC_LAYOUTTEXTS
-			sprintf(string, "<font color='#C8C8C8'>%s</font>", PtrTextLines[i]);
+			sprintf(string, "<font color='#C8C8C8'>%.*s</font>", (int)PtrTextLines[i].Length, (PtrText + PtrTextLines[i].Offset));
 #else
 			model->item(i, 2)->setForeground(QColor(0xc8, 0xc8, 0xc8));
 #endif
@@ -15,6 +15,7 @@
 
 #include <QtWidgets/QtWidgets>
 //#include <stdint.h>
+#include "DBGManager.h"
 
 
 class SourceCWindow : public QWidget
@@ -23,7 +24,7 @@ class SourceCWindow : public QWidget
 
 public:
 	SourceCWindow(QWidget * parent = 0);
-	void FillTab(size_t index, char **TextLines, size_t NbLines[], size_t *NumLinesUsed);
+	void FillTab(size_t index, char *Text, DBGlinesrc *TextLines, size_t NbLines[], size_t *NumLinesUsed);
 	void SetCursorTrace(int NumLineSrc, bool Remove);
 
 public slots:
@@ -41,7 +42,8 @@ private:
 	QTableView *TableView;
 	QStandardItemModel *model;
 #endif
-	char **PtrTextLines;
+	char *PtrText;
+	DBGlinesrc *PtrTextLines;
 	size_t NbLinesText[2];
 	size_t *PtrNumLinesUsed;
 };
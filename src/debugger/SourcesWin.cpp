@@ -73,9 +73,10 @@ void SourcesWindow::SelectTab(const int)
 
 // Sources initialisation
 // Prepare tabs for every available source code file
+// The source code texts are requested when their tab is opened
 void SourcesWindow::Init(void)
 {
-	size_t i, j;
+	size_t i;
 	char *Ptr, *Ptr1;
 
 	// get number of sources
@@ -93,13 +94,6 @@ void SourcesWindow::Init(void)
 			Ptr1 = sourcesinfostab[i].Filename = (char *)malloc(strlen(Ptr) + 1);
 			while (((*Ptr == '.') || ((*Ptr == '/') || (*Ptr == '\\'))) && Ptr++);
 			strcpy(Ptr1, Ptr);
-			// get texts dedicated information
-			for (j = 0; j < 2; j++)
-			{
-				sourcesinfostab[i].NbLinesText[j] = DBGManager_GetSrcNbListPtrFromIndex(i, j);
-			}
-			sourcesinfostab[i].NumLinesUsed = DBGManager_GetSrcNumLinesPtrFromIndex(i, true);
-			sourcesinfostab[i].SourceText = DBGManager_GetSrcListPtrFromIndex(i, false);
 			// get remaining information
 			sourcesinfostab[i].Language = DBGManager_GetSrcLanguageFromIndex(i);
 			sourcesinfostab[i].IndexTab = -1;
@@ -190,7 +184,15 @@ void SourcesWindow::RefreshContents(void)
 						if (sourcesinfostab[i].IndexTab == -1)
 						{
 							sourcesinfostab[i].IndexTab = index = sourcestabWidget->addTab(sourcesinfostab[i].sourceCtab = new(SourceCWindow), tr(sourcesinfostab[i].Filename));
-							sourcesinfostab[i].sourceCtab->FillTab(i, sourcesinfostab[i].SourceText, sourcesinfostab[i].NbLinesText, sourcesinfostab[i].NumLinesUsed);
+							FillSourceTab(i);
+						}
+						else
+						{
+							// fill again the tab if the source code has been reloaded
+							if (DBGManager_GetSrcNumLoadFromIndex(i) != sourcesinfostab[i].NumLoadSrc)
+							{
+								FillSourceTab(i);
+							}
 						}
 
 						sourcestabWidget->setCurrentIndex(sourcesinfostab[i].IndexTab);
@@ -216,6 +218,21 @@ void SourcesWindow::RefreshContents(void)
 }
 
 
+// Fill a tab with the source code texts
+void SourcesWindow::FillSourceTab(size_t Index)
+{
+	// get texts dedicated information
+	sourcesinfostab[Index].SourceText = DBGManager_GetSrcTextPtrFromIndex(Index);
+	sourcesinfostab[Index].NumLoadSrc = DBGManager_GetSrcNumLoadFromIndex(Index);
+	for (size_t j = 0; j < 2; j++)
+	{
+		sourcesinfostab[Index].NbLinesText[j] = DBGManager_GetSrcNbListPtrFromIndex(Index, j);
+	}
+	sourcesinfostab[Index].NumLinesUsed = DBGManager_GetSrcNumLinesPtrFromIndex(Index, true);
+	sourcesinfostab[Index].sourceCtab->FillTab(Index, sourcesinfostab[Index].SourceText, DBGManager_GetSrcListPtrFromIndex(Index, false), sourcesinfostab[Index].NbLinesText, sourcesinfostab[Index].NumLinesUsed);
+}
+
+
 // Close / Remove current tab
 void SourcesWindow::CloseCurrentTab(void)
 {
@@ -24,7 +24,8 @@ class SourcesWindow : public QWidget
 	{
 		int IndexTab;
 		char *Filename;
-		char **SourceText;
+		char *SourceText;
+		size_t NumLoadSrc;
 		size_t NbLinesText[2];
 		size_t *NumLinesUsed;
 		size_t Language;
@@ -49,6 +50,7 @@ public slots:
 protected:
 	void keyPressEvent(QKeyEvent * e);
 	void CloseCurrentTab(void);
+	void FillSourceTab(size_t Index);
 
 private:
 	QVBoxLayout *layout;
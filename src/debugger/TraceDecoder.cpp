@@ -0,0 +1,122 @@
+//
+// TraceDecoder.cpp: Execution trace decoder
+//
+
+// Turns a binary trace (see trace.cpp) into text: each instruction is
+// disassembled from the words kept in its record, so the memory may have
+// changed since, and the symbols come from the debug information currently
+// loaded. The registers changed by an instruction are listed below it.
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "jagdasm.h"
+#include "log.h"
+#include "trace.h"
+#include "m68000/m68kinterface.h"
+#include "DBGManager.h"
+#include "TraceDecoder.h"
+
+
+#define TRACEDECODER_BATCH	0x1000				// Records read at once
+
+
+static const char *M68KRegisterName[] = { "D0", "D1", "D2", "D3", "D4", "D5", "D6", "D7", "A0", "A1", "A2", "A3", "A4", "A5", "A6", "A7", "PC", "SR" };
+
+
+// Decode the trace file into the text file
+// Return false if the trace cannot be read, or the text cannot be written
+bool TraceDecoder_Decode(const char *TraceFilename, const char *TextFilename)
+{
+	FILE *In, *Out;
+	TraceHeader Header;
+	TraceRecord *Records;
+	char Dasm[256], Reg[8];
+	char *Function, *PrevFunction[TRACE_MAX] = { NULL, NULL, NULL };
+	uint64_t Left;
+
+	if (!(In = fopen(TraceFilename, "rb")))
+	{
+		return false;
+	}
+
+	if ((fread(&Header, sizeof(Header), 1, In) != 1) || strcmp(Header.magic, TRACE_MAGIC) || (Header.version != TRACE_VERSION) || (Header.recordSize != sizeof(TraceRecord)))
+	{
+		WriteLog("TRACE: %s is not a trace file of this version\n", TraceFilename);
+		fclose(In);
+		return false;
+	}
+
+	if (!(Out = fopen(TextFilename, "w")))
+	{
+		fclose(In);
+		return false;
+	}
+
+	Records = new TraceRecord[TRACEDECODER_BATCH];
+	fprintf(Out, "; %llu records from %s\n", (unsigned long long)Header.records, TraceFilename);
+
+	for (Left = Header.records; Left; )
+	{
+		size_t Nb = fread(Records, sizeof(TraceRecord), (Left < TRACEDECODER_BATCH ? (size_t)Left : TRACEDECODER_BATCH), In);
+
+		if (!Nb)
+		{
+			fprintf(Out, "; trace file is truncated\n");
+			break;
+		}
+
+		Left -= Nb;
+
+		for (size_t i = 0; i < Nb; i++)
+		{
+			TraceRecord *Record = &Records[i];
+			const char *Unit = (Record->unit < TRACE_MAX) ? traceUnitName[Record->unit] : "????";
+
+			if (Record->type == TRACE_REGISTER)
+			{
+				if (Record->unit == TRACE_M68K)
+				{
+					sprintf(Reg, "%s", (Record->reg <= M68K_REG_SR) ? M68KRegisterName[Record->reg] : "??");
+				}
+				else
+				{
+					sprintf(Reg, "R%02u", Record->reg);
+				}
+
+				fprintf(Out, "%20s %-5s         %s=%08X\n", "", Unit, Reg, Record->pc);
+				continue;
+			}
+
+			if (Record->unit >= TRACE_MAX)
+			{
+				continue;
+			}
+
+			// Function entered, and symbol at this address
+			if ((Function = DBGManager_GetFunctionName(Record->pc)) && (Function != PrevFunction[Record->unit]))
+			{
+				fprintf(Out, "%20s %-5s <%s>\n", "", Unit, Function);
+			}
+
+			PrevFunction[Record->unit] = Function;
+
+			if (Record->unit == TRACE_M68K)
+			{
+				m68k_disassemble_code(Dasm, Record->pc, Record->code, Record->words, 1);
+			}
+			else
+			{
+				dasmjagcode((Record->unit == TRACE_GPU) ? JAGUAR_GPU : JAGUAR_DSP, Dasm, Record->pc, Record->code, Record->words);
+			}
+
+			char *Symbol = DBGManager_GetSymbolNameFromAdr(Record->pc);
+			fprintf(Out, "%20llu %-5s %06X: %s%s%s\n", (unsigned long long)Record->cycle, Unit, Record->pc, (Symbol ? Symbol : ""), (Symbol ? ": " : ""), Dasm);
+		}
+	}
+
+	delete[] Records;
+	fclose(In);
+
+	return (fclose(Out) == 0);
+}
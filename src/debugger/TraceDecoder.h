@@ -0,0 +1,8 @@
+#ifndef __TRACEDECODER_H__
+#define __TRACEDECODER_H__
+
+
+extern bool TraceDecoder_Decode(const char *TraceFilename, const char *TextFilename);
+
+
+#endif	// __TRACEDECODER_H__
@@ -85,7 +85,8 @@ void CallStackBrowserWindow::RefreshContents(void)
 	size_t Error = CS_NOERROR;
 	DBGstatus FilenameStatus;
 	unsigned int a6, Sa6, ret;
-	char *Name;
+	char *Name, *LineSrc;
+	size_t Length;
 	size_t NumError = 0;
 #ifdef CS_LAYOUTTEXTS
 	QString CallStack;
@@ -109,7 +110,8 @@ void CallStackBrowserWindow::RefreshContents(void)
 					a6 = GET32(jaguarMainRAM, Sa6);
 					ret = GET32(jaguarMainRAM, Sa6 + 4);
 #ifdef CS_LAYOUTTEXTS
-					sprintf(string, "0x%06X | Ret: 0x%06X | From: %s - 0x%06X | Line: %s", Sa6, ret, (Name = DBGManager_GetFunctionName(ret)), (unsigned int)DBGManager_GetAdrFromSymbolName(Name), DBGManager_GetLineSrcFromAdr(ret, DBG_NO_TAG));
+					LineSrc = DBGManager_GetLineSrcFromAdr(ret, DBG_NO_TAG, &Length);
+					sprintf(string, "0x%06X | Ret: 0x%06X | From: %s - 0x%06X | Line: %.*s", Sa6, ret, (Name = DBGManager_GetFunctionName(ret)), (unsigned int)DBGManager_GetAdrFromSymbolName(Name), (LineSrc ? (int)Length : 0), (LineSrc ? LineSrc : ""));
 					CallStack += QString(string);
 					if (a6)
 					{
@@ -124,10 +126,11 @@ void CallStackBrowserWindow::RefreshContents(void)
 					sprintf(msg, "%zi", DBGManager_GetNumLineFromAdr(ret, DBG_NO_TAG));
 					model->setItem(NbRaw, 1, new QStandardItem(QString("%1").arg((msg[0] != '0') ? msg : "(N/A)")));
 					// display the called line
-					FunctionName = QString(Name = DBGManager_GetLineSrcFromAdr(ret, DBG_NO_TAG));
+					LineSrc = DBGManager_GetLineSrcFromAdr(ret, DBG_NO_TAG, &Length);
+					FunctionName = LineSrc ? QString::fromUtf8(LineSrc, (int)Length) : QString();
 					//FunctionName.replace("&nbsp;", " ");
 					FunctionName = FunctionName.trimmed();
-					model->setItem(NbRaw, 2, new QStandardItem(QString("%1").arg(Name ? FunctionName : "(N/A)")));
+					model->setItem(NbRaw, 2, new QStandardItem(QString("%1").arg(LineSrc ? FunctionName : "(N/A)")));
 					// display the return address
 					sprintf(msg, "0x%06X", ret);
 					model->setItem(NbRaw, 3, new QStandardItem(QString("%1").arg(msg)));
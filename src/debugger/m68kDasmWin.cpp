@@ -67,6 +67,7 @@ void m68KDasmWindow::RefreshContents(void)
 	size_t m68kPC = m68k_get_reg(NULL, M68K_REG_PC);
 	size_t m68KPCNbrDisasmLines = 0;
 	char *Symbol = NULL, *LineSrc, *CurrentLineSrc = NULL;
+	size_t LengthLineSrc;
 	bool m68kPCShow = false;
 	bool constant, adr, equal;
 	DBGstatus Status;
@@ -163,16 +164,16 @@ void m68KDasmWindow::RefreshContents(void)
 			s += QString(string);
 
 			// Display line source based on the program address
-			if (((signed)CurrentNumLine > 0) && (LineSrc = DBGManager_GetLineSrcFromNumLineBaseAdr(oldpc, CurrentNumLine)) && (LineSrc != CurrentLineSrc))
+			if (((signed)CurrentNumLine > 0) && (LineSrc = DBGManager_GetLineSrcFromNumLineBaseAdr(oldpc, CurrentNumLine, &LengthLineSrc)) && (LineSrc != CurrentLineSrc))
 			{
 #if 0
 				// add a color on the line text
-				sprintf(string, "<font color='#006400'>%s</font><br>", (CurrentLineSrc = LineSrc));
+				sprintf(string, "<font color='#006400'>%.*s</font><br>", (int)LengthLineSrc, (CurrentLineSrc = LineSrc));
 				s += QString(string);
 #else
 				// add a color on the line text with HTML encoding
 				s += QString("<font color='#006400'>");
-				s += QString(QString((CurrentLineSrc = LineSrc)).toHtmlEscaped());
+				s += QString::fromUtf8((CurrentLineSrc = LineSrc), (int)LengthLineSrc).toHtmlEscaped();
 				s += QString("</font><br>");
 #endif
 				nbr++;
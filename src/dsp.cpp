@@ -28,13 +28,13 @@
 #include "log.h"
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
+#include "trace.h"
 
 
 // Seems alignment in loads & stores was off...
 #define DSP_CORRECT_ALIGNMENT
 //#define DSP_CORRECT_ALIGNMENT_STORE
 
-//#define DSP_DEBUG
 //#define DSP_DEBUG_IRQ
 //#define DSP_DEBUG_PL2
 //#define DSP_DEBUG_STALL
@@ -583,6 +583,10 @@ uint32_t DSPReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 }*/
 	if (offset >= DSP_WORK_RAM_BASE && offset <= DSP_WORK_RAM_BASE + 0x1FFF)
 	{
+		// The DSP loads in its local RAM don't go through JaguarReadLong, so they are checked here
+		if (who == DSP)
+			watch_access(offset, 4, WATCH_READ, 0, who);
+
 		offset -= DSP_WORK_RAM_BASE;
 		return GET32(dsp_ram_8, offset);
 	}
@@ -735,6 +739,10 @@ void DSPWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 {
 	WriteLog("DSP: %s is writing %08X at location 0xF1BE2C (DSP_PC: %08X)...\n", whoName[who], data, dsp_pc - 2);
 }//*/
+		// The DSP stores in its local RAM don't go through JaguarWriteLong, so they are checked here
+		if (who == DSP)
+			watch_access(offset, 4, WATCH_WRITE, data, who);
+
 		offset -= DSP_WORK_RAM_BASE;
 		SET32(dsp_ram_8, offset, data);
 //CC only!
@@ -752,9 +760,7 @@ SET32(ram2, offset, data);
 		{
 		case 0x00:
 		{
-#ifdef DSP_DEBUG
-			WriteLog("DSP: Writing %08X to DSP_FLAGS by %s (REGPAGE is %sset)...\n", data, whoName[who], (dsp_flags & REGPAGE ? "" : "not "));
-#endif
+			LOGCAT(LOG_CAT_DSP, LOG_LEVEL_DEBUG, "DSP: Writing %08X to DSP_FLAGS by %s (REGPAGE is %sset)...\n", data, whoName[who], (dsp_flags & REGPAGE ? "" : "not "));
 //			bool IMASKCleared = (dsp_flags & IMASK) && !(data & IMASK);
 			IMASKCleared = (dsp_flags & IMASK) && !(data & IMASK);
 			// NOTE: According to the JTRM, writing a 1 to IMASK has no effect; only the
@@ -781,9 +787,7 @@ SET32(ram2, offset, data);
 			break;
 		case 0x10:
 			dsp_pc = data;
-#ifdef DSP_DEBUG
-			WriteLog("DSP: Setting DSP PC to %08X by %s%s\n", dsp_pc, whoName[who], (DSP_RUNNING ? " (DSP is RUNNING!)" : ""));//*/
-#endif
+			LOGCAT(LOG_CAT_DSP, LOG_LEVEL_DEBUG, "DSP: Setting DSP PC to %08X by %s%s\n", dsp_pc, whoName[who], (DSP_RUNNING ? " (DSP is RUNNING!)" : ""));
 //CC only!
 #ifdef DSP_DEBUG_CC
 if (who != DSP)
@@ -793,17 +797,13 @@ if (who != DSP)
 			break;
 		case 0x14:
 		{
-//#ifdef DSP_DEBUG
-WriteLog("Write to DSP CTRL by %s: %08X (DSP PC=$%08X)\n", whoName[who], data, dsp_pc);
-//#endif
+LOGCAT(LOG_CAT_DSP, LOG_LEVEL_DEBUG, "Write to DSP CTRL by %s: %08X (DSP PC=$%08X)\n", whoName[who], data, dsp_pc);
 			bool wasRunning = DSP_RUNNING;
 //			uint32_t dsp_was_running = DSP_RUNNING;
 			// Check for DSP -> CPU interrupt
 			if (data & CPUINT)
 			{
-#ifdef DSP_DEBUG
-				WriteLog("DSP: DSP -> CPU interrupt\n");
-#endif
+				LOGCAT(LOG_CAT_DSP, LOG_LEVEL_DEBUG, "DSP: DSP -> CPU interrupt\n");
 
 #ifdef _MSC_VER
 #pragma message("Warning: !!! DSP IRQs that go to the 68K have to be routed thru TOM !!! FIX !!!")
@@ -821,9 +821,7 @@ WriteLog("Write to DSP CTRL by %s: %08X (DSP PC=$%08X)\n", whoName[who], data, d
 			// Check for CPU -> DSP interrupt
 			if (data & DSPINT0)
 			{
-#ifdef DSP_DEBUG
-				WriteLog("DSP: CPU -> DSP interrupt\n");
-#endif
+				LOGCAT(LOG_CAT_DSP, LOG_LEVEL_DEBUG, "DSP: CPU -> DSP interrupt\n");
 				m68k_end_timeslice();
 				DSPReleaseTimeslice();
 				DSPSetIRQLine(DSPIRQ_CPU, ASSERT_LINE);
@@ -858,13 +856,14 @@ if (who != DSP)
 			if (dsp_control & 0x18)
 				DSPExec(1);
 #endif
-#ifdef DSP_DEBUG
-if (DSP_RUNNING)
-	WriteLog(" --> Starting to run at %08X by %s...", dsp_pc, whoName[who]);
-else
-	WriteLog(" --> Stopped by %s! (DSP PC: %08X)", whoName[who], dsp_pc);
-WriteLog("\n");
-#endif	// DSP_DEBUG
+if (LOG_ENABLED(LOG_CAT_DSP, LOG_LEVEL_DEBUG))
+{
+	if (DSP_RUNNING)
+		WriteLog(" --> Starting to run at %08X by %s...", dsp_pc, whoName[who]);
+	else
+		WriteLog(" --> Stopped by %s! (DSP PC: %08X)", whoName[who], dsp_pc);
+	WriteLog("\n");
+}
 //This isn't exactly right either--we don't know if it was the M68K or the DSP writing here...
 // !!! FIX !!! [DONE]
 			if (DSP_RUNNING)
@@ -1623,6 +1622,10 @@ ptrPCQ %= 32;*/
 		uint32_t index = opcode >> 10;
 		dsp_opcode_first_parameter = (opcode >> 5) & 0x1F;
 		dsp_opcode_second_parameter = opcode & 0x1F;
+
+		if (traceActive[TRACE_DSP])
+			TraceRISC(TRACE_DSP, dsp_pc, opcode, dsp_opcode_cycles[index], dsp_reg);
+
 		dsp_pc += 2;
 		dsp_opcode[index]();
 		dsp_opcode_use[index]++;
@@ -16,28 +16,55 @@
 // JPM  11/18/2020       EEPROM directory creation allowed only for Windows
 //
 
+// The writes don't go to the files right away: they mark the EEPROMs dirty,
+// and a writer thread saves them once no write came for EEPROM_SAVE_DELAY ms,
+// so a game writing many words in a row costs a single save, done off the
+// emulation thread. The files are written to a temporary file, which then
+// replaces the old one. Pending writes are saved at once on a reset, before
+// loading another file and at exit; the writer thread is stopped at exit too,
+// even when EepromDone() isn't called.
+
 #include "eeprom.h"
 #if _WIN32 || _WIN64
 #include <direct.h>
+#include <windows.h>
 #else
 #define _mkdir(dir) 1
 #endif
 #include <stdlib.h>
 #include <string.h>								// For memset
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "jaguar.h"
 #include "log.h"
 #include "settings.h"
 
-#define eeprom_LOG
+#define EEPROM_SAVE_DELAY	500					// Quiet time before saving, in ms
 
 static uint16_t eeprom_ram[64];
 static uint16_t cdromEEPROM[64];
 
+// What is to be saved, as of the last write
+struct EEPROMImage
+{
+	uint16_t ram[64];
+	uint16_t cdrom[64];
+	char filename[MAX_PATH];
+	char cdromFilename[MAX_PATH];
+};
+
 //
 // Private function prototypes
 //
 
-static void EEPROMSave(void);
+static void EEPROMMarkDirty(void);
+static void EEPROMFlush(void);
+static void EEPROMWriter(void);
+static void EEPROMStopWriter(void);
+static void EEPROMAtExit(void);
+static void EEPROMSave(EEPROMImage & image);
 static void eeprom_set_di(uint32_t state);
 static void eeprom_set_cs(uint32_t state);
 static uint32_t eeprom_get_do(void);
@@ -67,16 +94,28 @@ static char cdromEEPROMFilename[MAX_PATH];
 static bool haveEEPROM = false;
 static bool haveCDROMEEPROM = false;
 
+static EEPROMImage eepromImage;
+static bool eepromDirty = false;
+static bool eepromQuit = false;
+static std::chrono::steady_clock::time_point eepromLastWrite;
+static std::mutex eepromMutex;					// Guards the above
+static std::mutex eepromSaveMutex;				// One save at a time
+static std::condition_variable eepromCondition;
+static std::thread * eepromWriter = NULL;		// Started on the first write
+
 
 // EEPROM initialisations
 void EepromInit(void)
 {
 	FILE * fp;
 
+	// Pending writes go to the previous file's EEPROM
+	EEPROMFlush();
+
 	// No need for EEPROM for the Memory Track device :-P
 	if (jaguarMainROMCRC32 == 0xFDF37F47)
 	{
-		WriteLog("EEPROM: Memory Track device detected...\n");
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_INFO, "EEPROM: Memory Track device detected...\n");
 	}
 	else
 	{
@@ -88,12 +127,12 @@ void EepromInit(void)
 		{
 			ReadEEPROMFromFile(fp, eeprom_ram);
 			fclose(fp);
-			WriteLog("EEPROM: Loaded from %s\n", eeprom_filename);
+			LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_INFO, "EEPROM: Loaded from %s\n", eeprom_filename);
 			haveEEPROM = true;
 		}
 		else
 		{
-			WriteLog("EEPROM: Could not open file \"%s\"!\n", eeprom_filename);
+			LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_WARNING, "EEPROM: Could not open file \"%s\"!\n", eeprom_filename);
 		}
 
 		// Handle JagCD EEPROM
@@ -104,12 +143,12 @@ void EepromInit(void)
 		{
 			ReadEEPROMFromFile(fp, cdromEEPROM);
 			fclose(fp);
-			WriteLog("EEPROM: Loaded from cdrom.eeprom\n");
+			LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_INFO, "EEPROM: Loaded from cdrom.eeprom\n");
 			haveCDROMEEPROM = true;
 		}
 		else
 		{
-			WriteLog("EEPROM: Could not open file \"%s\"!\n", cdromEEPROMFilename);
+			LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_WARNING, "EEPROM: Could not open file \"%s\"!\n", cdromEEPROMFilename);
 		}
 	}
 }
@@ -118,6 +157,8 @@ void EepromInit(void)
 // EEPROM reset
 void EepromReset(void)
 {
+	EEPROMFlush();
+
 	if (!haveEEPROM)
 	{
 		memset(eeprom_ram, 0xFF, 64 * sizeof(uint16_t));
@@ -133,47 +174,191 @@ void EepromReset(void)
 //
 void EepromDone(void)
 {
-	WriteLog("EEPROM: Done.\n");
+	EEPROMStopWriter();
+	EEPROMFlush();
+	LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_INFO, "EEPROM: Done.\n");
 }
 
 
-// EEPROM save
-static void EEPROMSave(void)
+//
+// Drop the pending writes, and stop the writer thread; nothing is written to
+// the files anymore until the next write
+//
+void EepromDiscard(void)
 {
-	FILE * fp;
+	EEPROMStopWriter();
+	std::lock_guard<std::mutex> saveLock(eepromSaveMutex);
+	std::lock_guard<std::mutex> lock(eepromMutex);
+	eepromDirty = false;
+}
+
+
+//
+// Stop the writer thread, if running, once its current save is done
+//
+static void EEPROMStopWriter(void)
+{
+	std::thread * writer;
 
-	// Check if EEPROM directory exists and try to create it if not
-	if (_mkdir(vjs.EEPROMPath))
 	{
-		WriteLog("EEPROM: Could not create directory \"%s!\"\n", vjs.EEPROMPath);
+		std::lock_guard<std::mutex> lock(eepromMutex);
+		writer = eepromWriter;
+		eepromWriter = NULL;
+		eepromQuit = true;
 	}
 
-	// Write out regular cartridge EEPROM data
-	fp = fopen(eeprom_filename, "wb");
-	if (fp)
+	if (writer == NULL)
+		return;
+
+	eepromCondition.notify_one();
+	writer->join();
+	delete writer;
+}
+
+
+static void EEPROMAtExit(void)
+{
+	EEPROMStopWriter();
+	EEPROMFlush();
+}
+
+
+//
+// Called by the emulation on a write: snapshot the EEPROMs, and leave the
+// saving to the writer thread
+//
+static void EEPROMMarkDirty(void)
+{
 	{
-		WriteEEPROMToFile(fp, eeprom_ram);
-		fclose(fp);
+		std::lock_guard<std::mutex> lock(eepromMutex);
+		memcpy(eepromImage.ram, eeprom_ram, sizeof(eeprom_ram));
+		memcpy(eepromImage.cdrom, cdromEEPROM, sizeof(cdromEEPROM));
+		strcpy(eepromImage.filename, eeprom_filename);
+		strcpy(eepromImage.cdromFilename, cdromEEPROMFilename);
+		eepromDirty = true;
+		eepromLastWrite = std::chrono::steady_clock::now();
+
+		if (eepromWriter == NULL)
+		{
+			static bool atExitSet = false;
+
+			if (!atExitSet)
+			{
+				atexit(EEPROMAtExit);
+				atExitSet = true;
+			}
+
+			eepromQuit = false;
+			eepromWriter = new std::thread(EEPROMWriter);
+		}
 	}
-	else
+
+	eepromCondition.notify_one();
+}
+
+
+//
+// Save the pending writes, if any, now
+//
+static void EEPROMFlush(void)
+{
+	std::lock_guard<std::mutex> saveLock(eepromSaveMutex);
+	EEPROMImage image;
+
 	{
-		WriteLog("EEPROM: Could not create file \"%s!\"\n", eeprom_filename);
+		std::lock_guard<std::mutex> lock(eepromMutex);
+
+		if (!eepromDirty)
+			return;
+
+		image = eepromImage;
+		eepromDirty = false;
 	}
 
-	// Write out JagCD EEPROM data
-	fp = fopen(cdromEEPROMFilename, "wb");
-	if (fp)
+	EEPROMSave(image);
+}
+
+
+//
+// Writer thread: saves the EEPROMs once the writes have settled
+//
+static void EEPROMWriter(void)
+{
+	std::unique_lock<std::mutex> lock(eepromMutex);
+
+	while (true)
+	{
+		eepromCondition.wait(lock, [] { return eepromQuit || eepromDirty; });
+
+		if (eepromQuit)
+			break;
+
+		// Another write pushes the save further back
+		std::chrono::steady_clock::time_point due = eepromLastWrite + std::chrono::milliseconds(EEPROM_SAVE_DELAY);
+
+		if (std::chrono::steady_clock::now() < due)
+		{
+			eepromCondition.wait_until(lock, due, [] { return eepromQuit; });
+			continue;
+		}
+
+		lock.unlock();
+		EEPROMFlush();
+		lock.lock();
+	}
+}
+
+
+//
+// Write the file to a temporary one, and replace the file with it
+//
+static void EEPROMSaveFile(const char * filename, uint16_t * ram)
+{
+	char tempFile[MAX_PATH + 8];
+	snprintf(tempFile, sizeof(tempFile), "%s.tmp", filename);
+	FILE * fp = fopen(tempFile, "wb");
+
+	if (fp == NULL)
 	{
-		WriteEEPROMToFile(fp, cdromEEPROM);
-		fclose(fp);
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_ERROR, "EEPROM: Could not create file \"%s!\"\n", tempFile);
+		return;
 	}
-	else
+
+	WriteEEPROMToFile(fp, ram);
+	bool ok = (ferror(fp) == 0);
+	ok = (fclose(fp) == 0) && ok;
+
+#if _WIN32 || _WIN64
+	ok = ok && MoveFileExA(tempFile, filename, MOVEFILE_REPLACE_EXISTING);
+#else
+	ok = ok && (rename(tempFile, filename) == 0);
+#endif
+
+	if (!ok)
 	{
-		WriteLog("EEPROM: Could not create file \"%s!\"\n", cdromEEPROMFilename);
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_ERROR, "EEPROM: Could not write file \"%s!\"\n", filename);
+		remove(tempFile);
 	}
 }
 
 
+// EEPROM save
+static void EEPROMSave(EEPROMImage & image)
+{
+	// Check if EEPROM directory exists and try to create it if not
+	if (_mkdir(vjs.EEPROMPath))
+	{
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_INFO, "EEPROM: Could not create directory \"%s!\"\n", vjs.EEPROMPath);
+	}
+
+	// Write out regular cartridge EEPROM data
+	EEPROMSaveFile(image.filename, image.ram);
+
+	// Write out JagCD EEPROM data
+	EEPROMSaveFile(image.cdromFilename, image.cdrom);
+}
+
+
 //
 // Read/write EEPROM files to disk in an endian safe manner
 //
@@ -215,9 +400,7 @@ uint8_t EepromReadByte(uint32_t offset)
 		eeprom_set_cs(1);
 		break;
 	default:
-#ifdef eeprom_LOG
-		WriteLog("EEPROM: unmapped 0x%.8x\n", offset);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_WARNING, "EEPROM: unmapped 0x%.8x\n", offset);
 		break;
 	}
 
@@ -244,9 +427,7 @@ void EepromWriteByte(uint32_t offset, uint8_t data)
 		eeprom_set_cs(1);
 		break;
 	default:
-#ifdef eeprom_LOG
-		WriteLog("eeprom: unmapped 0x%.8x\n",offset);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_WARNING, "eeprom: unmapped 0x%.8x\n",offset);
 		break;
 	}
 }
@@ -278,10 +459,8 @@ eERASE	equ	%111000000		;Erase selected register
 
 static void eeprom_set_di(uint32_t data)
 {
-#ifdef eeprom_LOG
-	WriteLog("eeprom: di=%i\n",data);
-	WriteLog("eeprom: state %i\n",jerry_ee_state);
-#endif
+	LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: di=%i\n",data);
+	LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: state %i\n",jerry_ee_state);
 
 	switch (jerry_ee_state)
 	{
@@ -295,9 +474,7 @@ static void eeprom_set_di(uint32_t data)
 	case EE_STATE_OP_B:
 		jerry_ee_op |= data;
 		jerry_ee_direct_jump = 0;
-#ifdef eeprom_LOG
-		WriteLog("eeprom: opcode %i\n",jerry_ee_op);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: opcode %i\n",jerry_ee_op);
 
 		switch (jerry_ee_op)
 		{
@@ -337,9 +514,7 @@ static void eeprom_set_di(uint32_t data)
 		break;
 	case EE_STATE_0_0_0:
 		// writes disable
-#ifdef eeprom_LOG
-		WriteLog("eeprom: read only\n");
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: read only\n");
 		jerry_writes_enabled = 0;
 		jerry_ee_state = EE_STATE_START;
 		break;
@@ -352,39 +527,35 @@ static void eeprom_set_di(uint32_t data)
 		jerry_ee_direct_jump = 1;
 		break;
 	case EE_STATE_0_0_1_0:
-#ifdef eeprom_LOG
-		WriteLog("eeprom: filling eeprom with 0x%.4x\n",data);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: filling eeprom with 0x%.4x\n",data);
 		if (jerry_writes_enabled)
 		{
 			for(int i=0; i<64; i++)
 				eeprom_ram[i] = jerry_ee_data;
 
-			EEPROMSave();						// Save it NOW!
+			EEPROMMarkDirty();
 		}
 
 		//else
-#ifdef eeprom_LOG
-		WriteLog("eeprom: not writing because read only\n");
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: not writing because read only\n");
 		jerry_ee_state = EE_STATE_BUSY;
 		break;
 	case EE_STATE_0_0_2:
 		// erase all
-#ifdef eeprom_LOG
-		WriteLog("eeprom: erasing eeprom\n");
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: erasing eeprom\n");
 		if (jerry_writes_enabled)
+		{
 			for(int i=0; i<64; i++)
 				eeprom_ram[i] = 0xFFFF;
 
+			EEPROMMarkDirty();
+		}
+
 		jerry_ee_state = EE_STATE_BUSY;
 		break;
 	case EE_STATE_0_0_3:
 		// writes enable
-#ifdef eeprom_LOG
-		WriteLog("eeprom: read/write\n");
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: read/write\n");
 		jerry_writes_enabled = 1;
 		jerry_ee_state = EE_STATE_START;
 		break;
@@ -403,13 +574,11 @@ static void eeprom_set_di(uint32_t data)
 		jerry_ee_direct_jump = 1;
 		break;
 	case EE_STATE_1_1:
-#ifdef eeprom_LOG
-		WriteLog("eeprom: writing 0x%.4x at 0x%.2x\n",jerry_ee_data,jerry_ee_address_data);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: writing 0x%.4x at 0x%.2x\n",jerry_ee_data,jerry_ee_address_data);
 		if (jerry_writes_enabled)
 		{
 			eeprom_ram[jerry_ee_address_data] = jerry_ee_data;
-			EEPROMSave();						// Save it NOW!
+			EEPROMMarkDirty();
 		}
 
 		jerry_ee_state = EE_STATE_BUSY;
@@ -430,18 +599,17 @@ static void eeprom_set_di(uint32_t data)
 		jerry_ee_direct_jump = 1;
 		break;
 	case EE_STATE_3_0:
-#ifdef eeprom_LOG
-		WriteLog("eeprom: erasing 0x%.2x\n",jerry_ee_address_data);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: erasing 0x%.2x\n",jerry_ee_address_data);
 		if (jerry_writes_enabled)
+		{
 			eeprom_ram[jerry_ee_address_data] = 0xFFFF;
+			EEPROMMarkDirty();
+		}
 
 		jerry_ee_state = EE_STATE_BUSY;
 		break;
 	case EE_READ_DATA:
-#ifdef eeprom_LOG
-		WriteLog("eeprom:\t\t\t%i bit %i\n",data,jerry_ee_data_cnt-1);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom:\t\t\t%i bit %i\n",data,jerry_ee_data_cnt-1);
 		jerry_ee_data <<= 1;
 		jerry_ee_data |= data;
 		jerry_ee_data_cnt--;
@@ -459,16 +627,12 @@ static void eeprom_set_di(uint32_t data)
 		jerry_ee_address_data <<= 1;
 		jerry_ee_address_data |= data;
 		jerry_ee_address_cnt--;
-#ifdef eeprom_LOG
-		WriteLog("eeprom:\t%i bits remaining\n",jerry_ee_address_cnt);
-#endif
+		LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom:\t%i bits remaining\n",jerry_ee_address_cnt);
 
 		if (!jerry_ee_address_cnt)
 		{
 			jerry_ee_state = jerry_ee_rstate;
-#ifdef eeprom_LOG
-			WriteLog("eeprom:\t\tread address 0x%.2x\n",jerry_ee_address_data);
-#endif
+			LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom:\t\tread address 0x%.2x\n",jerry_ee_address_data);
 
 			if (jerry_ee_direct_jump)
 				eeprom_set_di(data);
@@ -483,9 +647,7 @@ static void eeprom_set_di(uint32_t data)
 
 static void eeprom_set_cs(uint32_t state)
 {
-#ifdef eeprom_LOG
-	WriteLog("eeprom: cs=%i\n",state);
-#endif
+	LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: cs=%i\n",state);
 	jerry_ee_state = EE_STATE_START;
 	jerry_ee_op = 0;
 	jerry_ee_rstate = 0;
@@ -516,17 +678,13 @@ static uint32_t eeprom_get_do(void)
 
 		if (!jerry_ee_data_cnt)
 		{
-#ifdef eeprom_LOG
 			//WriteLog("eeprom: read 0x%.4x at 0x%.2x cpu %i pc=0x%.8x\n",eeprom_ram[jerry_ee_address_data],jerry_ee_address_data,jaguar_cpu_in_exec,s68000readPC());
-#endif
 			jerry_ee_state = EE_STATE_START;
 		}
 		break;
 	}
 
-#ifdef eeprom_LOG
-	WriteLog("eeprom: do=%i\n",data);
-#endif
+	LOGCAT(LOG_CAT_EEPROM, LOG_LEVEL_TRACE, "eeprom: do=%i\n",data);
 	return data;
 }
 
@@ -10,6 +10,7 @@
 extern void EepromInit(void);
 extern void EepromReset(void);
 extern void EepromDone(void);
+extern void EepromDiscard(void);
 
 extern uint8_t EepromReadByte(uint32_t offset);
 extern uint16_t EepromReadWord(uint32_t offset);
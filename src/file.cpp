@@ -28,8 +28,17 @@
 #endif // _MSC_VER
 #include <stdarg.h>
 #include <string.h>
+#include <atomic>
 #include <sys/types.h>
 #include <sys/stat.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif // _WIN32
 #include "crc32.h"
 #include "filedb.h"
 #include "eeprom.h"
@@ -56,9 +65,13 @@ static bool CheckExtension(const uint8_t *filename, const char *ext);
 //static bool CheckExtension(const char * filename, const char * ext);
 //#endif // _MSC_VER
 //static int ParseFileType(uint8_t header1, uint8_t header2, uint32_t size);
+static uint32_t LoadSoftware(uint8_t * &buffer, bool &mapped, char * path);
+static void FreeSoftware(uint8_t * buffer, uint32_t size, bool mapped);
 
 // Private variables/enums
 
+static std::atomic<bool> zipCacheFailed(false);		// The ZIP cache can't be written to
+
 
 //
 // Generic ROM loading
@@ -132,6 +145,141 @@ uint32_t JaguarLoadROM(uint8_t * &rom, char * path)
 }
 
 
+//
+// Map a file in memory; the mapping is private, so writing to it never
+// changes the file, or read only so its pages are never copied. Returns NULL
+// if the file can't be mapped.
+//
+uint8_t * FileMap(const char * path, uint32_t &size, bool readOnly/*= false*/)
+{
+	void * data = NULL;
+	size = 0;
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	LARGE_INTEGER fileSize;
+
+	if (GetFileSizeEx(file, &fileSize) && (fileSize.QuadPart > 0) && (fileSize.QuadPart <= 0xFFFFFFFF))
+	{
+		HANDLE mapping = CreateFileMappingA(file, NULL, (readOnly ? PAGE_READONLY : PAGE_WRITECOPY), 0, 0, NULL);
+
+		if (mapping != NULL)
+		{
+			data = MapViewOfFile(mapping, (readOnly ? FILE_MAP_READ : FILE_MAP_COPY), 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+
+	if (data != NULL)
+		size = fileSize.LowPart;
+#else
+	int fd = open(path, O_RDONLY);
+
+	if (fd < 0)
+		return NULL;
+
+	struct stat fileInfo;
+
+	if ((fstat(fd, &fileInfo) == 0) && (fileInfo.st_size > 0) && ((uint64_t)fileInfo.st_size <= 0xFFFFFFFF))
+	{
+		data = mmap(NULL, fileInfo.st_size, (readOnly ? PROT_READ : (PROT_READ | PROT_WRITE)), MAP_PRIVATE, fd, 0);
+
+		if (data == MAP_FAILED)
+			data = NULL;
+		else
+			size = (uint32_t)fileInfo.st_size;
+	}
+
+	close(fd);
+#endif // _WIN32
+
+	return (uint8_t *)data;
+}
+
+
+void FileUnmap(uint8_t * data, uint32_t size)
+{
+	if (data == NULL)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(data);
+#else
+	munmap(data, size);
+#endif // _WIN32
+}
+
+
+//
+// Software loading for the emulation: plain files are mapped, so nothing is
+// read but what's used (and only once); so are ZIPped files, from the ZIP
+// cache. Otherwise (and for gzipped files), they're unpacked by JaguarLoadROM.
+// The software isn't run from the mapping, as the cartridge space is part of
+// jagMemSpace, which all the memory handlers index; the mapping only saves the
+// copy in between.
+//
+static uint32_t LoadSoftware(uint8_t * &buffer, bool &mapped, char * path)
+{
+	char * ext = strrchr(path, '.');
+	mapped = false;
+
+	if ((ext != NULL) && (strcasecmp(ext, ".zip") == 0))
+	{
+		// Without the ZIP cache, JaguarLoadROM uncompresses the file; with it, a
+		// ZIP that fails here would only fail there too, after a second inflate
+		if ((vjs.zipCachePath[0] != 0) && !zipCacheFailed)
+		{
+			uint32_t size;
+			buffer = MapFileFromZIP(path, FT_SOFTWARE, size, mapped);
+
+			if (buffer == NULL)
+			{
+				WriteLog("FILE: Could not get the software from \"%s\"!\n", path);
+				return 0;
+			}
+
+			return size;
+		}
+	}
+	else if (ext != NULL)
+	{
+		uint32_t size;
+		buffer = FileMap(path, size);
+
+		// gzip magic number
+		if ((buffer != NULL) && (size >= 2) && (buffer[0] == 0x1F) && (buffer[1] == 0x8B))
+		{
+			FileUnmap(buffer, size);
+			buffer = NULL;
+		}
+
+		if (buffer != NULL)
+		{
+			WriteLog("FILE: Mapped \"%s\" (%u bytes)\n", path, size);
+			mapped = true;
+			return size;
+		}
+	}
+
+	return JaguarLoadROM(buffer, path);
+}
+
+
+static void FreeSoftware(uint8_t * buffer, uint32_t size, bool mapped)
+{
+	if (mapped)
+		FileUnmap(buffer, size);
+	else
+		delete[] buffer;
+}
+
+
 //
 // Jaguar file loading
 // We do a more intelligent file analysis here instead of relying on (possible
@@ -150,11 +298,12 @@ bool JaguarLoadFile(char * path)
 	char *NameSection;
 	size_t ElfSectionNameType;
 	int	DBGType = DBG_NO_TYPE;
+	bool mapped;
 	bool error;
 	int err;
 	struct stat _statbuf;
 
-	jaguarROMSize = JaguarLoadROM(buffer, path);
+	jaguarROMSize = LoadSoftware(buffer, mapped, path);
 
 	if (jaguarROMSize == 0)
 	{
@@ -180,7 +329,7 @@ bool JaguarLoadFile(char * path)
 // Checking something...
 jaguarRunAddress = GET32(jagMemSpace, 0x800404);
 WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress);
-		delete[] buffer;
+		FreeSoftware(buffer, jaguarROMSize, mapped);
 		return true;
 	}
 	else if (fileType == JST_ALPINE)
@@ -189,7 +338,7 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 		WriteLog("FILE: Setting up Alpine ROM... Run address: 00802000, length: %08X\n", jaguarROMSize);
 		memset(jagMemSpace + 0x800000, 0xFF, 0x2000);
 		memcpy(jagMemSpace + 0x802000, buffer, jaguarROMSize);
-		delete[] buffer;
+		FreeSoftware(buffer, jaguarROMSize, mapped);
 
 // Maybe instead of this, we could try requiring the STUBULATOR ROM? Just a thought...
 		// Try setting the vector to say, $1000 and putting an instruction there that loops forever:
@@ -202,6 +351,8 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 	{
 		DBGType = DBG_ELF;
 
+		// The DWARF information is decoded from the executable at its first look up, so the ELF manager
+		// gets a private copy; the file can then be relinked in place, and is not kept open, while debugging
 		char *PtrELFExe = (char *)ELFManager_ExeCopy(buffer, jaguarROMSize);
 
 		if (PtrELFExe != NULL)
@@ -212,7 +363,7 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 				// get the file information
 				stat(path, &_statbuf);
 
-				if (ELFManager_DwarfInit(ElfMem, _statbuf))
+				if (ELFManager_DwarfInit(ElfMem, _statbuf, path))
 				{
 					DBGType |= DBG_ELFDWARF;
 				}
@@ -316,6 +467,9 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 							}
 						}
 
+						// Index the symbols found in the tabs
+						ELFManager_SymbolsInit();
+
 						// Set the executable address
 						jaguarRunAddress = (uint32_t)PtrGElfEhdr->e_entry;
 						WriteLog("FILE: Setting up ELF 32bits... Run address: %08X\n", jaguarRunAddress);
@@ -343,7 +497,7 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 			WriteLog("FILE: ELFManager cannot allocate memory\n");
 		}
 
-		delete[] buffer;
+		FreeSoftware(buffer, jaguarROMSize, mapped);
 
 		if (error)
 		{
@@ -369,7 +523,7 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 			codeSize = GET32(buffer, 0x02) + GET32(buffer, 0x06);
 		WriteLog("FILE: Setting up homebrew (ABS-1)... Run address: %08X, length: %08X\n", loadAddress, codeSize);
 		memcpy(jagMemSpace + loadAddress, buffer + 0x24, codeSize);
-		delete[] buffer;
+		FreeSoftware(buffer, jaguarROMSize, mapped);
 		jaguarRunAddress = loadAddress;
 		return true;
 	}
@@ -379,7 +533,7 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 			codeSize = GET32(buffer, 0x18) + GET32(buffer, 0x1C);
 		WriteLog("FILE: Setting up homebrew (ABS-2)... Run address: %08X, length: %08X\n", runAddress, codeSize);
 		memcpy(jagMemSpace + loadAddress, buffer + 0xA8, codeSize);
-		delete[] buffer;
+		FreeSoftware(buffer, jaguarROMSize, mapped);
 		jaguarRunAddress = runAddress;
 		return true;
 	}
@@ -427,7 +581,7 @@ WriteLog("FILE: Cartridge run address is reported as $%X...\n", jaguarRunAddress
 			uint32_t loadAddress = GET32(buffer, 0x22), runAddress = GET32(buffer, 0x2A);
 			WriteLog("FILE: Setting up homebrew (Jag Server)... Run address: $%X, length: $%X\n", runAddress, jaguarROMSize - 0x2E);
 			memcpy(jagMemSpace + loadAddress, buffer + 0x2E, jaguarROMSize - 0x2E);
-			delete[] buffer;
+			FreeSoftware(buffer, jaguarROMSize, mapped);
 			jaguarRunAddress = runAddress;
 
 // Hmm. Is this kludge necessary?
@@ -451,12 +605,13 @@ SET16(jaguarMainRAM, 0x1000, 0x60FE);		// Here: bra Here
 		uint32_t loadAddress = (buffer[0x1F] << 24) | (buffer[0x1E] << 16) | (buffer[0x1D] << 8) | buffer[0x1C];
 		WriteLog("FILE: Setting up homebrew (GEMDOS WTFOMGBBQ type)... Run address: $%X, length: $%X\n", loadAddress, jaguarROMSize - 0x20);
 		memcpy(jagMemSpace + loadAddress, buffer + 0x20, jaguarROMSize - 0x20);
-		delete[] buffer;
+		FreeSoftware(buffer, jaguarROMSize, mapped);
 		jaguarRunAddress = loadAddress;
 		return true;
 	}
 
 	// We can assume we have JST_NONE at this point. :-P
+	FreeSoftware(buffer, jaguarROMSize, mapped);
 	WriteLog("FILE: Failed to load headerless file.\n");
 	return false;
 }
@@ -481,7 +636,8 @@ bool DebuggerLoadFile(char * path)
 bool AlpineLoadFile(char * path)
 {
 	uint8_t * buffer = NULL;
-	jaguarROMSize = JaguarLoadROM(buffer, path);
+	bool mapped;
+	jaguarROMSize = LoadSoftware(buffer, mapped, path);
 
 	if (jaguarROMSize == 0)
 	{
@@ -500,7 +656,7 @@ bool AlpineLoadFile(char * path)
 
 	memset(jagMemSpace + 0x800000, 0xFF, 0x2000);
 	memcpy(jagMemSpace + 0x802000, buffer, jaguarROMSize);
-	delete[] buffer;
+	FreeSoftware(buffer, jaguarROMSize, mapped);
 
 // Maybe instead of this, we could try requiring the STUBULATOR ROM? Just a thought...
 	// Try setting the vector to say, $1000 and putting an instruction there
@@ -563,32 +719,12 @@ static bool CheckExtension(const uint8_t *filename, const char *ext)
 
 
 //
-// Get file from .ZIP
-// Returns the size of the file inside the .ZIP file that we're looking at
-// NOTE: If the thing we're looking for is found, it allocates it in the passed in buffer.
-//       Which means we have to deallocate it later.
+// Look for a file of the given type in a .ZIP file; if it's found, the file
+// stream is left at its compressed data
 //
-uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer)
+static bool FindFileInZIP(FILE * zip, FileType type, ZipFileEntry & ze)
 {
-// NOTE: We could easily check for this by discarding anything that's larger than the RAM/ROM
-//       size of the Jaguar console.
-#if defined(_MSC_VER)
-#pragma message("Warning: !!! FIX !!! Should have sanity checking for ROM size to prevent buffer overflow!")
-#else
-#warning "!!! FIX !!! Should have sanity checking for ROM size to prevent buffer overflow!"
-#endif // _MSC_VER
 	const char ftStrings[5][32] = { "Software", "EEPROM", "Label", "Box Art", "Controller Overlay" };
-//	ZIP * zip = openzip(0, 0, zipFile);
-	FILE * zip = fopen(zipFile, "rb");
-
-	if (zip == NULL)
-	{
-		WriteLog("FILE: Could not open file '%s'!\n", zipFile);
-		return 0;
-	}
-
-//	zipent * ze;
-	ZipFileEntry ze;
 	bool found = false;
 
 	// The order is here is important: If the file is found, we need to short-circuit the
@@ -631,9 +767,44 @@ uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer)
 			fseek(zip, ze.compressedSize, SEEK_CUR);
 	}
 
+	if (!found)
+		// Didn't find what we're looking for...
+		WriteLog("FILE: Failed to find file of type %s...\n", ftStrings[type]);
+
+	return found;
+}
+
+
+//
+// Get file from .ZIP
+// Returns the size of the file inside the .ZIP file that we're looking at
+// NOTE: If the thing we're looking for is found, it allocates it in the passed in buffer.
+//       Which means we have to deallocate it later.
+// If crc isn't NULL, it gets the CRC32 of the file, computed while uncompressing it.
+//
+uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer, uint32_t * crc/*= NULL*/)
+{
+// NOTE: We could easily check for this by discarding anything that's larger than the RAM/ROM
+//       size of the Jaguar console.
+#if defined(_MSC_VER)
+#pragma message("Warning: !!! FIX !!! Should have sanity checking for ROM size to prevent buffer overflow!")
+#else
+#warning "!!! FIX !!! Should have sanity checking for ROM size to prevent buffer overflow!"
+#endif // _MSC_VER
+//	ZIP * zip = openzip(0, 0, zipFile);
+	FILE * zip = fopen(zipFile, "rb");
+
+	if (zip == NULL)
+	{
+		WriteLog("FILE: Could not open file '%s'!\n", zipFile);
+		return 0;
+	}
+
+//	zipent * ze;
+	ZipFileEntry ze;
 	uint32_t fileSize = 0;
 
-	if (found)
+	if (FindFileInZIP(zip, type, ze))
 	{
 		WriteLog("FILE: Uncompressing...");
 // Insert file size sanity check here...
@@ -641,7 +812,7 @@ uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer)
 
 //		if (readuncompresszip(zip, ze.compressedSize, buffer) == 0)
 //		if (UncompressFileFromZIP(zip, ze.compressedSize, buffer) == 0)
-		if (UncompressFileFromZIP(zip, ze, buffer) == 0)
+		if (UncompressFileFromZIP(zip, ze, buffer, crc) == 0)
 		{
 			fileSize = ze.uncompressedSize;
 			WriteLog("success! (%u bytes)\n", fileSize);
@@ -653,9 +824,6 @@ uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer)
 			WriteLog("FAILED!\n");
 		}
 	}
-	else
-		// Didn't find what we're looking for...
-		WriteLog("FILE: Failed to find file of type %s...\n", ftStrings[type]);
 
 //	closezip(zip);
 	fclose(zip);
@@ -663,6 +831,114 @@ uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer)
 }
 
 
+//
+// Get file from .ZIP, through the ZIP cache: files are uncompressed once into
+// the cache folder, under their CRC32 & size (so the same file found in other
+// ZIPs is shared), and then mapped from there.
+// Returns the mapping (see FileMap), or NULL if the file can't be had that way
+// (no cache folder, or it can't be written to) so GetFileFromZIP has to be used.
+// A file uncompressed but left out of the cache (bad CRC, or the cache can't be
+// written to) is returned as is rather than uncompressed again, and then mapped
+// is false: it's to be deleted, not unmapped.
+// If crc isn't NULL, it gets the CRC32 of the file.
+//
+uint8_t * MapFileFromZIP(const char * zipFile, FileType type, uint32_t &size, bool &mapped, uint32_t * crc/*= NULL*/)
+{
+	size = 0;
+	mapped = false;
+
+	if ((vjs.zipCachePath[0] == 0) || zipCacheFailed)
+		return NULL;
+
+	FILE * zip = fopen(zipFile, "rb");
+
+	if (zip == NULL)
+	{
+		WriteLog("FILE: Could not open file '%s'!\n", zipFile);
+		return NULL;
+	}
+
+	ZipFileEntry ze;
+
+	if (!FindFileInZIP(zip, type, ze) || (ze.uncompressedSize == 0))
+	{
+		fclose(zip);
+		return NULL;
+	}
+
+	char cacheFile[MAX_PATH];
+	snprintf(cacheFile, MAX_PATH, "%s%08X-%08X.bin", vjs.zipCachePath, ze.crc32, ze.uncompressedSize);
+	uint8_t * data = FileMap(cacheFile, size);
+
+	if ((data != NULL) && (size != ze.uncompressedSize))
+	{
+		FileUnmap(data, size);
+		data = NULL;
+	}
+
+	uint32_t fileCRC = ze.crc32;
+
+	// Not in the cache yet: uncompress it there. It's written to a temporary
+	// file first, since other threads may want the same file at the same time.
+	if (data == NULL)
+	{
+		WriteLog("FILE: Uncompressing into the cache...");
+		uint8_t * buffer = new uint8_t[ze.uncompressedSize];
+		char tempFile[MAX_PATH + 32];
+		snprintf(tempFile, sizeof(tempFile), "%s.%p.tmp", cacheFile, (void *)buffer);
+
+		if (UncompressFileFromZIP(zip, ze, buffer, &fileCRC) == 0)
+		{
+			// Only a file matching its CRC goes in, since it's known by it
+			if (fileCRC == ze.crc32)
+			{
+				FILE * fp = fopen(tempFile, "wb");
+
+				if (fp != NULL)
+				{
+					bool written = (fwrite(buffer, 1, ze.uncompressedSize, fp) == ze.uncompressedSize);
+					written = (fclose(fp) == 0) && written;
+
+					if (!written || (rename(tempFile, cacheFile) != 0))
+						remove(tempFile);
+				}
+				else
+				{
+					// Don't try again for every file, it won't get any better
+					zipCacheFailed = true;
+				}
+
+				data = FileMap(cacheFile, size);
+			}
+
+			if (data != NULL)
+				mapped = true;
+			else
+			{
+				data = buffer;
+				size = ze.uncompressedSize;
+				buffer = NULL;
+			}
+		}
+
+		delete[] buffer;
+		WriteLog("%s\n", (data == NULL ? "FAILED!" : (mapped ? "success!" : "success! (not cached)")));
+	}
+	else
+	{
+		mapped = true;
+		WriteLog("FILE: Mapped '%s' from the cache (%u bytes)\n", ze.filename, size);
+	}
+
+	fclose(zip);
+
+	if ((data != NULL) && (crc != NULL))
+		*crc = fileCRC;
+
+	return data;
+}
+
+
 uint32_t GetFileDBIdentityFromZIP(const char * zipFile)
 {
 	FILE * zip = fopen(zipFile, "rb");
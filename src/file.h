@@ -30,11 +30,14 @@ extern uint32_t JaguarLoadROM(uint8_t * &rom, char * path);
 extern bool JaguarLoadFile(char * path);
 extern bool AlpineLoadFile(char * path);
 extern bool DebuggerLoadFile(char * path);
-extern uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer);
+extern uint32_t GetFileFromZIP(const char * zipFile, FileType type, uint8_t * &buffer, uint32_t * crc = NULL);
+extern uint8_t * MapFileFromZIP(const char * zipFile, FileType type, uint32_t &size, bool &mapped, uint32_t * crc = NULL);
 extern uint32_t GetFileDBIdentityFromZIP(const char * zipFile);
 extern bool FindFileInZIPWithCRC32(const char * zipFile, uint32_t crc);
 extern uint32_t ParseFileType(uint8_t * buffer, uint32_t size);
 extern bool HasUniversalHeader(uint8_t * rom, uint32_t romSize);
+extern uint8_t * FileMap(const char * path, uint32_t &size, bool readOnly = false);
+extern void FileUnmap(uint8_t * data, uint32_t size);
 
 #if 0
 #ifdef __cplusplus
@@ -37,11 +37,11 @@
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
 #include "tom.h"
+#include "trace.h"
 
 
 // Seems alignment in loads & stores was off...
 #define GPU_CORRECT_ALIGNMENT
-//#define GPU_DEBUG
 
 // For GPU dissasembly...
 
@@ -176,9 +176,6 @@ GPU opcodes use (BIOS flying ATARI logo):
 
 // External global variables
 
-extern int start_logging;
-extern int gpu_start_log;
-
 // Private function prototypes
 
 void GPUUpdateRegisterBanks(void);
@@ -518,6 +515,10 @@ uint32_t GPUReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //	if ((offset >= GPU_WORK_RAM_BASE) && (offset < GPU_WORK_RAM_BASE + 0x1000))
 	if ((offset >= GPU_WORK_RAM_BASE) && (offset <= GPU_WORK_RAM_BASE + 0x0FFC))
 	{
+		// The GPU loads in its local RAM don't go through JaguarReadWord, so they are checked here
+		if (who == GPU)
+			watch_access(offset, 4, WATCH_READ, 0, who);
+
 		offset &= 0xFFF;
 		return ((uint32_t)gpu_ram_8[offset] << 24) | ((uint32_t)gpu_ram_8[offset+1] << 16)
 			| ((uint32_t)gpu_ram_8[offset+2] << 8) | (uint32_t)gpu_ram_8[offset+3];//*/
@@ -552,9 +553,7 @@ uint32_t GPUReadLong(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 		case 0x1C:
 			return gpu_remain;
 		default:								// unaligned long read
-#ifdef GPU_DEBUG
-			WriteLog("GPU: Read32--unaligned 32 bit read at %08X by %s.\n", GPU_CONTROL_RAM_BASE + offset, whoName[who]);
-#endif	// GPU_DEBUG
+			LOGCAT(LOG_CAT_GPU, LOG_LEVEL_DEBUG, "GPU: Read32--unaligned 32 bit read at %08X by %s.\n", GPU_CONTROL_RAM_BASE + offset, whoName[who]);
 			return 0;
 		}
 	}
@@ -639,10 +638,11 @@ void GPUWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 	{
 		if (offset & 0x01)		// This is supposed to weed out unaligned writes, but does nothing...
 		{
-#ifdef GPU_DEBUG
-			WriteLog("GPU: Write16--unaligned write @ %08X [%04X]\n", offset, data);
-			GPUDumpRegisters();
-#endif	// GPU_DEBUG
+			if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
+			{
+				WriteLog("GPU: Write16--unaligned write @ %08X [%04X]\n", offset, data);
+				GPUDumpRegisters();
+			}
 			return;
 		}
 //Dual locations in this range: $1C Divide unit remainder/Divide unit control (R/W)
@@ -670,12 +670,13 @@ void GPUWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 
 		return;
 	}
-	else if ((offset == GPU_WORK_RAM_BASE + 0x0FFF) || (GPU_CONTROL_RAM_BASE + 0x1F))
+	else if ((offset == GPU_WORK_RAM_BASE + 0x0FFF) || (offset == GPU_CONTROL_RAM_BASE + 0x1F))
 	{
-#ifdef GPU_DEBUG
-			WriteLog("GPU: Write16--unaligned write @ %08X by %s [%04X]!\n", offset, whoName[who], data);
-			GPUDumpRegisters();
-#endif	// GPU_DEBUG
+			if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
+			{
+				WriteLog("GPU: Write16--unaligned write @ %08X by %s [%04X]!\n", offset, whoName[who], data);
+				GPUDumpRegisters();
+			}
 		return;
 	}
 
@@ -694,13 +695,15 @@ void GPUWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 //	if ((offset >= GPU_WORK_RAM_BASE) && (offset < GPU_WORK_RAM_BASE + 0x1000))
 	if ((offset >= GPU_WORK_RAM_BASE) && (offset <= GPU_WORK_RAM_BASE + 0x0FFC))
 	{
-#ifdef GPU_DEBUG
-		if (offset & 0x03)
+		if ((offset & 0x03) && LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
 		{
 			WriteLog("GPU: Write32--unaligned write @ %08X [%08X] by %s\n", offset, data, whoName[who]);
 			GPUDumpRegisters();
 		}
-#endif	// GPU_DEBUG
+
+		// The GPU stores in its local RAM don't go through JaguarWriteWord, so they are checked here
+		if (who == GPU)
+			watch_access(offset, 4, WATCH_WRITE, data, who);
 
 		offset &= 0xFFF;
 		SET32(gpu_ram_8, offset, data);
@@ -728,11 +731,12 @@ void GPUWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 //This, however, is A-OK! ;-)
 			if (IMASKCleared)						// If IMASK was cleared,
 				GPUHandleIRQs();					// see if any other interrupts need servicing!
-#ifdef GPU_DEBUG
-			if (gpu_flags & (INT_ENA0 | INT_ENA1 | INT_ENA2 | INT_ENA3 | INT_ENA4))
-				WriteLog("GPU: Interrupt enable set by %s! Bits: %02X\n", whoName[who], (gpu_flags >> 4) & 0x1F);
-			WriteLog("GPU: REGPAGE %s...\n", (gpu_flags & REGPAGE ? "set" : "cleared"));
-#endif	// GPU_DEBUG
+			if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
+			{
+				if (gpu_flags & (INT_ENA0 | INT_ENA1 | INT_ENA2 | INT_ENA3 | INT_ENA4))
+					WriteLog("GPU: Interrupt enable set by %s! Bits: %02X\n", whoName[who], (gpu_flags >> 4) & 0x1F);
+				WriteLog("GPU: REGPAGE %s...\n", (gpu_flags & REGPAGE ? "set" : "cleared"));
+			}
 			break;
 		}
 		case 0x04:
@@ -747,9 +751,7 @@ void GPUWriteLong(uint32_t offset, uint32_t data, uint32_t who/*=UNKNOWN*/)
 			break;
 		case 0x10:
 			gpu_pc = data;
-#ifdef GPU_DEBUG
-WriteLog("GPU: %s setting GPU PC to %08X %s\n", whoName[who], gpu_pc, (GPU_RUNNING ? "(GPU is RUNNING!)" : ""));//*/
-#endif	// GPU_DEBUG
+LOGCAT(LOG_CAT_GPU, LOG_LEVEL_DEBUG, "GPU: %s setting GPU PC to %08X %s\n", whoName[who], gpu_pc, (GPU_RUNNING ? "(GPU is RUNNING!)" : ""));
 			break;
 		case 0x14:
 		{
@@ -806,14 +808,15 @@ WriteLog("GPU: %s setting GPU PC to %08X %s\n", whoName[who], gpu_pc, (GPU_RUNNI
 			if (gpu_control & 0x18)
 				GPUExec(1);
 #endif	// #ifndef GPU_SINGLE_STEPPING
-#ifdef GPU_DEBUG
-WriteLog("Write to GPU CTRL by %s: %08X ", whoName[who], data);
-if (GPU_RUNNING)
-	WriteLog(" --> Starting to run at %08X by %s...", gpu_pc, whoName[who]);
-else
-	WriteLog(" --> Stopped by %s! (GPU_PC: %08X)", whoName[who], gpu_pc);
-WriteLog("\n");
-#endif	// GPU_DEBUG
+if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
+{
+	WriteLog("Write to GPU CTRL by %s: %08X ", whoName[who], data);
+	if (GPU_RUNNING)
+		WriteLog(" --> Starting to run at %08X by %s...", gpu_pc, whoName[who]);
+	else
+		WriteLog(" --> Stopped by %s! (GPU_PC: %08X)", whoName[who], gpu_pc);
+	WriteLog("\n");
+}
 //if (GPU_RUNNING)
 //	GPUDumpDisassembly();
 /*if (GPU_RUNNING)
@@ -972,7 +975,7 @@ void GPUHandleIRQs(void)
 	if (bits & 0x10)
 		which = 4;
 
-	if (start_logging)
+	if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
 		WriteLog("GPU: Generating IRQ #%i\n", which);
 
 	// set the interrupt flag
@@ -993,7 +996,7 @@ void GPUHandleIRQs(void)
 
 void GPUSetIRQLine(int irqline, int state)
 {
-	if (start_logging)
+	if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_DEBUG))
 		WriteLog("GPU: Setting GPU IRQ line #%i\n", irqline);
 
 	uint32_t mask = 0x0040 << irqline;
@@ -1308,13 +1311,15 @@ if (gpu_pc == 0xF034DE)
 	GPUDumpDisassembly();
 }//*/
 
-if (gpu_start_log)
+if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_TRACE))
 {
 //	gpu_reset_stats();
 static char buffer[512];
 dasmjag(JAGUAR_GPU, buffer, gpu_pc);
 WriteLog("GPU: [%08X] %s (RM=%08X, RN=%08X) -> ", gpu_pc, buffer, RM, RN);
 }//*/
+		if (traceActive[TRACE_GPU])
+			TraceRISC(TRACE_GPU, gpu_pc, opcode, gpu_opcode_cycles[index], gpu_reg);
 //$E400 -> 1110 01 -> $39 -> 57
 //GPU #1
 		gpu_pc += 2;
@@ -1350,7 +1355,7 @@ if (gpu_pc == 0xF03548 && firstTime)
 
 		cycles -= gpu_opcode_cycles[index];
 		gpu_opcode_use[index]++;
-if (gpu_start_log)
+if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_TRACE))
 	WriteLog("(RM=%08X, RN=%08X)\n", RM, RN);//*/
 if ((gpu_pc < 0xF03000 || gpu_pc > 0xF03FFF) && !tripwire)
 {
@@ -1426,7 +1431,7 @@ const char * condition[32] =
 	if (doGPUDis)
 		WriteLog("Branched!\n");
 #endif
-if (gpu_start_log)
+if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_TRACE))
 	WriteLog("    --> JUMP: Branch taken.\n");
 		uint32_t delayed_pc = RM;
 		GPUExec(1);
@@ -1481,7 +1486,7 @@ const char * condition[32] =
 	if (doGPUDis)
 		WriteLog("Branched!\n");
 #endif
-if (gpu_start_log)
+if (LOG_ENABLED(LOG_CAT_GPU, LOG_LEVEL_TRACE))
 	WriteLog("    --> JR: Branch taken.\n");
 		int32_t offset = (IMM_1 & 0x10 ? 0xFFFFFFF0 | IMM_1 : IMM_1);		// Sign extend IMM_1
 		int32_t delayed_pc = gpu_pc + (offset * 2);
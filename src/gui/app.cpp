@@ -25,11 +25,14 @@
 
 #include <SDL.h>
 #include <QtWidgets/QApplication>
+#include "cdintf.h"
 #include "gamepad.h"
 #include "log.h"
 #include "mainwin.h"
 #include "profile.h"
+#include "romsweep.h"
 #include "settings.h"
+#include "trace.h"
 #include "version.h"
 #include "debugger/DBGManager.h"
 
@@ -42,6 +45,17 @@
 // Function prototypes...
 static bool ParseCommandLine(int argc, char * argv[]);
 static void ParseOptions(int argc, char * argv[]);
+static int RunSweep(int argc, char * argv[]);
+static bool OptionTakesValue(const char * option);
+
+
+// Switches followed by a value; shared by the parser and the ROM sweep, which
+// forwards the emulation ones (with their value) to its workers
+static const char * valueOptions[] = {
+	"--cd-image",
+	"--sweep", "--sweep-frames", "--sweep-jobs", "--sweep-report", "--sweep-audio", "--sweep-worker",
+	NULL
+};
 
 
 //hm. :-/
@@ -51,6 +65,10 @@ bool noUntunedTankPlease = false;
 bool loadAndGo = false;
 bool useLogfile = false;
 QString filename;
+// ROM sweep (headless) parameters
+QString sweepDir, sweepWorkerFile, sweepReport, sweepAudioDir;
+uint32_t sweepFrames = 600;
+int sweepJobs = 0;
 
 // Here's the main application loop--short and simple...
 int main(int argc, char * argv[])
@@ -98,6 +116,10 @@ int main(int argc, char * argv[])
 
 	int retVal = -1;							// Default is failure
 
+	// Sweep workers run side by side in the same directory, so they don't log
+	if (!sweepWorkerFile.isEmpty())
+		useLogfile = false;
+
 	if (useLogfile)
 	{
 		bool success = (bool)LogInit("./virtualjaguar.log");	// Init logfile
@@ -106,6 +128,14 @@ int main(int argc, char * argv[])
 			printf("Failed to open virtualjaguar.log for writing!\n");
 	}
 
+	// The ROM sweep runs without GUI, nor SDL
+	if (!sweepDir.isEmpty() || !sweepWorkerFile.isEmpty())
+	{
+		retVal = RunSweep(argc, argv);
+		LogDone();
+		return retVal;
+	}
+
 	// Set up SDL library
 	if (SDL_Init(SDL_INIT_JOYSTICK | SDL_INIT_AUDIO | SDL_INIT_TIMER) < 0)
 	{
@@ -169,8 +199,17 @@ App::App(int & argc, char * argv[]): QApplication(argc, argv)
 //
 bool ParseCommandLine(int argc, char * argv[])
 {
+	uint32_t traceUnits = 0;
+	bool traceRegisters = false;
+
 	for(int i=1; i<argc; i++)
 	{
+		if (OptionTakesValue(argv[i]) && ((i + 1) >= argc))
+		{
+			printf("Missing value for %s\n", argv[i]);
+			return false;
+		}
+
 		if ((strcmp(argv[i], "--help") == 0) || (strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "-?") == 0))
 		{
 			printf(
@@ -203,12 +242,31 @@ bool ParseCommandLine(int argc, char * argv[])
 				"   --no-blur         Disable GL bilinear filtering\n"
 				"   --log         -l  Create and use log file\n"
 				"   --no-log          Do not use log file (default)\n"
+				"   --log-<category>[=<level>]\n"
+				"                     Log <category> (m68k, gpu, dsp, blitter, op, tom,\n"
+				"                     jerry, cdrom, eeprom, dac, memory, or all) up to\n"
+				"                     <level> (off, error, warning, info, debug, trace;\n"
+				"                     default: debug), and use log file\n"
+				"   --trace           Record the 68K, GPU and DSP execution trace\n"
+				"   --trace-m68k, --trace-gpu, --trace-dsp\n"
+				"                     Record the execution trace of this unit only\n"
+				"   --trace-regs      Record the register changes in the trace too\n"
+				"   --cd-image <file> Use this CUE/BIN or ISO image as the Jaguar CD\n"
 				"   --help        -h  Show this message\n"
 				"                 -?  Show this message\n"
 				"   --es-all          Erase all settings\n"
 				"   --es-ui           Erase UI settings only\n"
 				"   --es-alpine       Erase alpine mode settings only\n"
 				"   --es-debugger     Erase debugger mode settings only\n"
+				"   --sweep <dir>     Run every file of <dir> without GUI and report\n"
+				"   --sweep-frames <n>\n"
+				"                     Number of frames to run per file (default 600)\n"
+				"   --sweep-jobs <n>  Number of files run at once (default: CPU count)\n"
+				"   --sweep-report <file>\n"
+				"                     Write the report as CSV, or JSON for a .json file\n"
+				"                     (default: CSV on stdout)\n"
+				"   --sweep-audio <dir>\n"
+				"                     Capture the audio of each file to <dir>/<file>.wav\n"
 				"   --please-dont-kill-my-computer\n"
 				"                 -z  Run Virtual Jaguar without \"snow\"\n"
 				"\n"
@@ -279,6 +337,18 @@ bool ParseCommandLine(int argc, char * argv[])
 			useLogfile = false;
 		}
 
+		// Log category level
+		if (strncmp(argv[i], "--log-", 6) == 0)
+		{
+			if (!LogSetLevel(&argv[i][6]))
+			{
+				printf("Unknown log category or level: %s\n", argv[i]);
+				return false;
+			}
+
+			useLogfile = true;
+		}
+
 		// DRAM size max
 		if (strcmp(argv[i], "--dram-max") == 0)
 		{
@@ -286,6 +356,52 @@ bool ParseCommandLine(int argc, char * argv[])
 			vjs.DRAM_size = 0x800000;
 		}
 
+		// Execution trace
+		if (strcmp(argv[i], "--trace") == 0)
+			traceUnits = (1 << TRACE_MAX) - 1;
+		else if (strcmp(argv[i], "--trace-regs") == 0)
+			traceRegisters = true;
+		else if (strncmp(argv[i], "--trace-", 8) == 0)
+		{
+			for(int j=0; j<TRACE_MAX; j++)
+			{
+				if (strcmp(&argv[i][8], traceUnitName[j]) == 0)
+					traceUnits |= 1 << j;
+			}
+		}
+
+		// CD image, used by the CD unit instead of the drive
+		if (strcmp(argv[i], "--cd-image") == 0)
+		{
+			CDIntfSetImage(argv[++i]);
+			continue;
+		}
+
+		// ROM sweep, these switches take a value
+		if (strncmp(argv[i], "--sweep", 7) == 0)
+		{
+			if (strcmp(argv[i], "--sweep") == 0)
+				sweepDir = argv[i + 1];
+			else if (strcmp(argv[i], "--sweep-frames") == 0)
+				sweepFrames = strtoul(argv[i + 1], NULL, 0);
+			else if (strcmp(argv[i], "--sweep-jobs") == 0)
+				sweepJobs = atoi(argv[i + 1]);
+			else if (strcmp(argv[i], "--sweep-report") == 0)
+				sweepReport = argv[i + 1];
+			else if (strcmp(argv[i], "--sweep-audio") == 0)
+				sweepAudioDir = argv[i + 1];
+			else if (strcmp(argv[i], "--sweep-worker") == 0)
+				sweepWorkerFile = argv[i + 1];
+			else
+			{
+				printf("Unknown ROM sweep switch: %s\n", argv[i]);
+				return false;
+			}
+
+			i++;
+			continue;
+		}
+
 		// Check for filename
 		if (argv[i][0] != '-')
 		{
@@ -294,6 +410,12 @@ bool ParseCommandLine(int argc, char * argv[])
 		}
 	}
 
+	if (traceUnits)
+	{
+		printf("Execution trace enabled.\n");
+		TraceStart(traceUnits, traceRegisters);
+	}
+
 	return true;
 }
 
@@ -377,6 +499,54 @@ void ParseOptions(int argc, char * argv[])
 	}
 }
 
+
+//
+// Headless ROM sweep, either the master or one of its workers
+//
+int RunSweep(int argc, char * argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	RomSweepDefaults();
+	ParseOptions(argc, argv);
+
+	if (!sweepWorkerFile.isEmpty())
+		return RomSweepWorker(sweepWorkerFile, sweepFrames, sweepAudioDir);
+
+	// The workers get the same emulation switches as the master, with their value
+	QStringList options;
+
+	for(int i=1; i<argc; i++)
+	{
+		if (OptionTakesValue(argv[i]))
+		{
+			if (strncmp(argv[i], "--sweep", 7) != 0)
+				options << argv[i] << argv[i + 1];
+
+			i++;
+		}
+		else if (argv[i][0] == '-')
+			options << argv[i];
+	}
+
+	return RomSweepRun(sweepDir, sweepFrames, sweepJobs, sweepReport, sweepAudioDir, options);
+}
+
+
+//
+// Check if a switch is followed by a value
+//
+bool OptionTakesValue(const char * option)
+{
+	for(int i=0; valueOptions[i]; i++)
+	{
+		if (strcmp(option, valueOptions[i]) == 0)
+			return true;
+	}
+
+	return false;
+}
+
 #if 0
 	bool useJoystick;
 	int32 joyport;								// Joystick port
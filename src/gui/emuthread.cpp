@@ -0,0 +1,239 @@
+//
+// emuthread.cpp - Emulation thread
+//
+
+// The Jaguar frames are run here rather than in the GUI timer, so that GUI
+// work (debug windows refresh, status bar, GL upload) can't steal emulation
+// time. Each frame is drawn into the back buffer of a triple buffer, and the
+// GUI only picks up the most recent finished frame when it repaints.
+//
+// The thread only runs between two frames' boundaries: Pause() waits for the
+// frame in progress to finish, after which the core can be used from the GUI
+// thread again (power, reset, load, frame advance...).
+//
+// Pacing is done against the host high resolution clock using the real
+// Jaguar frame period (525 halflines of 31.777 us, or 625 of 32 us), instead
+// of the rounded 16/20 ms of the GUI timer.
+//
+// JERRY is run here too, after each frame, filling the DAC ring buffer that
+// the audio thread plays from. In fast forward, frames are run back to back
+// with no pacing at all, and the DAC drops the samples (DACSetFastForward).
+//
+// With the automatic frame skip, a frame is not drawn when the previous one
+// ended past its deadline; fast forward always counts as late. Skipped frames
+// are not published, so the GUI keeps showing the last drawn one.
+
+#include "emuthread.h"
+
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <QtCore/QCoreApplication>
+#include "dac.h"
+#include "jaguar.h"
+#include "m68000/m68kinterface.h"
+#include "settings.h"
+#include "tom.h"
+
+#define FRAME_BUFFER_SIZE		(1024 * 512)		// Same size as the GL texture
+#define FRAME_PERIOD_NTSC		16683				// In usec
+#define FRAME_PERIOD_PAL		20000
+#define MAX_FRAMES_LATE			4					// Beyond that, we don't try to catch up
+
+
+TripleBuffer::TripleBuffer(uint32_t size, uint32_t lines): back(0), front(1), ready(2)
+{
+	for(int i=0; i<3; i++)
+	{
+		buffer[i] = new uint32_t[size];
+		memset(buffer[i], 0, size * sizeof(uint32_t));
+		lineHash[i] = new uint32_t[lines];
+		memset(lineHash[i], 0, lines * sizeof(uint32_t));
+	}
+}
+
+
+TripleBuffer::~TripleBuffer()
+{
+	for(int i=0; i<3; i++)
+	{
+		delete[] buffer[i];
+		delete[] lineHash[i];
+	}
+}
+
+
+//
+// Hand the back buffer over as the latest frame, and take the previous latest
+// (or the one the reader just gave back) to draw the next one
+//
+void TripleBuffer::Publish(void)
+{
+	back = ready.exchange(back | FRESH) & INDEX_MASK;
+}
+
+
+//
+// Get the latest frame, if there is one newer than the front buffer
+//
+bool TripleBuffer::Acquire(void)
+{
+	if (!(ready.load() & FRESH))
+		return false;
+
+	front = ready.exchange(front) & INDEX_MASK;
+	return true;
+}
+
+
+EmuThread::EmuThread(QObject * parent/*= 0*/): QThread(parent), go(false),
+	idle(true), abort(false), fastForward(false), frames(FRAME_BUFFER_SIZE, VIRTUAL_SCREEN_LINES), frameCount(0)
+{
+}
+
+
+EmuThread::~EmuThread()
+{
+	Stop();
+}
+
+
+//
+// Stop running frames, and wait for the frame in progress to finish.
+// Returns true if the thread was running frames.
+//
+bool EmuThread::Pause(void)
+{
+	mutex.lock();
+	bool wasRunning = go || !idle;
+	go = false;
+
+	while (!idle)
+	{
+		// The core may be waiting on the GUI thread (alert box) to end its
+		// frame, so keep delivering these calls while we wait for it
+		idleCondition.wait(&mutex, 5);
+		mutex.unlock();
+		QCoreApplication::sendPostedEvents(NULL, QEvent::MetaCall);
+		mutex.lock();
+	}
+
+	mutex.unlock();
+	return wasRunning;
+}
+
+
+void EmuThread::Resume(void)
+{
+	QMutexLocker locker(&mutex);
+
+	if (!go)
+	{
+		go = true;
+		wakeCondition.wakeAll();
+	}
+}
+
+
+void EmuThread::Stop(void)
+{
+	Pause();
+	mutex.lock();
+	abort = true;
+	wakeCondition.wakeAll();
+	mutex.unlock();
+
+	wait();
+}
+
+
+//
+// Run the frames as fast as possible, or at the Jaguar rate. The caller has
+// to tell the DAC as well.
+//
+void EmuThread::SetFastForward(bool state)
+{
+	bool wasRunning = Pause();
+	mutex.lock();
+	fastForward = state;
+	mutex.unlock();
+
+	if (wasRunning)
+		Resume();
+}
+
+
+void EmuThread::run(void)
+{
+	std::chrono::steady_clock::time_point nextFrame;
+	bool late = false;
+
+	while (true)
+	{
+		mutex.lock();
+
+		if (!go || abort)
+		{
+			idle = true;
+			idleCondition.wakeAll();
+
+			while (!go && !abort)
+				wakeCondition.wait(&mutex);
+
+			// Restart the pacing from now on
+			nextFrame = std::chrono::steady_clock::now();
+			late = false;
+		}
+
+		if (abort)
+		{
+			idle = true;
+			idleCondition.wakeAll();
+			mutex.unlock();
+			break;
+		}
+
+		idle = false;
+		bool noPacing = fastForward;
+		mutex.unlock();
+
+		bool render = JaguarFrameSkip(late || noPacing);
+		JaguarSetScreenBuffer(frames.Back());
+		JaguarSetScreenLineHash(frames.BackLineHash());
+		JaguarExecuteNew();
+
+		if (vjs.DSPEnabled)
+			DACRunFrame();
+
+		if (render)
+			frames.Publish();
+
+		frameCount++;
+
+		// Breakpoint, or alert: the GUI takes it from here
+		if (M68KDebugHaltStatus())
+		{
+			mutex.lock();
+			go = false;
+			mutex.unlock();
+			continue;
+		}
+
+		if (noPacing)
+		{
+			nextFrame = std::chrono::steady_clock::now();
+			continue;
+		}
+
+		std::chrono::microseconds period(vjs.hardwareTypeNTSC ? FRAME_PERIOD_NTSC : FRAME_PERIOD_PAL);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		nextFrame += period;
+
+		late = (nextFrame < now);
+
+		if (nextFrame < (now - (period * MAX_FRAMES_LATE)))
+			nextFrame = now;
+		else if (!late)
+			std::this_thread::sleep_until(nextFrame);
+	}
+}
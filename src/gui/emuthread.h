@@ -0,0 +1,72 @@
+//
+// emuthread.h: Header file
+//
+
+#ifndef __EMUTHREAD_H__
+#define __EMUTHREAD_H__
+
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+#include <atomic>
+#include <stdint.h>
+
+// Three frame buffers shared between one writer and one reader without locks:
+// the writer always has a buffer to draw into, the reader always has a
+// complete frame to show, and the third one holds the latest finished frame.
+// Each frame comes with the hashes of its lines, which travel along with it.
+class TripleBuffer
+{
+	public:
+		TripleBuffer(uint32_t size, uint32_t lines);
+		~TripleBuffer();
+
+		// Writer side
+		uint32_t * Back(void) { return buffer[back]; }
+		uint32_t * BackLineHash(void) { return lineHash[back]; }
+		void Publish(void);
+		// Reader side
+		uint32_t * Front(void) { return buffer[front]; }
+		uint32_t * FrontLineHash(void) { return lineHash[front]; }
+		bool Acquire(void);
+
+	private:
+		enum { INDEX_MASK = 0x03, FRESH = 0x04 };
+		uint32_t * buffer[3];
+		uint32_t * lineHash[3];
+		int back, front;
+		std::atomic<int> ready;
+};
+
+// Runs the Jaguar frames away from the GUI thread, paced on the host clock
+class EmuThread: public QThread
+{
+	public:
+		EmuThread(QObject * parent = 0);
+		~EmuThread();
+
+		bool Pause(void);
+		void Resume(void);
+		void Stop(void);
+		void SetFastForward(bool state);
+		uint32_t * Frame(void) { return frames.Front(); }
+		uint32_t * FrameLineHash(void) { return frames.FrontLineHash(); }
+		bool NewFrame(void) { return frames.Acquire(); }
+		uint32_t FrameCount(void) { return frameCount; }
+
+	protected:
+		void run(void);
+
+	private:
+		QMutex mutex;
+		QWaitCondition wakeCondition;
+		QWaitCondition idleCondition;
+		bool go;
+		bool idle;
+		bool abort;
+		bool fastForward;
+		TripleBuffer frames;
+		std::atomic<uint32_t> frameCount;
+};
+
+#endif	// __EMUTHREAD_H__
@@ -117,6 +117,17 @@ void FileListModel::AddData(unsigned long index, QString str, QImage img, unsign
 	endInsertRows();
 }
 
+void FileListModel::AddData(const QVector<FileListData> & files)
+{
+	if (files.isEmpty())
+		return;
+
+	// One insertion for the whole batch
+	beginInsertRows(QModelIndex(), list.size(), list.size() + files.size() - 1);
+	list.insert(list.end(), files.constBegin(), files.constEnd());
+	endInsertRows();
+}
+
 void FileListModel::ClearData(void)
 {
 	if (list.size() == 0)
@@ -48,6 +48,7 @@ class FileListModel: public QAbstractListModel
 //		void AddData(unsigned long);
 		void AddData(unsigned long, QString, QImage, unsigned long);
 		void AddData(unsigned long, QString, QImage, unsigned long, bool, uint32_t, uint32_t);
+		void AddData(const QVector<FileListData> &);
 		void ClearData(void);
 
 //		FileListData GetData(const QModelIndex & index) const;
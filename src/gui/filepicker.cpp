@@ -186,10 +186,12 @@ printf("VSB size: %u, %u\n", sbSize3.width(), sbSize3.height());
 	fileThread = new FileThread(this);
 //	connect(fileThread, SIGNAL(FoundAFile(unsigned long)), this, SLOT(AddFileToList(unsigned long)));
 //	connect(fileThread, SIGNAL(FoundAFile2(unsigned long, QString, QImage *, unsigned long)), this, SLOT(AddFileToList2(unsigned long, QString, QImage *, unsigned long)));
-	connect(fileThread, SIGNAL(FoundAFile3(unsigned long, QString, QImage *,
-		unsigned long, bool, unsigned long, unsigned long)), this,
-		SLOT(AddFileToList3(unsigned long, QString, QImage *, unsigned long,
-		bool, unsigned long, unsigned long)));
+//	connect(fileThread, SIGNAL(FoundAFile3(unsigned long, QString, QImage *,
+//		unsigned long, bool, unsigned long, unsigned long)), this,
+//		SLOT(AddFileToList3(unsigned long, QString, QImage *, unsigned long,
+//		bool, unsigned long, unsigned long)));
+	connect(fileThread, SIGNAL(FoundFiles(QVector<FileListData> *)), this,
+		SLOT(AddFilesToList(QVector<FileListData> *)));
 
 // Let's defer this to the main window, so we can have some control over when this is done.
 //	fileThread->Go();
@@ -282,6 +284,16 @@ void FilePickerWindow::AddFileToList3(unsigned long index, QString str, QImage *
 		model->AddData(index, str, QImage(), size, haveUniversalHeader, fileType, crc);
 }
 
+//
+// This slot gets called by the FileThread with a batch of files found; they're
+// all added to the model at once, so the list is laid out only once for them.
+//
+void FilePickerWindow::AddFilesToList(QVector<FileListData> * files)
+{
+	model->AddData(*files);
+	delete files;
+}
+
 void FilePickerWindow::LoadButtonPressed(void)
 {
 	// TODO: Get the text of the current selection, call the MainWin slot for loading
@@ -3,6 +3,7 @@
 //
 
 #include <QtWidgets/QtWidgets>
+#include "filelistmodel.h"
 
 // Forward declarations
 class QListWidget;
@@ -24,6 +25,7 @@ class FilePickerWindow: public QWidget
 		void AddFileToList(unsigned long index);
 		void AddFileToList2(unsigned long index, QString, QImage *, unsigned long size);
 		void AddFileToList3(unsigned long index, QString, QImage *, unsigned long size, bool, unsigned long, unsigned long);
+		void AddFilesToList(QVector<FileListData> * files);
 		void UpdateSelection(const QModelIndex &, const QModelIndex &);
 		void LoadButtonPressed(void);
 		void CatchDoubleClick(const QModelIndex &);
@@ -27,8 +27,21 @@
 
 #define VERBOSE_LOGGING
 
-FileThread::FileThread(QObject * parent/*= 0*/): QThread(parent), abort(false)
+// The library index is a QDataStream file: magic, version & entry count,
+// followed by the path and the LibraryEntry fields of every entry
+#define LIBRARY_INDEX_FILE		"/romlibrary.idx"
+#define LIBRARY_INDEX_MAGIC		0x564A4C49			// 'VJLI'
+#define LIBRARY_INDEX_VERSION	1
+
+// Files handed to the file picker at once, and longest wait (in ms) before
+// handing over what's been found so far
+#define FILETHREAD_BATCH_SIZE	64
+#define FILETHREAD_BATCH_TIME	100
+
+FileThread::FileThread(QObject * parent/*= 0*/): QThread(parent), abort(false),
+	libraryIndexLoaded(false), libraryIndexChanged(false), batch(NULL)
 {
+	qRegisterMetaType<QVector<FileListData> *>("QVector<FileListData>*");
 }
 
 FileThread::~FileThread()
@@ -39,6 +52,7 @@ FileThread::~FileThread()
 	mutex.unlock();
 
 	wait();
+	delete batch;
 }
 
 void FileThread::Go(bool allowUnknown/*= false*/)
@@ -62,16 +76,47 @@ Ideally, the label will go into the archive along with the ROM image, but that's
 for the future...
 Maybe box art, screenshots will go as well...
 The future is NOW! :-)
+
+Files are identified by a pool of workers, and sent to the file picker in
+batches.
+
+What's found out about each file is kept in an index file, along with the
+file's size and modification time; so a file is only read (and unzipped) again
+when it's new or has changed since the last scan.
 */
 
+//
+// A worker of the scan pool: identifies one of the files the library index
+// knows nothing about
+//
+class FileIdentifier: public QRunnable
+{
+	public:
+		FileIdentifier(FileThread * t, int n): thread(t), item(n) {}
+		void run(void) { thread->IdentifyPendingFile(item); }
+
+	private:
+		FileThread * thread;
+		int item;
+};
+
 //
 // Here's the thread's actual execution path...
 //
 void FileThread::run(void)
 {
+	if (!libraryIndexLoaded)
+		LoadLibraryIndex();
+
 	QDir romDir(vjs.ROMPath);
-	QFileInfoList list = romDir.entryInfoList();
+	QFileInfoList list = romDir.entryInfoList(QDir::Files);
+	libraryFilesSeen.clear();
+	pendingFiles.clear();
+	pendingEntries.clear();
+	doneFiles.clear();
 
+	// Files found in the library index go straight into the batch, the others
+	// are put aside for the workers
 	for(int i=0; i<list.size(); i++)
 	{
 		if (abort)
@@ -86,31 +131,185 @@ printf("FileThread: Aborting!!!\n");
 
 		HandleFile(list.at(i));
 	}
+
+	FlushBatch();
+
+	// The reading, unzipping, CRC & label scaling of the files are done by the
+	// pool of workers
+	pendingEntries.resize(pendingFiles.size());
+
+	for(int i=0; i<(int)pendingFiles.size(); i++)
+	{
+		pendingEntries[i].size = pendingFiles[i].size();
+		pendingEntries[i].modified = pendingFiles[i].lastModified().toMSecsSinceEpoch();
+		workers.start(new FileIdentifier(this, i));
+	}
+
+	// Results are handed to the file picker in batches, so its list isn't laid
+	// out again for every file found
+	QElapsedTimer batchTimer;
+	batchTimer.start();
+
+	for(int remaining=pendingFiles.size(); remaining>0;)
+	{
+		doneMutex.lock();
+
+		if (doneFiles.isEmpty())
+			doneCondition.wait(&doneMutex, FILETHREAD_BATCH_TIME);
+
+		QQueue<int> identified;
+		identified.swap(doneFiles);
+		doneMutex.unlock();
+
+		while (!identified.isEmpty())
+		{
+			int n = identified.dequeue();
+			QString path = pendingFiles[n].canonicalFilePath();
+			libraryIndex.insert(path, pendingEntries[n]);
+			libraryIndexChanged = true;
+			AddToBatch(path, pendingEntries[n]);
+			remaining--;
+		}
+
+		if ((batch && (batch->size() >= FILETHREAD_BATCH_SIZE))
+			|| (batchTimer.elapsed() >= FILETHREAD_BATCH_TIME))
+		{
+			FlushBatch();
+			batchTimer.restart();
+		}
+	}
+
+	FlushBatch();
+
+	// The workers skip what's left when aborting, don't save the index then
+	if (abort)
+		return;
+
+	// Forget about the files that went away from the folder
+	QString romFolder = romDir.canonicalPath();
+	QMutableHashIterator<QString, LibraryEntry> i(libraryIndex);
+
+	while (i.hasNext())
+	{
+		i.next();
+
+		if ((QFileInfo(i.key()).absolutePath() == romFolder) && !libraryFilesSeen.contains(i.key()))
+		{
+			i.remove();
+			libraryIndexChanged = true;
+		}
+	}
+
+	if (libraryIndexChanged)
+		SaveLibraryIndex();
 }
 
 //
-// This handles file identification and ZIP extraction.
+// This looks the file up in the library index; if it's new or has changed since
+// it was indexed, it's left to the workers.
 //
 void FileThread::HandleFile(QFileInfo fileInfo)
 {
-	// Really, need to come up with some kind of cacheing scheme here, so we don't
-	// fish through these files every time we run VJ :-P
-#ifdef _MSC_VER
-#pragma message("Warning: !!! Need to come up with some kind of cacheing scheme here !!!")
-#else
-#warning "!!! Need to come up with some kind of cacheing scheme here !!!"
-#endif // _MSC_VER
+	QString path = fileInfo.canonicalFilePath();
+	QHash<QString, LibraryEntry>::const_iterator entry = libraryIndex.constFind(path);
+	libraryFilesSeen.insert(path);
+
+	if ((entry == libraryIndex.constEnd()) || (entry->size != fileInfo.size())
+		|| (entry->modified != fileInfo.lastModified().toMSecsSinceEpoch()))
+		pendingFiles.push_back(fileInfo);
+	else
+		AddToBatch(path, *entry);
+}
+
+//
+// Run by the workers
+//
+void FileThread::IdentifyPendingFile(int n)
+{
+	if (abort)
+		pendingEntries[n].softwareSize = 0;
+	else
+		IdentifyFile(pendingFiles[n], pendingEntries[n]);
+
+	QMutexLocker locker(&doneMutex);
+	doneFiles.enqueue(n);
+	doneCondition.wakeOne();
+}
+
+//
+// Add an identified file to the next batch for the file picker, unless it's
+// filtered out
+//
+void FileThread::AddToBatch(QString path, const LibraryEntry & entry)
+{
+	if (entry.softwareSize == 0)
+		return;
+
+	uint32_t index = FindCRCIndexInFileList(entry.crc);
+
+	// Here we filter out files that are *not* in the DB and of unknown type,
+	// and BIOS files. If desired, this can be overriden with a config option.
+	if ((index == 0xFFFFFFFF) && (entry.fileType == JST_NONE))
+	{
+		// If we allow unknown software, we pass the (-1) index on, otherwise...
+		if (!allowUnknownSoftware)
+			return;								// CRC wasn't found, so bail...
+	}
+	else if ((index != 0xFFFFFFFF) && romList[index].flags & FF_BIOS)
+		return;
+
+	// The batch is created on the heap, and deleted by the file picker once it
+	// has copied it over to its model
+	if (batch == NULL)
+		batch = new QVector<FileListData>;
+
+	FileListData data;
+	data.dbIndex = index;
+	data.fileSize = entry.softwareSize;
+	data.filename = path;
+	data.label = entry.label;
+	data.hasUniversalHeader = entry.universalHeader;
+	data.fileType = entry.fileType;
+	data.crc = entry.crc;
+	batch->append(data);
+}
+
+//
+// Hand the current batch, if any, over to the file picker
+//
+void FileThread::FlushBatch(void)
+{
+	if (batch == NULL)
+		return;
+
+	emit FoundFiles(batch);
+	batch = NULL;
+}
+
+//
+// This handles file identification and ZIP extraction.
+//
+void FileThread::IdentifyFile(QFileInfo fileInfo, LibraryEntry & entry)
+{
 	bool haveZIPFile = (fileInfo.suffix().compare("zip", Qt::CaseInsensitive) == 0
 		? true : false);
 	uint32_t fileSize = 0;
 	uint8_t * buffer = NULL;
+	uint32_t zipCRC = 0;
+
+	entry.softwareSize = 0;
+	entry.crc = 0;
+	entry.fileType = JST_NONE;
+	entry.universalHeader = false;
 
 	if (haveZIPFile)
 	{
 		// ZIP files are special: They contain more than just the software now... ;-)
 		// So now we fish around inside them to pull out the stuff we want.
 		// Probably also need more stringent error checking as well... :-O
-		fileSize = GetFileFromZIP(fileInfo.filePath().toUtf8(), FT_SOFTWARE, buffer);
+		// The CRC comes along, computed while uncompressing. The ZIP cache is
+		// left to the files actually loaded, else a scan would fill it up.
+		fileSize = GetFileFromZIP(fileInfo.filePath().toUtf8(), FT_SOFTWARE, buffer, &zipCRC);
 
 		if (fileSize == 0)
 			return;
@@ -133,38 +332,22 @@ void FileThread::HandleFile(QFileInfo fileInfo)
 	}
 
 	// Try to divine the file type by size & header
-	int fileType = ParseFileType(buffer, fileSize);
+	entry.fileType = ParseFileType(buffer, fileSize);
 
 	// Check for Alpine ROM w/Universal Header
-	bool foundUniversalHeader = HasUniversalHeader(buffer, fileSize);
-	uint32_t crc;
+	entry.universalHeader = HasUniversalHeader(buffer, fileSize);
 
 //printf("FileThread: About to calc checksum on file with size %u... (buffer=%08X)\n", size, buffer);
-	if (foundUniversalHeader)
-		crc = crc32_calcCheckSum(buffer + 8192, fileSize - 8192);
+	if (entry.universalHeader)
+		entry.crc = crc32_calcCheckSum(buffer + 8192, fileSize - 8192);
+	else if (haveZIPFile)
+		entry.crc = zipCRC;
 	else
-		crc = crc32_calcCheckSum(buffer, fileSize);
+		entry.crc = crc32_calcCheckSum(buffer, fileSize);
 
-	uint32_t index = FindCRCIndexInFileList(crc);
+	entry.softwareSize = fileSize;
 	delete[] buffer;
 
-	// Here we filter out files that are *not* in the DB and of unknown type,
-	// and BIOS files. If desired, this can be overriden with a config option.
-	if ((index == 0xFFFFFFFF) && (fileType == JST_NONE))
-	{
-		// If we allow unknown software, we pass the (-1) index on, otherwise...
-		if (!allowUnknownSoftware)
-			return;								// CRC wasn't found, so bail...
-	}
-	else if ((index != 0xFFFFFFFF) && romList[index].flags & FF_BIOS)
-		return;
-
-//Here's a little problem. When we create the image here and pass it off to FilePicker,
-//we can clobber this image before we have a chance to copy it out in the FilePicker function
-//because we can be back here before FilePicker can respond.
-// So now we create the image on the heap, problem solved. :-)
-	QImage * img = NULL;
-
 	// See if we can fish out a label. :-)
 	if (haveZIPFile)
 	{
@@ -175,16 +358,12 @@ void FileThread::HandleFile(QFileInfo fileInfo)
 		{
 			QImage label;
 			bool successful = label.loadFromData(buffer, size);
-			img = new QImage;
-			*img = label.scaled(365, 168, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-//printf("FT: Label %s: %ux%u.\n", (successful ? "succeeded" : "did not succeed"), img->width(), img->height());
+			entry.label = label.scaled(365, 168, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+//printf("FT: Label %s: %ux%u.\n", (successful ? "succeeded" : "did not succeed"), entry.label.width(), entry.label.height());
 			delete[] buffer;
 		}
-//printf("FileThread: Attempted to load image. Size: %u x %u...\n", img.width(), img.height());
+//printf("FileThread: Attempted to load image. Size: %u x %u...\n", entry.label.width(), entry.label.height());
 	}
-
-//	emit FoundAFile2(index, fileInfo.canonicalFilePath(), img, fileSize);
-	emit FoundAFile3(index, fileInfo.canonicalFilePath(), img, fileSize, foundUniversalHeader, fileType, crc);
 }
 
 //
@@ -208,3 +387,73 @@ uint32_t FileThread::FindCRCIndexInFileList(uint32_t crc)
 
 	return 0xFFFFFFFF;
 }
+
+//
+// Load the library index saved by a previous scan, if any
+//
+void FileThread::LoadLibraryIndex(void)
+{
+	libraryIndexLoaded = true;
+	libraryIndexChanged = false;
+	libraryIndex.clear();
+
+	QFile file(QStandardPaths::writableLocation(QStandardPaths::DataLocation) + LIBRARY_INDEX_FILE);
+
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	quint32 magic, version, count;
+	stream >> magic >> version >> count;
+
+	// An index from another version is simply rebuilt
+	if ((stream.status() != QDataStream::Ok) || (magic != LIBRARY_INDEX_MAGIC)
+		|| (version != LIBRARY_INDEX_VERSION))
+	{
+		libraryIndexChanged = true;
+		return;
+	}
+
+	for(quint32 i=0; i<count; i++)
+	{
+		QString path;
+		LibraryEntry entry;
+		stream >> path >> entry.size >> entry.modified >> entry.softwareSize
+			>> entry.crc >> entry.fileType >> entry.universalHeader >> entry.label;
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			// Keep what was read fine, the rest will be scanned again
+			libraryIndexChanged = true;
+			break;
+		}
+
+		libraryIndex.insert(path, entry);
+	}
+}
+
+//
+// Save the library index, for the next scan
+//
+void FileThread::SaveLibraryIndex(void)
+{
+	QString dataPath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+	QDir().mkpath(dataPath);
+	QSaveFile file(dataPath + LIBRARY_INDEX_FILE);
+
+	if (!file.open(QIODevice::WriteOnly))
+		return;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << (quint32)LIBRARY_INDEX_MAGIC << (quint32)LIBRARY_INDEX_VERSION
+		<< (quint32)libraryIndex.size();
+
+	for(QHash<QString, LibraryEntry>::const_iterator i=libraryIndex.constBegin(); i!=libraryIndex.constEnd(); i++)
+		stream << i.key() << i->size << i->modified << i->softwareSize << i->crc
+			<< i->fileType << i->universalHeader << i->label;
+
+	if (file.commit())
+		libraryIndexChanged = false;
+}
@@ -8,11 +8,28 @@
 #include <QtCore/QtCore>
 #include <QtGui/QImage>
 #include <stdint.h>
+#include <vector>
+#include "filelistmodel.h"
+
+// What the scan found out about a file, kept in the library index so the file
+// isn't read again as long as its size and modification time don't change
+struct LibraryEntry
+{
+	qint64 size;						// Size & modification time of the file on disk
+	qint64 modified;
+	uint32_t softwareSize;				// 0 if no software was found in the file
+	uint32_t crc;
+	uint32_t fileType;
+	bool universalHeader;
+	QImage label;						// Already scaled, null if there's none
+};
 
 class FileThread: public QThread
 {
 	Q_OBJECT
 
+	friend class FileIdentifier;
+
 	public:
 		FileThread(QObject * parent = 0);
 		~FileThread();
@@ -21,18 +38,36 @@ class FileThread: public QThread
 	signals:
 //		void FoundAFile(unsigned long index);														// JPM: Not used
 //		void FoundAFile2(unsigned long index, QString filename, QImage * label, unsigned long);		// JPM: Not used
-		void FoundAFile3(unsigned long index, QString filename, QImage * label, unsigned long, bool, unsigned long, unsigned long);
+//		void FoundAFile3(unsigned long index, QString filename, QImage * label, unsigned long, bool, unsigned long, unsigned long);	// Replaced by FoundFiles
+		void FoundFiles(QVector<FileListData> * files);
 
 	protected:
 		void run(void);
 		void HandleFile(QFileInfo);
+		static void IdentifyFile(QFileInfo, LibraryEntry &);
+		void IdentifyPendingFile(int);
+		void AddToBatch(QString, const LibraryEntry &);
+		void FlushBatch(void);
 		uint32_t FindCRCIndexInFileList(uint32_t);
+		void LoadLibraryIndex(void);
+		void SaveLibraryIndex(void);
 
 	private:
 		QMutex mutex;
 		QWaitCondition condition;
 		bool abort;
 		bool allowUnknownSoftware;
+		QHash<QString, LibraryEntry> libraryIndex;
+		QSet<QString> libraryFilesSeen;
+		bool libraryIndexLoaded;
+		bool libraryIndexChanged;
+		QThreadPool workers;
+		std::vector<QFileInfo> pendingFiles;		// Files handed to the workers
+		std::vector<LibraryEntry> pendingEntries;
+		QMutex doneMutex;
+		QWaitCondition doneCondition;
+		QQueue<int> doneFiles;						// Pending files identified
+		QVector<FileListData> * batch;
 };
 
 #endif	// __FILETHREAD_H__
@@ -86,6 +86,21 @@ GeneralTab::GeneralTab(QWidget * parent/*= 0*/): QWidget(parent)
 	layout4->addWidget(useUnknownSoftware);
 	layout4->addWidget(useFastBlitter);
 
+	// Frame skip, the list index is the number of frames skipped
+	frameSkip = new QComboBox;
+	frameSkip->addItem(tr("None"));
+
+	for(int i=1; i<=FRAMESKIP_MAX; i++)
+		frameSkip->addItem(tr("%1 frame(s)").arg(i));
+
+	frameSkip->addItem(tr("Automatic"));
+
+	QHBoxLayout * layout5 = new QHBoxLayout;
+	layout5->addWidget(new QLabel(tr("Frame skip:")));
+	layout5->addWidget(frameSkip);
+	layout5->addStretch();
+	layout4->addLayout(layout5);
+
 	setLayout(layout4);
 }
 
@@ -112,6 +127,7 @@ void GeneralTab::GetSettings(void)
 	useFullScreen->setChecked(vjs.fullscreen);
 	//	generalTab->useHostAudio->setChecked(vjs.audioEnabled);
 	useFastBlitter->setChecked(vjs.useFastBlitter);
+	frameSkip->setCurrentIndex(vjs.frameSkip == FRAMESKIP_AUTO ? (FRAMESKIP_MAX + 1) : (vjs.frameSkip > FRAMESKIP_MAX ? FRAMESKIP_MAX : vjs.frameSkip));
 }
 
 
@@ -132,6 +148,7 @@ void GeneralTab::SetSettings(void)
 	vjs.fullscreen = useFullScreen->isChecked();
 	//	vjs.audioEnabled   = generalTab->useHostAudio->isChecked();
 	vjs.useFastBlitter = useFastBlitter->isChecked();
+	vjs.frameSkip = (frameSkip->currentIndex() > FRAMESKIP_MAX ? FRAMESKIP_AUTO : frameSkip->currentIndex());
 }
 
 
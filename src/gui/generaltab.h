@@ -31,6 +31,7 @@ class GeneralTab: public QWidget
 		QCheckBox *useFullScreen;
 		QCheckBox *useUnknownSoftware;
 		QCheckBox *useFastBlitter;
+		QComboBox *frameSkip;
 };
 
 #endif	// __GENERALTAB_H__
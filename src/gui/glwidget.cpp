@@ -14,11 +14,19 @@
 // JPM  06/06/2016  Visual Studio support
 //
 
+// Only the lines that changed since the last upload are sent to the texture:
+// TOM leaves a hash of each line it draws next to the screen buffer, and the
+// hashes of what has been uploaded are kept here. Identical frames (menus,
+// pause screens) aren't uploaded at all, which matters a lot on hosts with
+// software GL. Anything that draws into the buffer besides TOM has to call
+// BufferChanged().
+
 #include "glwidget.h"
 
 #include "jaguar.h"
 #include "settings.h"
 #include "tom.h"
+#include <string.h>
 
 #if defined(__GCCWIN32__) || defined(_MSC_VER)
 #if defined(_MSC_VER)
@@ -30,8 +38,9 @@
 
 
 GLWidget::GLWidget(QWidget * parent/*= 0*/): QGLWidget(parent), texture(0),
-	textureWidth(0), textureHeight(0), buffer(0), rasterWidth(326), rasterHeight(240),
-	offset(0), hideMouseTimeout(60)
+	textureWidth(0), textureHeight(0), buffer(0), frame(0), bufferLineHash(0), frameLineHash(0),
+	rasterWidth(326), rasterHeight(240), offset(0), hideMouseTimeout(60), textureLineHash(0),
+	textureLineWidth(0), textureLines(0)
 {
 	// Screen pitch has to be the texture width (in 32-bit pixels)...
 	JaguarSetScreenPitch(1024);
@@ -43,6 +52,9 @@ GLWidget::~GLWidget()
 {
 	if (buffer)
 		delete[] buffer;
+
+	delete[] bufferLineHash;
+	delete[] textureLineHash;
 }
 
 
@@ -89,7 +101,7 @@ void GLWidget::paintGL()
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (vjs.glFilter ? GL_LINEAR : GL_NEAREST));
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (vjs.glFilter ? GL_LINEAR : GL_NEAREST));
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, TOMGetVideoModeWidth(), rasterHeight * multiplier, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, buffer);
+	UploadLines((frame ? frame : buffer), (frame ? frameLineHash : bufferLineHash), TOMGetVideoModeWidth(), rasterHeight * multiplier);
 
 	double w = (double)TOMGetVideoModeWidth()  / (double)textureWidth;
 	double h = ((double)rasterHeight * multiplier) / (double)textureHeight;
@@ -105,6 +117,65 @@ void GLWidget::paintGL()
 }
 
 
+//
+// Send to the texture the runs of lines whose hash differs from the uploaded
+// ones. Without hashes, or after a size change, everything is sent.
+//
+void GLWidget::UploadLines(uint32_t * pixels, uint32_t * lineHash, unsigned width, unsigned lines)
+{
+	if (lines > (unsigned)textureHeight)
+		lines = textureHeight;
+
+	if (!lineHash || (width != textureLineWidth) || (lines != textureLines))
+	{
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, lines, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, pixels);
+
+		if (lineHash)
+			memcpy(textureLineHash, lineHash, lines * sizeof(uint32_t));
+
+		textureLineWidth = (lineHash ? width : 0);
+		textureLines = lines;
+		return;
+	}
+
+	unsigned first = 0;
+
+	while (first < lines)
+	{
+		if (lineHash[first] == textureLineHash[first])
+		{
+			first++;
+			continue;
+		}
+
+		unsigned last = first;
+
+		while ((last < lines) && (lineHash[last] != textureLineHash[last]))
+		{
+			textureLineHash[last] = lineHash[last];
+			last++;
+		}
+
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first, width, last - first, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8, pixels + (first * textureWidth));
+		first = last;
+	}
+}
+
+
+//
+// The buffer has been drawn into by something else than TOM (test pattern,
+// tank circuit, pause screen...), so give its lines new hashes
+//
+void GLWidget::BufferChanged(void)
+{
+	if (!buffer)
+		return;
+
+	for(int i=0; i<textureHeight; i++)
+		bufferLineHash[i] = TOMLineHash(buffer + (i * textureWidth), textureWidth);
+}
+
+
 void GLWidget::resizeGL(int /*width*/, int /*height*/)
 {
 //kludge [No, this is where it belongs!]
@@ -124,7 +195,13 @@ void GLWidget::CreateTextures(void)
 	textureWidth  = 1024;
 	textureHeight = 512;
 	buffer = new uint32_t[textureWidth * textureHeight];
+	bufferLineHash = new uint32_t[textureHeight];
+	textureLineHash = new uint32_t[textureHeight];
+	memset(buffer, 0, textureWidth * textureHeight * sizeof(uint32_t));
+	memset(bufferLineHash, 0, textureHeight * sizeof(uint32_t));
+	textureLineWidth = textureLines = 0;
 	JaguarSetScreenBuffer(buffer);
+	JaguarSetScreenLineHash(bufferLineHash);
 
 	glGenTextures(1, &texture);
 	glBindTexture(GL_TEXTURE_2D, texture);
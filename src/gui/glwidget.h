@@ -19,6 +19,7 @@ class GLWidget: public QGLWidget
 
 		void HandleMouseHiding(void);
 		void CheckAndRestoreMouseCursor(void);
+		void BufferChanged(void);
 //		QSize minimumSizeHint() const;
 //		QSize sizeHint() const;
 
@@ -35,12 +36,16 @@ class GLWidget: public QGLWidget
 
 	private:
 		void CreateTextures(void);
+		void UploadLines(uint32_t * pixels, uint32_t * lineHash, unsigned width, unsigned lines);
 
 	public:
 		GLuint texture;
 		int textureWidth, textureHeight;
 
 		uint32_t * buffer;
+		uint32_t * frame;						// Emulation thread's latest frame, shown instead of buffer if set
+		uint32_t * bufferLineHash;				// Line hashes, as set by TOM, of buffer...
+		uint32_t * frameLineHash;				// ...and of frame
 		unsigned rasterWidth, rasterHeight;
 
 		bool synchronize;
@@ -49,6 +54,10 @@ class GLWidget: public QGLWidget
 		bool fullscreen;
 		int outputWidth;
 		int32_t hideMouseTimeout;
+
+	private:
+		uint32_t * textureLineHash;				// Line hashes of what is in the texture
+		unsigned textureLineWidth, textureLines;	// Size of the last upload (0: nothing valid)
 };
 
 #endif	// __GLWIDGET_H__
@@ -37,6 +37,7 @@ enum
 	KBFRAMEADVANCE,
 	KBFULLSCREEN,
 	KBSCREENSHOT,
+	KBFASTFORWARD,
 	KBRESTART,
 	KBSTEPINTO,
 	KBSTEPOVER,
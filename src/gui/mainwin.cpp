@@ -60,6 +60,7 @@
 #include "about.h"
 #include "configdialog.h"
 #include "controllertab.h"
+#include "emuthread.h"
 #include "keybindingstab.h"
 #include "filepicker.h"
 #include "gamepad.h"
@@ -78,6 +79,8 @@
 #include "debug/riscdasmbrowser.h"
 #include "debug/hwregsbrowser.h"
 
+#include "cdimage.h"
+#include "cdintf.h"
 #include "dac.h"
 #include "jaguar.h"
 #include "log.h"
@@ -92,8 +95,10 @@
 #include "jagcdbios.h"
 #include "joystick.h"
 #include "m68000/m68kinterface.h"
+#include "trace.h"
 
 #include "debugger/DBGManager.h"
+#include "debugger/TraceDecoder.h"
 #include "debugger/VideoWin.h"
 //#include "debugger/DasmWin.h"
 #include "debugger/SourcesWin.h"
@@ -103,6 +108,7 @@
 #include "debugger/memory1browser.h"
 #include "debugger/BreakpointsWin.h"
 #include "debugger/NewFnctBreakpointWin.h"
+#include "debugger/NewWatchpointWin.h"
 #include "debugger/FilesrcListWin.h"
 #include "debugger/exceptionvectortablebrowser.h"
 #include "debugger/allwatchbrowser.h"
@@ -123,6 +129,17 @@
 #endif // !_MSC_VER
 //#endif
 
+// Frames run per timer tick in fast forward, when there is no emulation thread
+#define FAST_FORWARD_FRAMES	4
+
+// Where the execution trace goes, on demand or when the 68K halts
+#define TRACE_FILENAME		"./virtualjaguar.trace"
+
+#ifndef VJ_REMOVE_DEV_CODE
+// Blitter log level to go back to once F12 is released (-1: not held)
+static int blitterLogLevelHeld = -1;
+#endif
+
 // The way BSNES controls things is by setting a timer with a zero
 // timeout, sleeping if not emulating anything. Seems there has to be a
 // better way.
@@ -137,7 +154,8 @@
 
 MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	showUntunedTankCircuit(true), cartridgeLoaded(false), CDActive(false),
-	pauseForFileSelector(false), loadAndGo(autoRun), scannedSoftwareFolder(false), plzDontKillMyComputer(false)
+	pauseForFileSelector(false), pauseForConfigure(false), loadAndGo(autoRun), scannedSoftwareFolder(false), fastForward(false),
+	plzDontKillMyComputer(false)
 {
 	ReadSettings();
 
@@ -148,9 +166,10 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 
 	// FPS management
 	for(int i=0; i<RING_BUFFER_SIZE; i++)
-		ringBuffer[i] = 0;
+		ringBuffer[i] = ringFrames[i] = 0;
 
 	ringBufferPointer = RING_BUFFER_SIZE - 1;
+	oldFrameCount = 0;
 
 	// main window
 	//if (vjs.softTypeDebugger)
@@ -216,6 +235,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		heapallocatorBrowseWin = new HeapAllocatorBrowserWindow(this);
 		BreakpointsWin = new BreakpointsWindow(this);
 		NewFunctionBreakpointWin = new NewFnctBreakpointWindow(this);
+		NewWatchpointWin = new NewWatchpointWindow(this);
 		SaveDumpAsWin = new SaveDumpAsWindow(this);
 		exceptionvectortableBrowseWin = new ExceptionVectorTableBrowserWindow(this);
 		CallStackBrowseWin = new CallStackBrowserWindow(this);
@@ -390,6 +410,14 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	frameAdvanceAct->setDisabled(true);
 	connect(frameAdvanceAct, SIGNAL(triggered()), this, SLOT(FrameAdvance()));
 
+	// Fast forward action
+	fastForwardAct = new QAction(tr("Fast F&orward"), this);
+	fastForwardAct->setStatusTip(tr("Run the emulation as fast as possible"));
+	fastForwardAct->setShortcut(QKeySequence(tr(vjs.KBContent[KBFASTFORWARD].KBSettingValue)));
+	fastForwardAct->setShortcutContext(Qt::ApplicationShortcut);
+	fastForwardAct->setCheckable(true);
+	connect(fastForwardAct, SIGNAL(triggered()), this, SLOT(ToggleFastForward()));
+
 	// Fullscreen action
 	fullScreenAct = new QAction(QIcon(":/res/fullscreen.png"), tr("F&ull Screen"), this);
 	fullScreenAct->setShortcut(QKeySequence(tr(vjs.KBContent[KBFULLSCREEN].KBSettingValue)));
@@ -428,6 +456,8 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		newFunctionBreakpointAct = new QAction(QIcon(""), tr("&Function Breakpoint"), this);
 		newFunctionBreakpointAct->setShortcut(QKeySequence(tr(vjs.KBContent[KBFUNCTIONBREAKPOINT].KBSettingValue)));
 		connect(newFunctionBreakpointAct, SIGNAL(triggered()), this, SLOT(ShowNewFunctionBreakpointWin()));
+		newWatchpointAct = new QAction(QIcon(""), tr("&Watchpoint"), this);
+		connect(newWatchpointAct, SIGNAL(triggered()), this, SLOT(ShowNewWatchpointWin()));
 		BreakpointsAct = new QAction(QIcon(":/res/debug-breakpoints.png"), tr("&Breakpoints"), this);
 		BreakpointsAct->setShortcut(QKeySequence(tr(vjs.KBContent[KBBREAKPOINTS].KBSettingValue)));
 		connect(BreakpointsAct, SIGNAL(triggered()), this, SLOT(ShowBreakpointsWin()));
@@ -443,6 +473,11 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 		saveDumpAsAct->setDisabled(false);
 		connect(saveDumpAsAct, SIGNAL(triggered()), this, SLOT(ShowSaveDumpAsWin()));
 
+		// Decode trace
+		traceDecodeAct = new QAction(tr("De&code Trace..."), this);
+		traceDecodeAct->setStatusTip(tr("Writes an execution trace as text, with the symbols"));
+		connect(traceDecodeAct, SIGNAL(triggered()), this, SLOT(DecodeTrace()));
+
 		VideoOutputAct = new QAction(tr("Output Video"), this);
 		VideoOutputAct->setStatusTip(tr("Shows the output video window"));
 		connect(VideoOutputAct, SIGNAL(triggered()), this, SLOT(ShowVideoOutputWin()));
@@ -531,6 +566,12 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	hwRegsBrowseAct->setStatusTip(tr("Shows the HW registers browser window"));
 	connect(hwRegsBrowseAct, SIGNAL(triggered()), this, SLOT(ShowHWRegsBrowserWin()));
 
+	// Execution trace dump, see the --trace switches
+	traceDumpAct = new QAction(tr("Dump &Trace"), this);
+	traceDumpAct->setStatusTip(tr("Writes the execution trace to " TRACE_FILENAME));
+	traceDumpAct->setEnabled(TraceEnabled());
+	connect(traceDumpAct, SIGNAL(triggered()), this, SLOT(DumpTrace()));
+
 	// Risc (DSP / GPU) disassembly browser window
 	riscDasmBrowseAct = new QAction(QIcon(":/res/tool-risc-dis.png"), tr("RISC Listing Browser"), this);
 	riscDasmBrowseAct->setStatusTip(tr("Shows the RISC disassembly browser window"));
@@ -548,6 +589,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	{
 		fileMenu->addAction(pauseAct);
 		//	fileMenu->addAction(frameAdvanceAct);
+		fileMenu->addAction(fastForwardAct);
 	}
 	fileMenu->addAction(filePickAct);
 	fileMenu->addAction(useCDAct);
@@ -617,10 +659,14 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 			debugMenu->addSeparator();
 			debugNewBreakpointMenu = debugMenu->addMenu(tr("&New Breakpoint"));
 			debugNewBreakpointMenu->addAction(newFunctionBreakpointAct);
+			debugNewBreakpointMenu->addAction(newWatchpointAct);
 			debugMenu->addAction(deleteAllBreakpointsAct);
 			debugMenu->addAction(disableAllBreakpointsAct);
 			debugMenu->addSeparator();
 			debugMenu->addAction(saveDumpAsAct);
+			debugMenu->addSeparator();
+			debugMenu->addAction(traceDumpAct);
+			debugMenu->addAction(traceDecodeAct);
 #if 0
 			debugMenu->addSeparator();
 			debugMenu->addAction(DasmAct);
@@ -636,6 +682,8 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 			debugMenu->addAction(m68kDasmBrowseAct);
 			debugMenu->addAction(riscDasmBrowseAct);
 			debugMenu->addAction(hwRegsBrowseAct);
+			debugMenu->addSeparator();
+			debugMenu->addAction(traceDumpAct);
 		}
 	}
 
@@ -704,6 +752,7 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	addAction(pauseAct);
 	addAction(filePickAct);
 	addAction(frameAdvanceAct);
+	addAction(fastForwardAct);
 
 	//	Create status bar
 	statusBar()->showMessage(tr("Ready"));
@@ -765,6 +814,16 @@ MainWin::MainWin(bool autoRun): running(true), powerButtonOn(false),
 	WriteLog("VJ: Initializing jaguar subsystem...\n");
 	JaguarInit();
 
+	// The debuggers step, break and inspect the core from the GUI thread, so
+	// the frames are only run on their own thread in the plain emulator mode
+	emuThread = NULL;
+
+	if (!vjs.hardwareTypeAlpine && !vjs.softTypeDebugger)
+	{
+		emuThread = new EmuThread(this);
+		emuThread->start();
+	}
+
 #ifndef NEWMODELSBIOSHANDLER
 	//	memcpy(jagMemSpace + 0xE00000, jaguarBootROM, 0x20000);	// Use the stock BIOS
 	memcpy(jagMemSpace + 0xE00000, (vjs.biosType == BT_K_SERIES ? jaguarBootROM : jaguarBootROM2), 0x20000);	// Use the stock BIOS
@@ -859,6 +918,14 @@ void MainWin::SyncUI(void)
 	fullScreen = vjs.fullscreen;
 	SetFullScreen(fullScreen);
 
+	// A CD image passed in is meant to be played, once it could be opened
+	if (CDImageIsOpen() && !CDActive)
+	{
+		CDActive = true;
+		useCDAct->setChecked(true);
+		memcpy(jagMemSpace + 0x800000, jaguarCDBootROM, 0x40000);
+	}
+
 	// Reset the timer to be what was set in the command line (if any):
 //	timer->setInterval(vjs.hardwareTypeNTSC ? 16 : 20);
 	timer->start(vjs.hardwareTypeNTSC ? 16 : 20);
@@ -878,6 +945,9 @@ void MainWin::SelectdasmtabWidget(const int Index)
 
 void MainWin::closeEvent(QCloseEvent * event)
 {
+	if (emuThread)
+		emuThread->Stop();
+
 	JaguarDone();
 // This should only be done by the config dialog
 //	WriteSettings();
@@ -891,8 +961,6 @@ void MainWin::keyPressEvent(QKeyEvent * e)
 #ifndef VJ_REMOVE_DEV_CODE
 	// From jaguar.cpp
 	//extern bool startM68KTracing;		// moved to jaguar.h
-	// From joystick.cpp
-	extern int blit_start_log;
 	// From blitter.cpp
 	extern bool startConciseBlitLogging;
 #endif
@@ -913,7 +981,13 @@ void MainWin::keyPressEvent(QKeyEvent * e)
 	}
 	else if (e->key() == Qt::Key_F12)
 	{
-		blit_start_log = true;
+		// Only log while the key is down
+		if (blitterLogLevelHeld < 0)
+		{
+			blitterLogLevelHeld = logLevel[LOG_CAT_BLITTER];
+			logLevel[LOG_CAT_BLITTER] = LOG_LEVEL_DEBUG;
+		}
+
 		e->accept();
 		return;
 	}
@@ -961,6 +1035,17 @@ void MainWin::keyReleaseEvent(QKeyEvent * e)
 		e->accept();
 		return;
 	}
+#ifndef VJ_REMOVE_DEV_CODE
+	else if ((e->key() == Qt::Key_F12) && !e->isAutoRepeat())
+	{
+		if (blitterLogLevelHeld >= 0)
+			logLevel[LOG_CAT_BLITTER] = blitterLogLevelHeld;
+
+		blitterLogLevelHeld = -1;
+		e->accept();
+		return;
+	}
+#endif
 
 	HandleKeys(e, false);
 }
@@ -1041,6 +1126,10 @@ void MainWin::Open(void)
 
 void MainWin::Configure(void)
 {
+	// The emulation thread is kept paused until the files are reloaded and the DAC re-initialised
+	PauseEmulation();
+	pauseForConfigure = true;
+
 	// Call the configuration dialog and update settings
 	ConfigDialog dlg(this);
 	//ick.
@@ -1054,6 +1143,7 @@ void MainWin::Configure(void)
 	if (dlg.exec() == false)
 	{
 		RestoreProfiles();
+		pauseForConfigure = false;
 		return;
 	}
 
@@ -1116,6 +1206,7 @@ void MainWin::Configure(void)
 
 	// Just in case we crash before a clean exit...
 	WriteSettings();
+	pauseForConfigure = false;
 
 	RefreshWindows();
 }
@@ -1155,6 +1246,8 @@ static uint32_t ntscTickCount;
 						videoWidget->buffer[(y * videoWidget->textureWidth) + x] = (rand() & 0xFF) << 8 | (rand() & 0xFF) << 16 | (rand() & 0xFF) << 24;
 					}
 				}
+
+				videoWidget->BufferChanged();
 			}
 		}
 	}
@@ -1162,7 +1255,49 @@ static uint32_t ntscTickCount;
 	{
 		// Otherwise, run the Jaguar simulation
 		HandleGamepads();
-		JaguarExecuteNew();
+
+		if (emuThread)
+		{
+			// The frames are run by the emulation thread, we just show the latest one
+			if (!M68KDebugHaltStatus() && !pauseForConfigure)
+				emuThread->Resume();
+
+			if (emuThread->NewFrame())
+			{
+				videoWidget->frame = emuThread->Frame();
+				videoWidget->frameLineHash = emuThread->FrameLineHash();
+			}
+		}
+		else if (fastForward)
+		{
+			// Run a few frames per tick
+			for(int i=0; i<FAST_FORWARD_FRAMES; i++)
+			{
+				JaguarFrameSkip(true);
+				JaguarExecuteNew();
+
+				if (vjs.DSPEnabled)
+					DACRunFrame();
+
+				if (M68KDebugHaltStatus())
+					break;
+			}
+		}
+		else
+		{
+			// The automatic frame skip kicks in when a frame took longer to
+			// run than its period
+			static uint32_t frameTicks = 0;
+			uint32_t ticks = SDL_GetTicks();
+			JaguarFrameSkip(frameTicks > (vjs.hardwareTypeNTSC ? 16U : 20U));
+			JaguarExecuteNew();
+
+			if (vjs.DSPEnabled)
+				DACRunFrame();
+
+			frameTicks = SDL_GetTicks() - ticks;
+		}
+
 		//if (!vjs.softTypeDebugger)
 			videoWidget->HandleMouseHiding();
 
@@ -1199,17 +1334,24 @@ static uint32_t refresh = 0;
 	// Doing it this way is better. Ring buffer size can be arbitrary then.
 	ringBufferPointer = (ringBufferPointer + 1) % RING_BUFFER_SIZE;
 	ringBuffer[ringBufferPointer] = timestamp - oldTimestamp;
-	uint32_t elapsedTime = 0;
+	// With the emulation thread, count the frames it actually ran since last time
+	uint32_t frameCount = (emuThread ? emuThread->FrameCount() : 0);
+	ringFrames[ringBufferPointer] = (emuThread && !showUntunedTankCircuit ? frameCount - oldFrameCount : 1);
+	oldFrameCount = frameCount;
+	uint32_t elapsedTime = 0, elapsedFrames = 0;
 
 	for(uint32_t i=0; i<RING_BUFFER_SIZE; i++)
+	{
 		elapsedTime += ringBuffer[i];
+		elapsedFrames += ringFrames[i];
+	}
 
 	// elapsedTime must be non-zero
 	if (elapsedTime == 0)
 		elapsedTime = 1;
 
 	// This is in frames per 10 seconds, so we can have 1 decimal
-	uint32_t framesPerSecond = (uint32_t)(((float)RING_BUFFER_SIZE / (float)elapsedTime) * 10000.0);
+	uint32_t framesPerSecond = (uint32_t)(((float)elapsedFrames / (float)elapsedTime) * 10000.0);
 	uint32_t fpsIntegerPart = framesPerSecond / 10;
 	uint32_t fpsDecimalPart = framesPerSecond % 10;
 	// If this is updated too frequently to be useful, we can throttle it down
@@ -1218,13 +1360,22 @@ static uint32_t refresh = 0;
 	oldTimestamp = timestamp;
 
 	if (M68KDebugHaltStatus())
+	{
+		// Keep what led to the halt, once the emulation thread has stopped writing the trace
+		PauseEmulation();
+
+		if (TraceEnabled())
+			TraceDump(TRACE_FILENAME);
+
 		ToggleRunState();
+	}
 }
 
 
 // Toggle the power state, it can be either on or off
 void MainWin::TogglePowerState(void)
 {
+	PauseEmulation();
 	powerButtonOn = !powerButtonOn;
 	running = true;
 
@@ -1262,6 +1413,8 @@ void MainWin::TogglePowerState(void)
 					memcpy(videoWidget->buffer + (y * videoWidget->textureWidth), testPattern2 + (y * VIRTUAL_SCREEN_WIDTH), VIRTUAL_SCREEN_WIDTH * sizeof(uint32_t));
 				}
 			}
+
+			videoWidget->BufferChanged();
 		}
 	}
 	else
@@ -1295,9 +1448,55 @@ void MainWin::TogglePowerState(void)
 }
 
 
+//
+// Stop the emulation thread between two frames, so the core can be used from
+// the GUI thread. The last frame goes back into the GL widget's own buffer.
+//
+void MainWin::PauseEmulation(void)
+{
+	if (!emuThread)
+		return;
+
+	emuThread->Pause();
+
+	if (emuThread->NewFrame())
+	{
+		videoWidget->frame = emuThread->Frame();
+		videoWidget->frameLineHash = emuThread->FrameLineHash();
+	}
+
+	if (videoWidget->frame)
+	{
+		memcpy(videoWidget->buffer, videoWidget->frame, videoWidget->textureWidth * videoWidget->textureHeight * sizeof(uint32_t));
+		memcpy(videoWidget->bufferLineHash, videoWidget->frameLineHash, videoWidget->textureHeight * sizeof(uint32_t));
+		videoWidget->frame = NULL;
+	}
+
+	JaguarSetScreenBuffer(videoWidget->buffer);
+	JaguarSetScreenLineHash(videoWidget->bufferLineHash);
+}
+
+
+//
+// Toggle the fast forward: frames are run with no pacing, and the DAC drops
+// the samples meanwhile
+//
+void MainWin::ToggleFastForward(void)
+{
+	PauseEmulation();
+	fastForward = !fastForward;
+	fastForwardAct->setChecked(fastForward);
+	DACSetFastForward(fastForward);
+
+	if (emuThread)
+		emuThread->SetFastForward(fastForward);
+}
+
+
 // Toggle the emulator state, it can be either on or off
 void MainWin::ToggleRunState(void)
 {
+	PauseEmulation();
 	startM68KTracing = running;
 	running = !running;
 
@@ -1331,6 +1530,7 @@ void MainWin::ToggleRunState(void)
 				videoWidget->buffer[i] = 0x000000FF | (pixel << 16) | (pixel << 8);
 			}
 
+			videoWidget->BufferChanged();
 			videoWidget->updateGL();
 			//vjs.softTypeDebugger ? VideoOutputWin->RefreshContents(videoWidget) : NULL;
 
@@ -1384,6 +1584,7 @@ void MainWin::SetZoom300(void)
 
 void MainWin::SetNTSC(void)
 {
+	PauseEmulation();
 	powerAct->setIcon(powerRed);
 	timer->setInterval(16);
 	vjs.hardwareTypeNTSC = true;
@@ -1394,6 +1595,7 @@ void MainWin::SetNTSC(void)
 
 void MainWin::SetPAL(void)
 {
+	PauseEmulation();
 	powerAct->setIcon(powerGreen);
 	timer->setInterval(20);
 	vjs.hardwareTypeNTSC = false;
@@ -1460,6 +1662,7 @@ void MainWin::Unpause(void)
 // Jaguar initialisation and load software file
 void MainWin::LoadSoftware(QString file)
 {
+	PauseEmulation();
 	running = false;							// Prevent bad things(TM) from happening...
 	pauseForFileSelector = false;				// Reset the file selector pause flag
 
@@ -1527,6 +1730,7 @@ void MainWin::LoadSoftware(QString file)
 
 void MainWin::ToggleCDUsage(void)
 {
+	PauseEmulation();
 	CDActive = !CDActive;
 
 	// Set up the Jaguar CD for execution, otherwise, clear memory
@@ -1550,6 +1754,7 @@ void MainWin::DeleteAllBreakpoints(void)
 {
 	cpuBrowseWin->ResetBPM();
 	m68k_brk_reset();
+	watch_reset();
 	ShowBreakpointsWin();
 }
 
@@ -1559,6 +1764,7 @@ void MainWin::DisableAllBreakpoints(void)
 {
 	cpuBrowseWin->DisableBPM();
 	m68k_brk_disable();
+	watch_disable();
 	ShowBreakpointsWin();
 }
 
@@ -1572,6 +1778,15 @@ void MainWin::ShowNewFunctionBreakpointWin(void)
 }
 
 
+// Open, or display, the new watchpoint window
+void MainWin::ShowNewWatchpointWin(void)
+{
+	NewWatchpointWin->SetWatchpointWin(BreakpointsWin);
+	NewWatchpointWin->show();
+	ShowBreakpointsWin();
+}
+
+
 // Display list of files found in cartridge
 void MainWin::ShowCartFilesListWin(void)
 {
@@ -1587,6 +1802,32 @@ void MainWin::ShowSaveDumpAsWin(void)
 }
 
 
+// Decode an execution trace into a text file next to it
+void MainWin::DecodeTrace(void)
+{
+	QString fileName = QFileDialog::getOpenFileName(this, tr("Decode trace"), "", tr("Trace files (*.trace)"));
+
+	if (!fileName.isEmpty())
+	{
+		QString textName = fileName + ".txt";
+		QMessageBox msg;
+
+		if (TraceDecoder_Decode(fileName.toUtf8().data(), textName.toUtf8().data()))
+		{
+			msg.setText(QString(tr("Trace decoded to \"%1\".")).arg(textName));
+			msg.setIcon(QMessageBox::Information);
+		}
+		else
+		{
+			msg.setText(QString(tr("Could not decode trace \"%1\"!")).arg(fileName));
+			msg.setIcon(QMessageBox::Warning);
+		}
+
+		msg.exec();
+	}
+}
+
+
 // Step Into trace
 void MainWin::DebuggerTraceStepInto(void)
 {
@@ -1624,6 +1865,7 @@ void MainWin::DebuggerRestart(void)
 	dasmtabWidget->setCurrentIndex(1);		// set focus on the disasm M68K tab
 	m68k_set_reg(M68K_REG_A6, 0);
 	m68k_brk_hitcounts_reset();
+	watch_hitcounts_reset();
 	emuStatusWin->ResetM68KCycles();
 	bpmHitCounts = 0;
 	DebuggerResetWindows();
@@ -1670,19 +1912,17 @@ void MainWin::FrameAdvance(void)
 	ToggleRunState();
 	// Execute 1 frame, then exit (only useful in Pause mode)
 	JaguarExecuteNew();
+
+	if (vjs.DSPEnabled)
+		DACRunFrame();
+
 	//if (!vjs.softTypeDebugger)
 		videoWidget->updateGL();
 		//vjs.softTypeDebugger ? VideoOutputWin->RefreshContents(videoWidget) : NULL;
 	ToggleRunState();
-	// Need to execute 1 frames' worth of DSP thread as well :-/
 
 	//m68kDasmWin->Use68KPCAddress();
 	//RefreshWindows();
-#ifdef _MSC_VER
-#pragma message("Warning: !!! Need to execute the DSP thread for 1 frame too !!!")
-#else
-#warning "!!! Need to execute the DSP thread for 1 frame too !!!"
-#endif // _MSC_VER
 }
 
 
@@ -1839,6 +2079,14 @@ void MainWin::ShowHWRegsBrowserWin(void)
 }
 
 
+// Write the execution trace, the emulation being paused
+void MainWin::DumpTrace(void)
+{
+	PauseEmulation();
+	TraceDump(TRACE_FILENAME);
+}
+
+
 // Show the M68K browser window
 void MainWin::ShowM68KDasmBrowserWin(void)
 {
@@ -1900,6 +2148,8 @@ void MainWin::ResizeMainWindow(void)
 					memcpy(videoWidget->buffer + (y * videoWidget->textureWidth), testPattern2 + (y * VIRTUAL_SCREEN_WIDTH), VIRTUAL_SCREEN_WIDTH * sizeof(uint32_t));
 				}
 			}
+
+			videoWidget->BufferChanged();
 		}
 
 		adjustSize();
@@ -1939,6 +2189,10 @@ void MainWin::ReadSettings(void)
 	strcpy(vjs.EEPROMPath, settings.value("EEPROMs", QStandardPaths::writableLocation(QStandardPaths::DataLocation).append("/eeproms/")).toString().toUtf8().data());
 	strcpy(vjs.ROMPath, settings.value("ROMs", QStandardPaths::writableLocation(QStandardPaths::DataLocation).append("/software/")).toString().toUtf8().data());
 	strcpy(vjs.screenshotPath, settings.value("Screenshots", QStandardPaths::writableLocation(QStandardPaths::DataLocation).append("/screenshots/")).toString().toUtf8().data());
+	strcpy(vjs.zipCachePath, settings.value("ZIPCache", QStandardPaths::writableLocation(QStandardPaths::DataLocation).append("/zipcache/")).toString().toUtf8().data());
+
+	if (vjs.zipCachePath[0])
+		QDir().mkpath(vjs.zipCachePath);
 
 	// Read settings from the Debugger mode
 	settings.beginGroup("debugger");
@@ -1977,6 +2231,7 @@ void MainWin::ReadSettings(void)
 	WriteLog("      DebuggerROMPath = \"%s\"\n", vjs.debuggerROMPath);
 	WriteLog("           absROMPath = \"%s\"\n", vjs.absROMPath);
 	WriteLog("      ScreenshotsPath = \"%s\"\n", vjs.screenshotPath);
+	WriteLog("         ZIPCachePath = \"%s\"\n", vjs.zipCachePath);
 	WriteLog("SourceFileSearchPaths = \"%s\"\n", vjs.sourcefilesearchPaths);
 	WriteLog("MainWin: Misc.\n");
 	WriteLog("   Pipelined DSP = %s\n", (vjs.usePipelinedDSP ? "ON" : "off"));
@@ -2200,6 +2455,11 @@ void MainWin::ReadUISettings(void)
 		settings.value("NewFunctionBreakpointWinIsVisible", false).toBool() ? ShowNewFunctionBreakpointWin() : void();
 		size = settings.value("NewFunctionBreakpointWinSize", QSize(400, 400)).toSize();
 		NewFunctionBreakpointWin->resize(size);
+		pos = settings.value("NewWatchpointWinPos", QPoint(200, 200)).toPoint();
+		NewWatchpointWin->move(pos);
+		settings.value("NewWatchpointWinIsVisible", false).toBool() ? ShowNewWatchpointWin() : void();
+		size = settings.value("NewWatchpointWinSize", QSize(400, 200)).toSize();
+		NewWatchpointWin->resize(size);
 
 		// Memories browser UI information
 		for (i = 0; i < vjs.nbrmemory1browserwindow; i++)
@@ -2259,6 +2519,7 @@ void MainWin::WriteSettings(void)
 	settings.setValue("EEPROMs", vjs.EEPROMPath);
 	settings.setValue("ROMs", vjs.ROMPath);
 	settings.setValue("Screenshots", vjs.screenshotPath);
+	settings.setValue("ZIPCache", vjs.zipCachePath);
 
 	// Write settings from the Alpine mode
 	settings.beginGroup("alpine");
@@ -2414,6 +2675,9 @@ void MainWin::WriteUISettings(void)
 		settings.setValue("NewFunctionBreakpointWinPos", NewFunctionBreakpointWin->pos());
 		settings.setValue("NewFunctionBreakpointWinIsVisible", NewFunctionBreakpointWin->isVisible());
 		settings.setValue("NewFunctionBreakpointWinSize", NewFunctionBreakpointWin->size());
+		settings.setValue("NewWatchpointWinPos", NewWatchpointWin->pos());
+		settings.setValue("NewWatchpointWinIsVisible", NewWatchpointWin->isVisible());
+		settings.setValue("NewWatchpointWinSize", NewWatchpointWin->size());
 		settings.setValue("CartFilesListWinPos", CartFilesListWin->pos());
 		settings.setValue("CartFilesListWinIsVisible", CartFilesListWin->isVisible());
 		settings.setValue("CartFilesListWinSize", CartFilesListWin->size());
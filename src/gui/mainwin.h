@@ -25,6 +25,7 @@ class FilePickerWindow;
 class VideoOutputWindow;
 //class DasmWindow;
 class EmuStatusWindow;
+class EmuThread;
 
 // Alpine
 class MemoryBrowserWindow;
@@ -47,6 +48,7 @@ class HeapAllocatorBrowserWindow;
 class Memory1BrowserWindow;
 class BreakpointsWindow;
 class NewFnctBreakpointWindow;
+class NewWatchpointWindow;
 class ExceptionVectorTableBrowserWindow;
 class FilesrcListWindow;
 class CartFilesListWindow;
@@ -98,6 +100,7 @@ class MainWin: public QMainWindow
 		void LoadSoftware(QString);
 		void ToggleCDUsage(void);
 		void FrameAdvance(void);
+		void ToggleFastForward(void);
 		void ToggleFullScreen(void);
 		void ShowEmuStatusWin(void);
 		void MakeScreenshot(void);
@@ -112,10 +115,12 @@ class MainWin: public QMainWindow
 		void ShowMemory1BrowserWin(int NumWin);
 		void ShowExceptionVectorTableBrowserWin(void);
 		void ShowNewFunctionBreakpointWin(void);
+		void ShowNewWatchpointWin(void);
 		void ShowBreakpointsWin(void);
 		void DeleteAllBreakpoints(void);
 		void DisableAllBreakpoints(void);
 		void ShowSaveDumpAsWin(void);
+		void DecodeTrace(void);
 		void SelectdasmtabWidget(const int);
 		void ShowVideoOutputWin(void);
 		//void ShowDasmWin(void);
@@ -128,6 +133,7 @@ class MainWin: public QMainWindow
 		void ShowM68KDasmBrowserWin(void);
 		void ShowHWRegsBrowserWin(void);
 		void ShowRISCDasmBrowserWin(void);
+		void DumpTrace(void);
 
 	private:
 		void HandleKeys(QKeyEvent *, bool);
@@ -138,9 +144,11 @@ class MainWin: public QMainWindow
 		void ReadSettings(void);
 		void WriteSettings(void);
 		void WriteUISettings(void);
+		void PauseEmulation(void);
 
 	private:
 		GLWidget *videoWidget;
+		EmuThread *emuThread;
 		QMdiArea *mainWindowCentrale;
 		QMdiSubWindow *VideoOutputWindowCentrale;
 		AboutWindow *aboutWin;
@@ -171,6 +179,7 @@ class MainWin: public QMainWindow
 		FilesrcListWindow *FilesrcListWin;
 		BreakpointsWindow *BreakpointsWin;
 		NewFnctBreakpointWindow *NewFunctionBreakpointWin;
+		NewWatchpointWindow *NewWatchpointWin;
 		CartFilesListWindow *CartFilesListWin;
 		SaveDumpAsWindow *SaveDumpAsWin;
 		QTimer *timer;
@@ -187,16 +196,20 @@ class MainWin: public QMainWindow
 		bool CDActive;
 //		bool alpineLoadSuccessful;
 		bool pauseForFileSelector;
+		bool pauseForConfigure;
 		bool loadAndGo;
 		bool keyHeld[8];
 		bool fullScreen;
 		bool scannedSoftwareFolder;
+		bool fastForward;
 
 	public:
 		bool plzDontKillMyComputer;
 		uint32_t oldTimestamp;
 		uint32_t ringBufferPointer;
 		uint32_t ringBuffer[RING_BUFFER_SIZE];
+		uint32_t ringFrames[RING_BUFFER_SIZE];
+		uint32_t oldFrameCount;
 
 	private:
 		QPoint mainWinPosition;
@@ -229,6 +242,7 @@ class MainWin: public QMainWindow
 		QAction *emustatusAct;
 		QAction *useCDAct;
 		QAction *frameAdvanceAct;
+		QAction *fastForwardAct;
 		QAction *fullScreenAct;
 		//QAction *DasmAct;
 		QAction *screenshotAct;
@@ -253,10 +267,13 @@ class MainWin: public QMainWindow
 		QAction *CallStackBrowseAct;
 		QAction **mem1BrowseAct;
 		QAction *newFunctionBreakpointAct;
+		QAction *newWatchpointAct;
 		QAction *BreakpointsAct;
 		QAction *deleteAllBreakpointsAct;
 		QAction *disableAllBreakpointsAct;
 		QAction *saveDumpAsAct;
+		QAction *traceDumpAct;
+		QAction *traceDecodeAct;
 		QAction *exceptionVectorTableBrowseAct;
 		QAction *CartFilesListAct;
 
@@ -0,0 +1,423 @@
+//
+// romsweep.cpp - Headless ROM sweep
+//
+
+// The sweep boots every file of a directory without the GUI, runs it for a
+// fixed number of frames and reports speed and a few sanity markers for each
+// one. The emulation core is one big set of globals, so the ROMs can't run
+// side by side in threads; instead the sweep spawns itself with
+// --sweep-worker for each file, keeps up to 'jobs' of these running at once,
+// and collects the single result line each worker prints. A ROM that crashes
+// or hangs its worker only costs that one entry of the report.
+//
+// With an audio directory, each worker also captures the JERRY output of its
+// file to <audio dir>/<file name>.wav, for audio regression diffs.
+
+#include "romsweep.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QProcess>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+#include "crc32.h"
+#include "dac.h"
+#include "eeprom.h"
+#include "file.h"
+#include "filedb.h"
+#include "jaguar.h"
+#include "log.h"
+#include "m68000/m68kinterface.h"
+#include "modelsBIOS.h"
+#include "perfcount.h"
+#include "settings.h"
+#include "tom.h"
+#include "wavcapture.h"
+#include "debugger/DBGManager.h"
+
+#define SWEEP_TAG				"SWEEP"
+#define SWEEP_WORKER_TIMEOUT	300000				// A worker still running after 5 minutes is killed
+
+// Report columns, in the order the worker prints them
+enum { SC_FILE = 0, SC_NAME, SC_CRC32, SC_STATUS, SC_FRAMES, SC_FPS, SC_TIME, SC_FIRSTIMAGE = SC_TIME + PERF_MAX, SC_FRAMECRC32, SC_MAX };
+
+// Private function prototypes
+
+static QStringList SweepColumnNames(void);
+static QStringList SweepEmptyRecord(QString file, QString status);
+static QStringList SweepReadWorker(QProcess * process, QString file);
+static bool SweepColumnIsNumber(int column);
+static bool SweepWriteReport(QVector<QStringList> & records, QString report);
+static uint32_t FindCRCIndexInRomList(uint32_t crc);
+
+
+//
+// Settings used by the sweep, independent of the user's configuration so
+// that two sweeps of the same files can be compared
+//
+void RomSweepDefaults(void)
+{
+	vjs.useJoystick = false;
+	vjs.hardwareTypeNTSC = true;
+	vjs.useJaguarBIOS = false;
+	vjs.GPUEnabled = true;
+	vjs.DSPEnabled = true;
+	vjs.audioEnabled = false;
+	vjs.usePipelinedDSP = false;
+	vjs.frameSkip = 0;
+	vjs.renderType = RT_NORMAL;
+	vjs.allowM68KExceptionCatch = false;
+	vjs.allowWritesToROM = false;
+	vjs.biosType = BT_M_SERIES;
+	vjs.jaguarModel = JAG_M_SERIES;
+	vjs.useFastBlitter = false;
+	vjs.ELFSectionsCheck = false;
+
+	// No audio device, the samples are not played
+	dacHostAudio = false;
+}
+
+
+//
+// Sweep all the files from a directory, using up to 'jobs' worker processes
+//
+int RomSweepRun(QString dir, uint32_t frames, int jobs, QString report, QString audioDir, QStringList options)
+{
+	QFileInfoList list = QDir(dir).entryInfoList(QDir::Files, QDir::Name);
+
+	if (list.isEmpty())
+	{
+		fprintf(stderr, "Sweep: No files found in \"%s\".\n", dir.toUtf8().data());
+		return 1;
+	}
+
+	if (jobs < 1)
+		jobs = (QThread::idealThreadCount() > 0 ? QThread::idealThreadCount() : 1);
+
+	QString program = QCoreApplication::applicationFilePath();
+	QVector<QStringList> records(list.size());
+	QVector<QProcess *> worker(jobs, NULL);
+	QVector<int> workerIndex(jobs, 0);
+	QVector<QElapsedTimer> workerTimer(jobs);
+	int next = 0, done = 0;
+
+	if (!audioDir.isEmpty())
+	{
+		QDir().mkpath(audioDir);
+		options << "--sweep-audio" << audioDir;
+	}
+
+	fprintf(stderr, "Sweep: %i files, %u frames each, %i jobs\n", list.size(), frames, jobs);
+
+	while (done < list.size())
+	{
+		for(int i=0; i<jobs; i++)
+		{
+			// Give an idle slot the next file
+			if (!worker[i] && (next < list.size()))
+			{
+				QStringList arguments;
+				arguments << "--sweep-worker" << list.at(next).filePath() << "--sweep-frames" << QString::number(frames) << options;
+				worker[i] = new QProcess;
+				worker[i]->setStandardErrorFile(QProcess::nullDevice());
+				worker[i]->start(program, arguments);
+				workerIndex[i] = next++;
+				workerTimer[i].start();
+			}
+
+			if (!worker[i])
+				continue;
+
+			QString file = list.at(workerIndex[i]).fileName();
+
+			if (worker[i]->state() != QProcess::NotRunning && !worker[i]->waitForFinished(10))
+			{
+				if (!workerTimer[i].hasExpired(SWEEP_WORKER_TIMEOUT))
+					continue;
+
+				worker[i]->kill();
+				worker[i]->waitForFinished(-1);
+				records[workerIndex[i]] = SweepEmptyRecord(file, "timeout");
+			}
+			else
+				records[workerIndex[i]] = SweepReadWorker(worker[i], file);
+
+			delete worker[i];
+			worker[i] = NULL;
+			done++;
+			fprintf(stderr, "Sweep: [%i/%i] %s: %s\n", done, list.size(), file.toUtf8().data(), records[workerIndex[i]].at(SC_STATUS).toUtf8().data());
+		}
+	}
+
+	return (SweepWriteReport(records, report) ? 0 : 1);
+}
+
+
+//
+// Run a single file and print its report line on stdout
+//
+int RomSweepWorker(QString file, uint32_t frames, QString audioDir)
+{
+	QByteArray path = file.toUtf8();
+	QStringList record = SweepEmptyRecord(QFileInfo(file).fileName(), "load-failed");
+	uint8_t * buffer = NULL;
+	uint32_t size = JaguarLoadROM(buffer, path.data());
+
+	// Identify the file the same way the file picker does, and leave out what it would
+	if (size)
+	{
+		int fileType = ParseFileType(buffer, size);
+		uint32_t crc = (HasUniversalHeader(buffer, size) ? crc32_calcCheckSum(buffer + 8192, size - 8192) : crc32_calcCheckSum(buffer, size));
+		uint32_t index = FindCRCIndexInRomList(crc);
+		delete[] buffer;
+
+		record[SC_CRC32] = QString("%1").arg(crc, 8, 16, QChar('0')).toUpper();
+
+		if (index != 0xFFFFFFFF)
+			record[SC_NAME] = romList[index].name;
+
+		if ((index == 0xFFFFFFFF) && (fileType == JST_NONE))
+			record[SC_STATUS] = "unknown";
+		else if ((index != 0xFFFFFFFF) && (romList[index].flags & FF_BIOS))
+			record[SC_STATUS] = "bios";
+		else
+			record[SC_STATUS] = "ok";
+	}
+
+	if (record[SC_STATUS] == "ok")
+	{
+		// Keep the EEPROM saves away from the user's ones
+		QString eepromDir = QDir::tempPath() + QString("/vj-sweep-%1/").arg(QCoreApplication::applicationPid());
+		strcpy(vjs.EEPROMPath, QDir::toNativeSeparators(eepromDir).toUtf8().data());
+
+		uint32_t * screen = new uint32_t[1024 * 512];
+		memset(screen, 0, 1024 * 512 * sizeof(uint32_t));
+		JaguarSetScreenBuffer(screen);
+		JaguarSetScreenPitch(1024);
+
+		DBGManager_Init();
+		JaguarInit();
+		SelectBIOS(vjs.biosType);
+		JaguarReset();
+
+		// Same sequence as the GUI, the software is loaded *after* the reset
+		if (!JaguarLoadFile(path.data()))
+			record[SC_STATUS] = "load-failed";
+		else if (!vjs.useJaguarBIOS && !jaguarRunAddress)
+			record[SC_STATUS] = "no-run-address";
+		else
+		{
+			SET32(jaguarMainRAM, 0, vjs.DRAM_size);
+
+			if (!vjs.useJaguarBIOS)
+				SET32(jaguarMainRAM, 4, jaguarRunAddress);
+
+			m68k_pulse_reset();
+
+			int firstImage = -1;
+			QElapsedTimer timer;
+
+			if (!audioDir.isEmpty())
+				WAVCaptureStart(QDir(audioDir).filePath(QFileInfo(file).fileName() + ".wav").toUtf8().data());
+
+			PerfCountEnable(true);
+			timer.start();
+
+			for(uint32_t frame=0; frame<frames; frame++)
+			{
+				JaguarExecuteNew();
+
+				if (vjs.DSPEnabled)
+					DACRunFrame();
+
+				if (firstImage < 0)
+				{
+					for(uint32_t i=0; i<(1024 * 512); i++)
+					{
+						// Pixels are RGBA, the alpha byte doesn't count
+						if (screen[i] & 0xFFFFFF00)
+						{
+							firstImage = frame;
+							break;
+						}
+					}
+				}
+			}
+
+			PerfCountSwitch(PERF_OTHER);
+			double seconds = timer.nsecsElapsed() / 1e9;
+			PerfCountEnable(false);
+			WAVCaptureStop();
+
+			// Checksum of the displayed picture only, using the same area as the GL widget
+			uint32_t width = TOMGetVideoModeWidth();
+			uint32_t height = (vjs.hardwareTypeNTSC ? VIRTUAL_SCREEN_HEIGHT_NTSC : VIRTUAL_SCREEN_HEIGHT_PAL) * (TOMGetVP() & 0x0001 ? 1 : 2);
+			QByteArray picture;
+
+			for(uint32_t y=0; y<height; y++)
+				picture.append((const char *)(screen + (y * 1024)), width * sizeof(uint32_t));
+
+			record[SC_FRAMES] = QString::number(frames);
+			record[SC_FPS] = QString::number(seconds > 0 ? frames / seconds : 0, 'f', 1);
+
+			for(int i=0; i<PERF_MAX; i++)
+				record[SC_TIME + i] = QString::number(PerfCountGetSeconds(i), 'f', 3);
+
+			record[SC_FIRSTIMAGE] = (firstImage < 0 ? QString() : QString::number(firstImage));
+			record[SC_FRAMECRC32] = QString("%1").arg((uint32_t)crc32_calcCheckSum((unsigned char *)picture.data(), picture.size()), 8, 16, QChar('0')).toUpper();
+		}
+
+		// No JaguarDone() here, it would write out the EEPROM we are going to throw away;
+		// the pending EEPROM writes are dropped instead, before the folder goes
+		EepromDiscard();
+		DBGManager_Close();
+		delete[] screen;
+		QDir(eepromDir).removeRecursively();
+	}
+
+	printf("%s\t%s\n", SWEEP_TAG, record.join('\t').toUtf8().data());
+	fflush(stdout);
+	return 0;
+}
+
+
+static QStringList SweepColumnNames(void)
+{
+	QStringList names;
+	names << "file" << "name" << "crc32" << "status" << "frames" << "fps";
+
+	for(int i=0; i<PERF_MAX; i++)
+		names << QString("%1_s").arg(perfUnitName[i]);
+
+	names << "first_image_frame" << "frame_crc32";
+	return names;
+}
+
+
+static QStringList SweepEmptyRecord(QString file, QString status)
+{
+	QStringList record;
+
+	for(int i=0; i<SC_MAX; i++)
+		record << QString();
+
+	record[SC_FILE] = file;
+	record[SC_STATUS] = status;
+	return record;
+}
+
+
+//
+// Fish the report line out of whatever else the worker printed
+//
+static QStringList SweepReadWorker(QProcess * process, QString file)
+{
+	QList<QByteArray> lines = process->readAllStandardOutput().split('\n');
+
+	for(int i=0; i<lines.size(); i++)
+	{
+		QStringList fields = QString::fromUtf8(lines.at(i)).trimmed().split('\t');
+
+		if ((fields.size() == (SC_MAX + 1)) && (fields.at(0) == SWEEP_TAG))
+		{
+			fields.removeFirst();
+			return fields;
+		}
+	}
+
+	return SweepEmptyRecord(file, (process->exitStatus() == QProcess::CrashExit ? "crashed" : "no-report"));
+}
+
+
+static bool SweepColumnIsNumber(int column)
+{
+	return ((column >= SC_FRAMES) && (column <= SC_FIRSTIMAGE));
+}
+
+
+//
+// Write the records as JSON if the report file name ends with .json, or as
+// CSV otherwise; without a file name, the CSV goes to stdout
+//
+static bool SweepWriteReport(QVector<QStringList> & records, QString report)
+{
+	QFile file(report);
+	bool json = report.endsWith(".json", Qt::CaseInsensitive);
+
+	if (report.isEmpty())
+		file.open(stdout, QIODevice::WriteOnly);
+	else if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+	{
+		fprintf(stderr, "Sweep: Could not open \"%s\" for writing!\n", report.toUtf8().data());
+		return false;
+	}
+
+	QTextStream out(&file);
+	QStringList names = SweepColumnNames();
+
+	if (json)
+	{
+		out << "[\n";
+
+		for(int i=0; i<records.size(); i++)
+		{
+			out << "  {";
+
+			for(int j=0; j<SC_MAX; j++)
+			{
+				QString value = records[i].at(j);
+				out << (j ? ", " : " ") << "\"" << names.at(j) << "\": ";
+
+				if (SweepColumnIsNumber(j))
+					out << (value.isEmpty() ? QString("null") : value);
+				else
+					out << "\"" << QString(value).replace("\\", "\\\\").replace("\"", "\\\"") << "\"";
+			}
+
+			out << " }" << (i < (records.size() - 1) ? ",\n" : "\n");
+		}
+
+		out << "]\n";
+	}
+	else
+	{
+		out << names.join(',') << "\n";
+
+		for(int i=0; i<records.size(); i++)
+		{
+			QStringList fields;
+
+			for(int j=0; j<SC_MAX; j++)
+			{
+				QString value = records[i].at(j);
+
+				if (value.contains(',') || value.contains('"'))
+					value = "\"" + value.replace("\"", "\"\"") + "\"";
+
+				fields << value;
+			}
+
+			out << fields.join(',') << "\n";
+		}
+	}
+
+	return true;
+}
+
+
+static uint32_t FindCRCIndexInRomList(uint32_t crc)
+{
+	for(int i=0; romList[i].crc32!=0xFFFFFFFF; i++)
+	{
+		if (romList[i].crc32 == crc)
+			return i;
+	}
+
+	return 0xFFFFFFFF;
+}
@@ -0,0 +1,16 @@
+//
+// romsweep.h: Header file
+//
+
+#ifndef __ROMSWEEP_H__
+#define __ROMSWEEP_H__
+
+#include <stdint.h>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+void RomSweepDefaults(void);
+int RomSweepRun(QString dir, uint32_t frames, int jobs, QString report, QString audioDir, QStringList options);
+int RomSweepWorker(QString file, uint32_t frames, QString audioDir);
+
+#endif	// __ROMSWEEP_H__
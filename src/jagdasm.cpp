@@ -20,7 +20,11 @@
 #include <stdio.h>
 #include "jaguar.h"
 
-#define ROPCODE(a) JaguarReadWord(a)
+#define ROPCODE(a) DasmReadWord(a)
+
+// Instruction words read instead of the memory, see dasmjagcode()
+static const uint16_t * codeWords = NULL;
+static unsigned codeAddress, codeSize;
 
 uint8_t convert_zero[32] =
 { 32,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31 };
@@ -79,6 +83,15 @@ char * signed_16bit(int16_t val)
 }
 
 
+static uint16_t DasmReadWord(unsigned address)
+{
+	if (codeWords && ((address - codeAddress) < codeSize))
+		return codeWords[(address - codeAddress) >> 1];
+
+	return JaguarReadWord(address);
+}
+
+
 unsigned dasmjag(int dsp_type, char * bufferOut, unsigned pc)
 {
 	char buffer[64];
@@ -194,3 +207,18 @@ unsigned dasmjag(int dsp_type, char * bufferOut, unsigned pc)
 
 	return size;
 }
+
+
+//
+// Disassemble the instruction held by 'words' words of code, as if at pc
+//
+unsigned dasmjagcode(int dsp_type, char * bufferOut, unsigned pc, const uint16_t * code, unsigned words)
+{
+	codeWords = code;
+	codeAddress = pc;
+	codeSize = words * 2;
+	unsigned size = dasmjag(dsp_type, bufferOut, pc);
+	codeWords = NULL;
+
+	return size;
+}
@@ -1,9 +1,12 @@
 #ifndef __JAGDASM__
 #define __JAGDASM__
 
+#include <stdint.h>
+
 #define JAGUAR_GPU 0
 #define JAGUAR_DSP 1
 
 unsigned dasmjag(int dsp_type, char * buffer, unsigned pc);
+unsigned dasmjagcode(int dsp_type, char * buffer, unsigned pc, const uint16_t * code, unsigned words);
 
 #endif
@@ -27,7 +27,9 @@
 
 #include "jaguar.h"
 //#include <QApplication>
+#include <QtWidgets/QApplication>
 #include <QtWidgets/QMessageBox>
+#include <QtCore/QThread>
 #include <time.h>
 #include <SDL.h>
 #include "SDL_opengl.h"
@@ -46,8 +48,10 @@
 //#include "memory.h"
 #include "memtrack.h"
 #include "mmu.h"
+#include "perfcount.h"
 #include "settings.h"
 #include "tom.h"
+#include "trace.h"
 //#include "debugger/BreakpointsWin.h"
 #ifdef NEWMODELSBIOSHANDLER
 #include "modelsBIOS.h"
@@ -55,7 +59,6 @@
 
 #define CPU_DEBUG
 //Do this in makefile??? Yes! Could, but it's easier to define here...
-//#define LOG_UNMAPPED_MEMORY_ACCESSES
 //#define ABORT_ON_UNMAPPED_MEMORY_ACCESS
 //#define ABORT_ON_ILLEGAL_INSTRUCTIONS
 //#define ABORT_ON_OFFICIAL_ILLEGAL_INSTRUCTION
@@ -128,8 +131,14 @@ size_t bpmHitCounts;
 uint32_t bpmAddress1;
 S_BrkInfo *brkInfo;
 size_t brkNbr;
+static S_BrkMap m68kBrkMap;				// Addresses of the active M68K breakpoints
+S_WatchInfo *watchInfo;
+size_t watchNbr;
+uint8_t watchPages[BRKMAP_NB_PAGES];		// Accesses types watched per page
 
 bool frameDone;
+static bool renderFrame = true;			// False: the frame is run, but not drawn
+static uint32_t framesSkipped = 0;
 
 //
 // Callback function to detect illegal instructions
@@ -141,6 +150,10 @@ static bool start = false;
 void M68KInstructionHook(void)
 {
 	uint32_t m68kPC = m68k_get_reg(NULL, M68K_REG_PC);
+
+	if (traceActive[TRACE_M68K])
+		TraceM68K(m68kPC);
+
 // Temp, for comparing...
 {
 /*	static char buffer[2048];//, mem[64];
@@ -209,23 +222,23 @@ if (inRoutine)
 
 	if (m68kPC & 0x01)		// Oops! We're fetching an odd address!
 	{
-		WriteLog("M68K: Attempted to execute from an odd address!\n\nBacktrace:\n\n");
+		LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "M68K: Attempted to execute from an odd address!\n\nBacktrace:\n\n");
 
 		static char buffer[2048];
 		for(int i=0; i<0x400; i++)
 		{
 //			WriteLog("[A2=%08X, D0=%08X]\n", a2Queue[(pcQPtr + i) & 0x3FF], d0Queue[(pcQPtr + i) & 0x3FF]);
-			WriteLog("[A0=%08X, A1=%08X, A2=%08X, A3=%08X, A4=%08X, A5=%08X, A6=%08X, A7=%08X, D0=%08X, D1=%08X, D2=%08X, D3=%08X, D4=%08X, D5=%08X, D6=%08X, D7=%08X, SR=%04X]\n", a0Queue[(pcQPtr + i) & 0x3FF], a1Queue[(pcQPtr + i) & 0x3FF], a2Queue[(pcQPtr + i) & 0x3FF], a3Queue[(pcQPtr + i) & 0x3FF], a4Queue[(pcQPtr + i) & 0x3FF], a5Queue[(pcQPtr + i) & 0x3FF], a6Queue[(pcQPtr + i) & 0x3FF], a7Queue[(pcQPtr + i) & 0x3FF], d0Queue[(pcQPtr + i) & 0x3FF], d1Queue[(pcQPtr + i) & 0x3FF], d2Queue[(pcQPtr + i) & 0x3FF], d3Queue[(pcQPtr + i) & 0x3FF], d4Queue[(pcQPtr + i) & 0x3FF], d5Queue[(pcQPtr + i) & 0x3FF], d6Queue[(pcQPtr + i) & 0x3FF], d7Queue[(pcQPtr + i) & 0x3FF], srQueue[(pcQPtr + i) & 0x3FF]);
+			LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "[A0=%08X, A1=%08X, A2=%08X, A3=%08X, A4=%08X, A5=%08X, A6=%08X, A7=%08X, D0=%08X, D1=%08X, D2=%08X, D3=%08X, D4=%08X, D5=%08X, D6=%08X, D7=%08X, SR=%04X]\n", a0Queue[(pcQPtr + i) & 0x3FF], a1Queue[(pcQPtr + i) & 0x3FF], a2Queue[(pcQPtr + i) & 0x3FF], a3Queue[(pcQPtr + i) & 0x3FF], a4Queue[(pcQPtr + i) & 0x3FF], a5Queue[(pcQPtr + i) & 0x3FF], a6Queue[(pcQPtr + i) & 0x3FF], a7Queue[(pcQPtr + i) & 0x3FF], d0Queue[(pcQPtr + i) & 0x3FF], d1Queue[(pcQPtr + i) & 0x3FF], d2Queue[(pcQPtr + i) & 0x3FF], d3Queue[(pcQPtr + i) & 0x3FF], d4Queue[(pcQPtr + i) & 0x3FF], d5Queue[(pcQPtr + i) & 0x3FF], d6Queue[(pcQPtr + i) & 0x3FF], d7Queue[(pcQPtr + i) & 0x3FF], srQueue[(pcQPtr + i) & 0x3FF]);
 			m68k_disassemble(buffer, pcQueue[(pcQPtr + i) & 0x3FF], 0, 1);//M68K_CPU_TYPE_68000);
-			WriteLog("\t%08X: %s\n", pcQueue[(pcQPtr + i) & 0x3FF], buffer);
+			LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "\t%08X: %s\n", pcQueue[(pcQPtr + i) & 0x3FF], buffer);
 		}
-		WriteLog("\n");
+		LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "\n");
 
 		uint32_t topOfStack = m68k_get_reg(NULL, M68K_REG_A7);
-		WriteLog("M68K: Top of stack: %08X. Stack trace:\n", JaguarReadLong(topOfStack));
+		LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "M68K: Top of stack: %08X. Stack trace:\n", JaguarReadLong(topOfStack));
 		for(int i=0; i<10; i++)
-			WriteLog("%06X: %08X\n", topOfStack - (i * 4), JaguarReadLong(topOfStack - (i * 4)));
-		WriteLog("Jaguar: VBL interrupt is %s\n", ((TOMIRQEnabled(IRQ_VIDEO)) && (JaguarInterruptHandlerIsValid(64))) ? "enabled" : "disabled");
+			LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "%06X: %08X\n", topOfStack - (i * 4), JaguarReadLong(topOfStack - (i * 4)));
+		LOGCAT(LOG_CAT_M68K, LOG_LEVEL_ERROR, "Jaguar: VBL interrupt is %s\n", ((TOMIRQEnabled(IRQ_VIDEO)) && (JaguarInterruptHandlerIsValid(64))) ? "enabled" : "disabled");
 		M68K_show_context();
 		LogDone();
 		exit(0);
@@ -1056,11 +1069,56 @@ void	M68K_Debughalt(void)
 #endif
 
 
+// Clear a breakpoints addresses map
+// Only the pages having breakpoints are cleared
+void BrkMapClear(S_BrkMap * map)
+{
+	for (uint32_t i = 0; i < BRKMAP_NB_PAGES; i++)
+	{
+		if (map->PageCounts[i])
+		{
+			memset(map->Bits + ((i << BRKMAP_PAGE_SHIFT) >> 3), 0, ((1 << BRKMAP_PAGE_SHIFT) >> 3));
+			map->PageCounts[i] = 0;
+		}
+	}
+}
+
+
+// Add a breakpoint address to a breakpoints addresses map
+void BrkMapAdd(S_BrkMap * map, uint32_t adr)
+{
+	adr &= 0x00FFFFFF;
+
+	if (!(map->Bits[adr >> 3] & (1 << (adr & 7))))
+	{
+		map->Bits[adr >> 3] |= (1 << (adr & 7));
+		map->PageCounts[adr >> BRKMAP_PAGE_SHIFT]++;
+	}
+}
+
+
+// Set the M68000 breakpoints addresses map from the active breakpoints
+// It has to be done after each change in the breakpoints list
+static void m68k_brk_map(void)
+{
+	BrkMapClear(&m68kBrkMap);
+
+	for (size_t i = 0; i < brkNbr; i++)
+	{
+		if (brkInfo[i].Used && brkInfo[i].Active)
+		{
+			BrkMapAdd(&m68kBrkMap, (uint32_t)brkInfo[i].Adr);
+		}
+	}
+}
+
+
 // M68000 breakpoints initialisations
 void m68k_brk_init(void)
 {
 	brkNbr = 0;
 	brkInfo = NULL;
+	m68k_brk_map();
 }
 
 
@@ -1071,6 +1129,7 @@ void m68k_brk_reset(void)
 	free(brkInfo);
 	brkInfo = NULL;
 	brkNbr = 0;
+	m68k_brk_map();
 }
 
 
@@ -1079,6 +1138,7 @@ void m68k_brk_del(unsigned int NumBrk)
 {
 	// Remove the breakpoint
 	memset((void *)(brkInfo + (NumBrk - 1)), 0, sizeof(S_BrkInfo));
+	m68k_brk_map();
 }
 
 
@@ -1119,11 +1179,14 @@ unsigned int m68k_brk_add(void *PtrInfo)
 	// Transfert the breakpoint information and init the activities
 	memcpy((void *)Ptr, PtrInfo, sizeof(S_BrkInfo));
 	Ptr->HitCounts = 0;
-	return (Ptr->Active = Ptr->Used = true);
+	Ptr->Active = Ptr->Used = true;
+	BrkMapAdd(&m68kBrkMap, (uint32_t)Ptr->Adr);
+	return true;
 }
 
 
 // Check if breakpoint has been reached
+// The breakpoints list is only checked for an address in the breakpoints addresses map
 unsigned int m68k_brk_check(unsigned int adr)
 {
 	// Check if BPM has been reached
@@ -1134,15 +1197,18 @@ unsigned int m68k_brk_check(unsigned int adr)
 	}
 	else
 	{
-		// Check user breakpoints
-		for (size_t i = 0; i < brkNbr; i++)
+		// Check user breakpoints, if the address is in their addresses map
+		if (BrkMapCheck(&m68kBrkMap, adr))
 		{
-			if (brkInfo[i].Used && brkInfo[i].Active)
+			for (size_t i = 0; i < brkNbr; i++)
 			{
-				if (brkInfo[i].Adr == adr)
+				if (brkInfo[i].Used && brkInfo[i].Active)
 				{
-					brkInfo[i].HitCounts++;
-					return true;
+					if (brkInfo[i].Adr == adr)
+					{
+						brkInfo[i].HitCounts++;
+						return true;
+					}
 				}
 			}
 		}
@@ -1161,6 +1227,8 @@ void m68k_brk_disable(void)
 	{
 		brkInfo[i].Active = 0;
 	}
+
+	m68k_brk_map();
 }
 
 
@@ -1182,6 +1250,203 @@ void m68k_brk_close(void)
 }
 
 
+// Set the watched pages table from the active watchpoints
+// An access may start up to 3 bytes before a watched range, so its page is watched too
+static void watch_map(void)
+{
+	memset(watchPages, 0, sizeof(watchPages));
+
+	for (size_t i = 0; i < watchNbr; i++)
+	{
+		if (watchInfo[i].Used && watchInfo[i].Active)
+		{
+			uint8_t Type = ((watchInfo[i].Type & WATCH_READ) ? WATCH_READ : 0) | ((watchInfo[i].Type & (WATCH_WRITE | WATCH_CHANGE)) ? WATCH_WRITE : 0);
+			uint32_t Start = (watchInfo[i].Start >= 3) ? (watchInfo[i].Start - 3) : 0;
+
+			for (uint32_t Page = (Start >> BRKMAP_PAGE_SHIFT); Page <= (watchInfo[i].End >> BRKMAP_PAGE_SHIFT); Page++)
+			{
+				watchPages[Page] |= Type;
+			}
+		}
+	}
+}
+
+
+// Watchpoints initialisations
+void watch_init(void)
+{
+	watchNbr = 0;
+	watchInfo = NULL;
+	watch_map();
+}
+
+
+// Reset the watchpoints structures
+void watch_reset(void)
+{
+	free(watchInfo);
+	watchInfo = NULL;
+	watchNbr = 0;
+	watch_map();
+}
+
+
+// Delete a watchpoint (starting from 1)
+void watch_del(unsigned int NumWatch)
+{
+	memset((void *)(watchInfo + (NumWatch - 1)), 0, sizeof(S_WatchInfo));
+	watch_map();
+}
+
+
+// Add a watchpoint
+// return true if watchpoint has been added, and false if the same watchpoint already exists
+unsigned int watch_add(S_WatchInfo *PtrInfo)
+{
+	S_WatchInfo *Ptr = NULL;
+	uint32_t Start = (PtrInfo->Start & 0x00FFFFFF);
+	uint32_t End = (PtrInfo->End & 0x00FFFFFF);
+
+	// Range is kept in the increasing order
+	if (End < Start)
+	{
+		uint32_t Adr = Start;
+		Start = End;
+		End = Adr;
+	}
+
+	// Check if watchpoint already exists
+	for (size_t i = 0; i < watchNbr; i++)
+	{
+		if (watchInfo[i].Used && (watchInfo[i].Start == Start) && (watchInfo[i].End == End) && (watchInfo[i].Type == PtrInfo->Type) && (watchInfo[i].WhoMask == PtrInfo->WhoMask))
+		{
+			return false;
+		}
+	}
+
+	// Look for an available watchpoint
+	for (size_t i = 0; (i < watchNbr) && !Ptr; i++)
+	{
+		if (!watchInfo[i].Used)
+		{
+			Ptr = &watchInfo[i];
+		}
+	}
+
+	// Add a watchpoint
+	if (!Ptr)
+	{
+		watchInfo = (S_WatchInfo *)realloc(watchInfo, (++watchNbr * sizeof(S_WatchInfo)));
+		Ptr = &watchInfo[watchNbr - 1];
+	}
+
+	// Transfert the watchpoint information and init the activities
+	memcpy((void *)Ptr, PtrInfo, sizeof(S_WatchInfo));
+	Ptr->Start = Start;
+	Ptr->End = End;
+	Ptr->HitCounts = 0;
+	Ptr->Active = Ptr->Used = true;
+	watch_map();
+	return true;
+}
+
+
+// Disable the watchpoints
+void watch_disable(void)
+{
+	for (size_t i = 0; i < watchNbr; i++)
+	{
+		watchInfo[i].Active = false;
+	}
+
+	watch_map();
+}
+
+
+// Reset the watchpoints hit counts
+void watch_hitcounts_reset(void)
+{
+	for (size_t i = 0; i < watchNbr; i++)
+	{
+		watchInfo[i].HitCounts = 0;
+	}
+}
+
+
+// Close the watchpoints structures
+void watch_close(void)
+{
+	free(watchInfo);
+}
+
+
+// Check if a write changes the memory value
+// Only the main RAM, and the GPU & DSP local RAM, can be read without side effects, so any other write is seen as a change
+static bool watch_changed(uint32_t adr, uint32_t size, uint32_t value)
+{
+	uint32_t Old = 0;
+
+	if (adr < 0x800000)
+	{
+		for (uint32_t i = 0; i < size; i++)
+		{
+			Old = (Old << 8) | jaguarMainRAM[(adr + i) & (vjs.DRAM_size - 1)];
+		}
+	}
+	else if ((adr >= GPU_WORK_RAM_BASE) && ((adr + size - 1) <= (GPU_WORK_RAM_BASE + 0x0FFF)))
+	{
+		for (uint32_t i = 0; i < size; i++)
+		{
+			Old = (Old << 8) | GPUReadByte(adr + i, DEBUG);
+		}
+	}
+	else if ((adr >= DSP_WORK_RAM_BASE) && ((adr + size - 1) <= (DSP_WORK_RAM_BASE + 0x1FFF)))
+	{
+		for (uint32_t i = 0; i < size; i++)
+		{
+			Old = (Old << 8) | DSPReadByte(adr + i, DEBUG);
+		}
+	}
+	else
+	{
+		return true;
+	}
+
+	return (Old != (value & (0xFFFFFFFF >> ((4 - size) << 3))));
+}
+
+
+// Check if an access reaches a watchpoint, and halt the emulation if so
+// The write accesses are checked before the memory is written
+void watch_check(uint32_t adr, uint32_t size, uint32_t type, uint32_t value, uint32_t who)
+{
+	// Debugger accesses are not watched
+	if (who == DEBUG)
+	{
+		return;
+	}
+
+	adr &= 0x00FFFFFF;
+
+	for (size_t i = 0; i < watchNbr; i++)
+	{
+		S_WatchInfo *Ptr = &watchInfo[i];
+
+		if (Ptr->Used && Ptr->Active && (adr <= Ptr->End) && ((adr + size - 1) >= Ptr->Start) && (!Ptr->WhoMask || (Ptr->WhoMask & (1 << who))))
+		{
+			if ((type == WATCH_READ) ? (Ptr->Type & WATCH_READ) : ((Ptr->Type & WATCH_WRITE) || ((Ptr->Type & WATCH_CHANGE) && watch_changed(adr, size, value))))
+			{
+				Ptr->HitCounts++;
+				Ptr->HitAdr = adr;
+				Ptr->HitWho = who;
+				Ptr->HitValue = value;
+				M68KDebugHalt();
+			}
+		}
+	}
+}
+
+
 // Read 1 byte from address
 // Check if address reaches a breakpoint
 unsigned int m68k_read_memory_8(unsigned int address)
@@ -1194,6 +1459,9 @@ unsigned int m68k_read_memory_8(unsigned int address)
 	}
 #endif
 
+	// Check the watchpoints
+	watch_access(address, 1, WATCH_READ, 0, M68K);
+
 	// Musashi does this automagically for you, UAE core does not :-P
 	address &= 0x00FFFFFF;
 #ifdef CPU_DEBUG_MEMORY
@@ -1286,6 +1554,9 @@ unsigned int m68k_read_memory_16(unsigned int address)
 	}
 #endif
 
+	// Check the watchpoints
+	watch_access(address, 2, WATCH_READ, 0, M68K);
+
 	// Musashi does this automagically for you, UAE core does not :-P
 	address &= 0x00FFFFFF;
 #ifdef CPU_DEBUG_MEMORY
@@ -1423,21 +1694,55 @@ unsigned int m68k_read_memory_16(unsigned int address)
 }
 
 
+// Display an alert message box
+// The box is always run by the GUI thread, as the emulation may run on its own thread; without GUI, the default button is the answer
+static int JaguarAlert(QString text, QString informativeText, QMessageBox::StandardButtons buttons, QMessageBox::StandardButton defaultButton)
+{
+	int retVal = defaultButton;
+
+	if (qobject_cast<QApplication *>(QCoreApplication::instance()))
+	{
+		auto Alert = [&]()
+		{
+			QMessageBox msgBox;
+
+			msgBox.setText(text);
+
+			if (!informativeText.isEmpty())
+			{
+				msgBox.setInformativeText(informativeText);
+			}
+
+			msgBox.setStandardButtons(buttons);
+			msgBox.setDefaultButton(defaultButton);
+			retVal = msgBox.exec();
+		};
+
+		if (QThread::currentThread() == qApp->thread())
+		{
+			Alert();
+		}
+		else
+		{
+			QMetaObject::invokeMethod(qApp, Alert, Qt::BlockingQueuedConnection);
+		}
+	}
+
+	return retVal;
+}
+
+
 // Alert message in case of exception vector request
 bool m68k_read_exception_vector(unsigned int address, char *text)
 {
 	QString msg;
-	QMessageBox msgBox;
 
 #if 0
 	msg.sprintf("68000 exception\n%s at $%06x", text, pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF]);
 #else
 	msg.sprintf("68000 exception\n$%06x: %s", pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF], text);
 #endif
-	msgBox.setText(msg);
-	msgBox.setStandardButtons(QMessageBox::Abort);
-	msgBox.setDefaultButton(QMessageBox::Abort);
-	msgBox.exec();
+	JaguarAlert(msg, QString(), QMessageBox::Abort, QMessageBox::Abort);
 	return M68KDebugHalt();
 }
 
@@ -1496,6 +1801,8 @@ unsigned int m68k_read_memory_32(unsigned int address)
 		// check ROM or Memory Track access
 		if ((address >= 0x800000) && (address <= 0xDFFEFE))
 		{
+			// Check the watchpoints, as the 16 bits reads are not used
+			watch_access(address, 4, WATCH_READ, 0, M68K);
 			// Memory Track reading...
 			if (((TOMGetMEMCON1() & 0x0006) == (2 << 1)) && (jaguarMainROMCRC32 == 0xFDF37F47))
 			{
@@ -1511,6 +1818,7 @@ unsigned int m68k_read_memory_32(unsigned int address)
 	// return value from memory
 	return (m68k_read_memory_16(address) << 16) | m68k_read_memory_16(address + 2);
 #else
+	watch_access(address, 4, WATCH_READ, 0, M68K);
 	return MMURead32(address, M68K);
 #endif
 }
@@ -1520,13 +1828,9 @@ unsigned int m68k_read_memory_32(unsigned int address)
 bool m68k_write_unknown_alert(unsigned int address, char *bits, unsigned int value)
 {
 	QString msg;
-	QMessageBox msgBox;
 
 	msg.sprintf("$%06x: Writing at this unknown memory location $%06x with a (%s bits) value of $%0x", pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF], address, bits, value);
-	msgBox.setText(msg);
-	msgBox.setStandardButtons(QMessageBox::Abort);
-	msgBox.setDefaultButton(QMessageBox::Abort);
-	msgBox.exec();
+	JaguarAlert(msg, QString(), QMessageBox::Abort, QMessageBox::Abort);
 	return M68KDebugHalt();
 }
 
@@ -1537,16 +1841,9 @@ bool m68k_write_cartridge_alert(unsigned int address, char *bits, unsigned int v
 	if (!M68KDebugHaltStatus())
 	{
 		QString msg;
-		QMessageBox msgBox;
 
 		msg.sprintf("$%06x: Writing at this ROM cartridge location $%06x with a (%s bits) value of $%0x", pcQueue[pcQPtr ? (pcQPtr - 1) : 0x3FF], address, bits, value);
-		msgBox.setText(msg);
-
-		msgBox.setInformativeText("Do you want to continue?");
-		msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-		msgBox.setDefaultButton(QMessageBox::No);
-
-		int retVal = msgBox.exec();
+		int retVal = JaguarAlert(msg, "Do you want to continue?", QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
 
 		if (retVal == QMessageBox::Yes)
 		{
@@ -1617,6 +1914,8 @@ void m68k_write_memory_8(unsigned int address, unsigned int value)
 	// Check memory write location on 8 bits
 	if (!m68k_write_memory_check(address, "8", value))
 	{
+		// Check the watchpoints
+		watch_access(address, 1, WATCH_WRITE, value, M68K);
 		// Musashi does this automagically for you, UAE core does not :-P
 		//address &= 0x00FFFFFF;
 #ifdef CPU_DEBUG_MEMORY
@@ -1699,6 +1998,8 @@ void m68k_write_memory_16(unsigned int address, unsigned int value)
 	// Check memory write location on 16 bits
 	if (!m68k_write_memory_check(address, "16", value))
 	{
+		// Check the watchpoints
+		watch_access(address, 2, WATCH_WRITE, value, M68K);
 		// Musashi does this automagically for you, UAE core does not :-P
 		//address &= 0x00FFFFFF;
 #ifdef CPU_DEBUG_MEMORY
@@ -1802,9 +2103,7 @@ void m68k_write_memory_16(unsigned int address, unsigned int value)
 						else
 						{
 							jaguar_unknown_writeword(address, value, M68K);
-#ifdef LOG_UNMAPPED_MEMORY_ACCESSES
-							WriteLog("\tA0=%08X, A1=%08X, D0=%08X, D1=%08X\n", m68k_get_reg(NULL, M68K_REG_A0), m68k_get_reg(NULL, M68K_REG_A1), m68k_get_reg(NULL, M68K_REG_D0), m68k_get_reg(NULL, M68K_REG_D1));
-#endif
+							LOGCAT(LOG_CAT_MEMORY, LOG_LEVEL_DEBUG, "\tA0=%08X, A1=%08X, D0=%08X, D1=%08X\n", m68k_get_reg(NULL, M68K_REG_A0), m68k_get_reg(NULL, M68K_REG_A1), m68k_get_reg(NULL, M68K_REG_D0), m68k_get_reg(NULL, M68K_REG_D1));
 						}
 					}
 				}
@@ -1851,6 +2150,7 @@ void m68k_write_memory_32(unsigned int address, unsigned int value)
 		m68k_write_memory_16(address, value >> 16);
 		m68k_write_memory_16(address + 2, value & 0xFFFF);
 #else
+		watch_access(address, 4, WATCH_WRITE, value, M68K);
 		MMUWrite32(address, value, M68K);
 #endif
 	}
@@ -1872,6 +2172,9 @@ bool JaguarInterruptHandlerIsValid(uint32_t i) // Debug use only...
 
 void M68K_show_context(void)
 {
+	if (!LOG_ENABLED(LOG_CAT_M68K, LOG_LEVEL_DEBUG))
+		return;
+
 	WriteLog("68K PC=%06X\n", m68k_get_reg(NULL, M68K_REG_PC));
 
 	for(int i=M68K_REG_D0; i<=M68K_REG_D7; i++)
@@ -1948,9 +2251,7 @@ void M68K_show_context(void)
 void jaguar_unknown_writebyte(unsigned address, unsigned data, uint32_t who/*=UNKNOWN*/)
 {
 	m68k_write_unknown_alert(address, "8", data);
-#ifdef LOG_UNMAPPED_MEMORY_ACCESSES
-	WriteLog("Jaguar: Unknown byte %02X written at %08X by %s (M68K PC=%06X)\n", data, address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+	LOGCAT(LOG_CAT_MEMORY, LOG_LEVEL_DEBUG, "Jaguar: Unknown byte %02X written at %08X by %s (M68K PC=%06X)\n", data, address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
 #ifdef ABORT_ON_UNMAPPED_MEMORY_ACCESS
 //	extern bool finished;
 	finished = true;
@@ -1964,9 +2265,7 @@ void jaguar_unknown_writebyte(unsigned address, unsigned data, uint32_t who/*=UN
 void jaguar_unknown_writeword(unsigned address, unsigned data, uint32_t who/*=UNKNOWN*/)
 {
 	m68k_write_unknown_alert(address, "16", data);
-#ifdef LOG_UNMAPPED_MEMORY_ACCESSES
-	WriteLog("Jaguar: Unknown word %04X written at %08X by %s (M68K PC=%06X)\n", data, address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+	LOGCAT(LOG_CAT_MEMORY, LOG_LEVEL_DEBUG, "Jaguar: Unknown word %04X written at %08X by %s (M68K PC=%06X)\n", data, address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
 #ifdef ABORT_ON_UNMAPPED_MEMORY_ACCESS
 //	extern bool finished;
 	finished = true;
@@ -1979,9 +2278,7 @@ void jaguar_unknown_writeword(unsigned address, unsigned data, uint32_t who/*=UN
 
 unsigned jaguar_unknown_readbyte(unsigned address, uint32_t who/*=UNKNOWN*/)
 {
-#ifdef LOG_UNMAPPED_MEMORY_ACCESSES
-	WriteLog("Jaguar: Unknown byte read at %08X by %s (M68K PC=%06X)\n", address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+	LOGCAT(LOG_CAT_MEMORY, LOG_LEVEL_DEBUG, "Jaguar: Unknown byte read at %08X by %s (M68K PC=%06X)\n", address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
 #ifdef ABORT_ON_UNMAPPED_MEMORY_ACCESS
 //	extern bool finished;
 	finished = true;
@@ -1995,9 +2292,7 @@ unsigned jaguar_unknown_readbyte(unsigned address, uint32_t who/*=UNKNOWN*/)
 
 unsigned jaguar_unknown_readword(unsigned address, uint32_t who/*=UNKNOWN*/)
 {
-#ifdef LOG_UNMAPPED_MEMORY_ACCESSES
-	WriteLog("Jaguar: Unknown word read at %08X by %s (M68K PC=%06X)\n", address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
-#endif
+	LOGCAT(LOG_CAT_MEMORY, LOG_LEVEL_DEBUG, "Jaguar: Unknown word read at %08X by %s (M68K PC=%06X)\n", address, whoName[who], m68k_get_reg(NULL, M68K_REG_PC));
 #ifdef ABORT_ON_UNMAPPED_MEMORY_ACCESS
 //	extern bool finished;
 	finished = true;
@@ -2057,6 +2352,7 @@ uint8_t JaguarReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
 	uint8_t data = 0x00;
 	offset &= 0xFFFFFF;
+	watch_access(offset, 1, WATCH_READ, 0, who);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset < 0x800000)
@@ -2083,6 +2379,7 @@ uint8_t JaguarReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 uint16_t JaguarReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
 	offset &= 0xFFFFFF;
+	watch_access(offset, 2, WATCH_READ, 0, who);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset < 0x800000)
@@ -2124,6 +2421,7 @@ void JaguarWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 		WriteLog("JWB: Byte %02X written at %08X by %s\n", data, offset, whoName[who]);//*/
 
 	offset &= 0xFFFFFF;
+	watch_access(offset, 1, WATCH_WRITE, data, who);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset < 0x800000)
@@ -2175,6 +2473,7 @@ if (offset == 0x0102)//64*4)
 	WriteLog("Jaguar: Word %04X written to TOC+%02X by %s\n", data, offset-0x2C00, whoName[who]);//*/
 
 	offset &= 0xFFFFFF;
+	watch_access(offset, 2, WATCH_WRITE, data, who);
 
 	// First 2M is mirrored in the $0 - $7FFFFF range
 	if (offset <= 0x7FFFFE)
@@ -2330,6 +2629,38 @@ void JaguarSetScreenPitch(uint32_t pitch)
 }
 
 
+//
+// Set where TOM puts the hash of each screen buffer line it draws, so the
+// display can upload the changed lines only (NULL: no hashes)
+//
+void JaguarSetScreenLineHash(uint32_t * hashes)
+{
+	// This is in TOM, but we set it here...
+	screenLineHash = hashes;
+}
+
+
+//
+// Decide, from the frame skip setting, if the next frame run has to be drawn.
+// The host being late is only taken into account by the automatic frame skip,
+// which still draws one frame out of FRAMESKIP_MAX + 1.
+// Returns true if the frame will be drawn.
+//
+bool JaguarFrameSkip(bool late)
+{
+	bool skip;
+
+	if (vjs.frameSkip == FRAMESKIP_AUTO)
+		skip = late && (framesSkipped < FRAMESKIP_MAX);
+	else
+		skip = framesSkipped < vjs.frameSkip;
+
+	framesSkipped = (skip ? framesSkipped + 1 : 0);
+	renderFrame = !skip;
+	return renderFrame;
+}
+
+
 //
 // Jaguar console initialization
 //
@@ -2366,6 +2697,7 @@ memset(jaguarMainRAM + 0x804, 0xFF, 4);
 	JERRYInit();
 	CDROMInit();
 	m68k_brk_init();
+	watch_init();
 }
 
 
@@ -2410,7 +2742,8 @@ void JaguarReset(void)
 	DSPReset();
 	CDROMReset();
     m68k_pulse_reset();								// Reset the 68000
-	WriteLog("Jaguar: 68K reset. PC=%06X SP=%08X\n", m68k_get_reg(NULL, M68K_REG_PC), m68k_get_reg(NULL, M68K_REG_A7));
+	TraceReset();
+	LOGCAT(LOG_CAT_M68K, LOG_LEVEL_INFO, "Jaguar: 68K reset. PC=%06X SP=%08X\n", m68k_get_reg(NULL, M68K_REG_PC), m68k_get_reg(NULL, M68K_REG_A7));
 	lowerField = false;								// Reset the lower field flag
 //	SetCallbackTime(ScanlineCallback, 63.5555);
 //	SetCallbackTime(ScanlineCallback, 31.77775);
@@ -2458,7 +2791,7 @@ void JaguarDone(void)
 //	for(int i=M68K_REG_A0; i<=M68K_REG_A7; i++)
 //		WriteLog("\tA%i = 0x%.8x\n", i-M68K_REG_A0, m68k_get_reg(NULL, (m68k_register_t)i));
 	int32_t topOfStack = m68k_get_reg(NULL, M68K_REG_A7);
-	WriteLog("M68K: Top of stack: %08X -> (%08X). Stack trace:\n", topOfStack, JaguarReadLong(topOfStack));
+	LOGCAT(LOG_CAT_M68K, LOG_LEVEL_DEBUG, "M68K: Top of stack: %08X -> (%08X). Stack trace:\n", topOfStack, JaguarReadLong(topOfStack));
 #if 0
 	for(int i=-2; i<9; i++)
 		WriteLog("%06X: %08X\n", topOfStack + (i * 4), JaguarReadLong(topOfStack + (i * 4)));
@@ -2467,15 +2800,15 @@ void JaguarDone(void)
 
 	for(int i=0; i<10; i++)
 	{
-		WriteLog("%06X:", address);
+		LOGCAT(LOG_CAT_M68K, LOG_LEVEL_DEBUG, "%06X:", address);
 
 		for(int j=0; j<4; j++)
 		{
-			WriteLog(" %08X", JaguarReadLong(address));
+			LOGCAT(LOG_CAT_M68K, LOG_LEVEL_DEBUG, " %08X", JaguarReadLong(address));
 			address += 4;
 		}
 
-		WriteLog("\n");
+		LOGCAT(LOG_CAT_M68K, LOG_LEVEL_DEBUG, "\n");
 	}
 #endif
 
@@ -2509,8 +2842,8 @@ void JaguarDone(void)
 	WriteLog("\n");//*/
 
 //	WriteLog("Jaguar: CD BIOS version %04X\n", JaguarReadWord(0x3004));
-	WriteLog("Jaguar: Interrupt enable = $%02X\n", TOMReadByte(0xF000E1, JAGUAR) & 0x1F);
-	WriteLog("Jaguar: Video interrupt is %s (line=%u)\n", ((TOMIRQEnabled(IRQ_VIDEO))
+	LOGCAT(LOG_CAT_M68K, LOG_LEVEL_DEBUG, "Jaguar: Interrupt enable = $%02X\n", TOMReadByte(0xF000E1, JAGUAR) & 0x1F);
+	LOGCAT(LOG_CAT_M68K, LOG_LEVEL_DEBUG, "Jaguar: Video interrupt is %s (line=%u)\n", ((TOMIRQEnabled(IRQ_VIDEO))
 		&& (JaguarInterruptHandlerIsValid(64))) ? "enabled" : "disabled", TOMReadWord(0xF0004E, JAGUAR));
 	M68K_show_context();
 //#endif
@@ -2521,6 +2854,7 @@ void JaguarDone(void)
 	TOMDone();
 	JERRYDone();
 	m68k_brk_close();
+	watch_close();
 
 	// temp, until debugger is in place
 //00802016: jsr     $836F1A.l
@@ -2598,14 +2932,22 @@ void JaguarExecuteNew(void)
 		double timeToNextEvent = GetTimeToNextEvent();
 //WriteLog("JEN: Time to next event (%u) is %f usec (%u RISC cycles)...\n", nextEvent, timeToNextEvent, USEC_TO_RISC_CYCLES(timeToNextEvent));
 
+		PerfCountSwitch(PERF_M68K);
 		m68k_execute(USEC_TO_M68K_CYCLES(timeToNextEvent));
 
 		if (vjs.GPUEnabled)
+		{
+			PerfCountSwitch(PERF_GPU);
 			GPUExec(USEC_TO_RISC_CYCLES(timeToNextEvent));
+		}
 
+		PerfCountSwitch(PERF_OTHER);
 		HandleNextEvent();
  	}
 	while (!frameDone);
+
+	// A skipped frame has to be asked for each time
+	renderFrame = true;
 }
 
 
@@ -2769,7 +3111,7 @@ void HalflineCallback(void)
 		m68k_set_irq(2);
 	}
 
-	TOMExecHalfline(vc, true);
+	TOMExecHalfline(vc, renderFrame);
 
 //Change this to VBB???
 //Doesn't seem to matter (at least for Flip Out & I-War)
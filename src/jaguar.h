@@ -12,14 +12,56 @@ typedef struct BrkInfo
 	bool Active;				// Active breakpoint
 	char *Name;					// Functions's name
 	char *Filename;				// Source filename
-	char *LineSrc;				// Source code line
 	size_t NumLine;				// Line number
 	size_t Adr;					// Breakpoint address
 	size_t HitCounts;			// Hit counts
 }S_BrkInfo;
 
+// Breakpoints addresses map, over the 24-bit address range: a bit per address, and
+// a count of the bits set per 4 KB page, so most checks only read the page counts
+#define BRKMAP_PAGE_SHIFT		12
+#define BRKMAP_NB_PAGES			(0x1000000 >> BRKMAP_PAGE_SHIFT)
+
+typedef struct BrkMap
+{
+	uint16_t PageCounts[BRKMAP_NB_PAGES];
+	uint8_t Bits[0x1000000 >> 3];
+}S_BrkMap;
+
+void BrkMapClear(S_BrkMap * map);
+void BrkMapAdd(S_BrkMap * map, uint32_t adr);
+
+// Check if an address may have a breakpoint; the breakpoints list is then to be checked
+static inline bool BrkMapCheck(S_BrkMap * map, uint32_t adr)
+{
+	adr &= 0x00FFFFFF;
+	return map->PageCounts[adr >> BRKMAP_PAGE_SHIFT] && (map->Bits[adr >> 3] & (1 << (adr & 7)));
+}
+
+// Watchpoints accesses types
+#define WATCH_READ			0x01		// Read access
+#define WATCH_WRITE			0x02		// Write access
+#define WATCH_CHANGE		0x04		// Write access changing the value
+
+// Watchpoint structure, on the accesses of the bus masters (see the memory.h enum) in an addresses range
+typedef struct WatchInfo
+{
+	bool Used;					// Allocated watchpoint
+	bool Active;				// Active watchpoint
+	uint32_t Start;				// First address
+	uint32_t End;				// Last address
+	uint32_t Type;				// Accesses types (WATCH_xxx)
+	uint32_t WhoMask;			// Bus masters (1 << who), or 0 for all of them
+	size_t HitCounts;			// Hit counts
+	uint32_t HitAdr;			// Last hit address
+	uint32_t HitWho;			// Last hit bus master
+	uint32_t HitValue;			// Last hit written value
+}S_WatchInfo;
+
 void JaguarSetScreenBuffer(uint32_t * buffer);
 void JaguarSetScreenPitch(uint32_t pitch);
+void JaguarSetScreenLineHash(uint32_t * hashes);
+bool JaguarFrameSkip(bool late);
 extern void JaguarInit(void);
 extern void JaguarReset(void);
 extern void JaguarDone(void);
@@ -51,6 +93,29 @@ extern uint32_t bpmAddress1;
 extern bool startM68KTracing;
 extern S_BrkInfo *brkInfo;
 extern size_t brkNbr;
+extern S_WatchInfo *watchInfo;
+extern size_t watchNbr;
+extern uint8_t watchPages[BRKMAP_NB_PAGES];
+
+// Watchpoints functions
+void watch_init(void);
+void watch_reset(void);
+unsigned int watch_add(S_WatchInfo *PtrInfo);
+void watch_del(unsigned int NumWatch);
+void watch_disable(void);
+void watch_hitcounts_reset(void);
+void watch_close(void);
+void watch_check(uint32_t adr, uint32_t size, uint32_t type, uint32_t value, uint32_t who);
+
+// Check an access with the watchpoints
+// An access in an unwatched page only costs a look up in the watched pages table
+static inline void watch_access(uint32_t adr, uint32_t size, uint32_t type, uint32_t value, uint32_t who)
+{
+	if (watchPages[(adr & 0x00FFFFFF) >> BRKMAP_PAGE_SHIFT] & type)
+	{
+		watch_check(adr, size, type, value, who);
+	}
+}
 
 // Various clock rates
 
@@ -171,7 +171,6 @@
 #include "wavetable.h"
 
 //Note that 44100 Hz requires samples every 22.675737 usec.
-//#define JERRY_DEBUG
 
 /*static*/ uint8_t jerry_ram_8[0x10000];
 
@@ -312,11 +311,13 @@ void JERRYI2SCallback(void)
 	// If INTERNAL flag is set, then JERRY's SCLK is master
 	if (smode & SMODE_INTERNAL)
 	{
-		// This does the 'IRQ enabled' checking...
-		DSPSetIRQLine(DSPIRQ_SSI, ASSERT_LINE);
 //		double usecs = (float)jerryI2SCycles * RISC_CYCLE_IN_USEC;
 //this fix is almost enough to fix timings in tripper, but not quite enough...
 		double usecs = (float)jerryI2SCycles * (vjs.hardwareTypeNTSC ? RISC_CYCLE_IN_USEC : RISC_CYCLE_PAL_IN_USEC);
+		// The word written by the DSP on the previous interrupt goes out now
+		DACI2SSample(usecs);
+		// This does the 'IRQ enabled' checking...
+		DSPSetIRQLine(DSPIRQ_SSI, ASSERT_LINE);
 		SetCallbackTime(JERRYI2SCallback, usecs, EVENT_JERRY);
 	}
 	else
@@ -344,6 +345,8 @@ void JERRYI2SCallback(void)
 			jerry_i2s_interrupt_timer += 602;
 		}*/
 
+		DACI2SSample(22.675737);
+
 		if (ButchIsReadyToSend())//Not sure this is right spot to check...
 		{
 //	return GetWordFromButchSSI(offset, who);
@@ -397,7 +400,7 @@ void JERRYReset(void)
 void JERRYDone(void)
 {
 	JERRYDumpIORegistersToLog();
-	WriteLog("JERRY: M68K Interrupt control ($F10020) = %04X\n", GET16(jerry_ram_8, 0x20));
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: M68K Interrupt control ($F10020) = %04X\n", GET16(jerry_ram_8, 0x20));
 	JoystickDone();
 	DACDone();
 	EepromDone();
@@ -425,6 +428,9 @@ void JERRYSetPendingIRQ(int irq)
 //
 void JERRYDumpIORegistersToLog(void)
 {
+	if (!LOG_ENABLED(LOG_CAT_JERRY, LOG_LEVEL_DEBUG))
+		return;
+
 	WriteLog("\n\n---------------------------------------------------------------------\n");
 	WriteLog("JERRY I/O Registers\n");
 	WriteLog("---------------------------------------------------------------------\n");
@@ -450,9 +456,7 @@ void JERRYDumpIORegistersToLog(void)
 //
 uint8_t JERRYReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
-#ifdef JERRY_DEBUG
-	WriteLog("JERRY: Reading byte at %06X\n", offset);
-#endif
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_TRACE, "JERRY: Reading byte at %06X\n", offset);
 	if ((offset >= DSP_CONTROL_RAM_BASE) && (offset < DSP_CONTROL_RAM_BASE+0x20))
 		return DSPReadByte(offset, who);
 	else if ((offset >= DSP_WORK_RAM_BASE) && (offset < DSP_WORK_RAM_BASE+0x2000))
@@ -473,7 +477,7 @@ uint8_t JERRYReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //under the new system... !!! FIX !!!
 	else if ((offset >= 0xF10036) && (offset <= 0xF1003D))
 	{
-WriteLog("JERRY: Unhandled timer read (BYTE) at %08X...\n", offset);
+LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_WARNING, "JERRY: Unhandled timer read (BYTE) at %08X...\n", offset);
 	}
 //	else if (offset >= 0xF10010 && offset <= 0xF10015)
 //		return clock_byte_read(offset);
@@ -504,9 +508,7 @@ WriteLog("JERRY: Unhandled timer read (BYTE) at %08X...\n", offset);
 //
 uint16_t JERRYReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
-#ifdef JERRY_DEBUG
-	WriteLog("JERRY: Reading word at %06X\n", offset);
-#endif
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_TRACE, "JERRY: Reading word at %06X\n", offset);
 
 	if ((offset >= DSP_CONTROL_RAM_BASE) && (offset < DSP_CONTROL_RAM_BASE+0x20))
 		return DSPReadWord(offset, who);
@@ -525,7 +527,7 @@ uint16_t JERRYReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 //in the jerry_timer_n_counter variables... !!! FIX !!! [DONE]
 	else if ((offset >= 0xF10036) && (offset <= 0xF1003D))
 	{
-WriteLog("JERRY: Unhandled timer read (WORD) at %08X...\n", offset);
+LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_WARNING, "JERRY: Unhandled timer read (WORD) at %08X...\n", offset);
 	}
 //	else if ((offset >= 0xF10010) && (offset <= 0xF10015))
 //		return clock_word_read(offset);
@@ -557,9 +559,7 @@ void JERRYWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 	// Moved here tentatively, so we can see everything written to JERRY.
 	jerry_ram_8[offset & 0xFFFF] = data;
 
-#ifdef JERRY_DEBUG
-	WriteLog("jerry: writing byte %.2x at 0x%.6x\n",data,offset);
-#endif
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_TRACE, "jerry: writing byte %.2x at 0x%.6x\n",data,offset);
 	if ((offset >= DSP_CONTROL_RAM_BASE) && (offset < DSP_CONTROL_RAM_BASE + 0x20))
 	{
 		DSPWriteByte(offset, data, who);
@@ -599,7 +599,7 @@ void JERRYWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 	}
 	else if (offset >= 0xF10000 && offset <= 0xF10007)
 	{
-WriteLog("JERRY: Unhandled timer write (BYTE) at %08X...\n", offset);
+LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_WARNING, "JERRY: Unhandled timer write (BYTE) at %08X...\n", offset);
 		return;
 	}
 /*	else if ((offset >= 0xF10010) && (offset <= 0xF10015))
@@ -627,7 +627,7 @@ WriteLog("JERRY: Unhandled timer write (BYTE) at %08X...\n", offset);
 	}*/
 	else if ((offset >= 0xF14000) && (offset <= 0xF14003))
 	{
-WriteLog("JERRYWriteByte: Unhandled byte write to JOYSTICK by %s.\n", whoName[who]);
+LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_WARNING, "JERRYWriteByte: Unhandled byte write to JOYSTICK by %s.\n", whoName[who]);
 //		JoystickWriteByte(offset, data);
 		JoystickWriteWord(offset & 0xFE, (uint16_t)data);
 // This is wrong, EEPROM is never written here
@@ -657,30 +657,28 @@ void JERRYWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 	jerry_ram_8[(offset+0) & 0xFFFF] = (data >> 8) & 0xFF;
 	jerry_ram_8[(offset+1) & 0xFFFF] = data & 0xFF;
 
-#ifdef JERRY_DEBUG
-	WriteLog( "JERRY: Writing word %04X at %06X\n", data, offset);
-#endif
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_TRACE, "JERRY: Writing word %04X at %06X\n", data, offset);
 #if 1
 if (offset == 0xF10000)
-	WriteLog("JERRY: JPIT1 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: JPIT1 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10002)
-	WriteLog("JERRY: JPIT2 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: JPIT2 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10004)
-	WriteLog("JERRY: JPIT3 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: JPIT3 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10006)
-	WriteLog("JERRY: JPIT4 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: JPIT4 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10010)
-	WriteLog("JERRY: CLK1 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: CLK1 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10012)
-	WriteLog("JERRY: CLK2 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: CLK2 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10014)
-	WriteLog("JERRY: CLK3 word written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: CLK3 word written by %s: %u\n", whoName[who], data);
 //else if (offset == 0xF1A100)
 //	WriteLog("JERRY: D_FLAGS word written by %s: %u\n", whoName[who], data);
 //else if (offset == 0xF1A102)
 //	WriteLog("JERRY: D_FLAGS+2 word written by %s: %u\n", whoName[who], data);
 else if (offset == 0xF10020)
-	WriteLog("JERRY: JINTCTRL word written by %s: $%04X (%s%s%s%s%s%s)\n", whoName[who], data,
+	LOGCAT(LOG_CAT_JERRY, LOG_LEVEL_DEBUG, "JERRY: JINTCTRL word written by %s: $%04X (%s%s%s%s%s%s)\n", whoName[who], data,
 		(data & 0x01 ? "Extrnl " : ""), (data & 0x02 ? "DSP " : ""),
 		(data & 0x04 ? "Timer0 " : ""), (data & 0x08 ? "Timer1 " : ""),
 		(data & 0x10 ? "ASI " : ""), (data & 0x20 ? "I2S " : ""));
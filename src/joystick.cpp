@@ -32,10 +32,6 @@ bool joysticksEnabled = false;
 
 
 bool GUIKeyHeld = false;
-extern int start_logging;
-int gpu_start_log = 0;
-int op_start_log = 0;
-int blit_start_log = 0;
 int effect_start = 0;
 int effect_start2 = 0, effect_start3 = 0, effect_start4 = 0, effect_start5 = 0, effect_start6 = 0;
 bool interactiveMode = false;
@@ -58,10 +54,8 @@ void JoystickInit(void)
 
 void JoystickExec(void)
 {
-	gpu_start_log = 0;							// Only log while key down!
 	effect_start = 0;
 	effect_start2 = effect_start3 = effect_start4 = effect_start5 = effect_start6 = 0;
-	blit_start_log = 0;
 	iLeft = iRight = false;
 }
 
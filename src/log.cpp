@@ -16,27 +16,121 @@
 //                  enough for anybody. ;-) Except when it isn't. :-P
 //
 
-//#include "log.h"
+// Log lines used to be written with an fflush() each, so that nothing was lost
+// on a crash; with the GPU, blitter or OP logging on, that made the emulation
+// crawl. Now each thread formats its lines into a ring buffer of its own
+// (single writer, single reader, no lock), and a log thread moves them to the
+// file in batches. A thread's ring buffer is emptied and freed when the thread
+// ends. Nothing is lost on a crash either: a handler for the fatal signals
+// writes the ring buffers straight to the file descriptor, and one at exit
+// empties them into the file. Note that lines of different threads may be
+// batched out of order.
+//
+// Emulation code logs through LOGCAT() under a category (GPU, blitter, OP...)
+// and a level; a line below its category's level costs a single test, and a
+// category compiled out (see VJ_LOG_CATEGORIES) costs nothing.
+//
+// Once the file reaches MAX_LOG_SIZE, it is renamed to <name>.1 (replacing
+// any older one) and a new file is started.
+
+#include "log.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif // _WIN32
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
 
 
 //#define MAX_LOG_SIZE		10000000				// Maximum size of log file (10 MB)
 #define MAX_LOG_SIZE		100000000				// Maximum size of log file (100 MB)
+#define LOG_RING_SIZE		0x40000					// 256 KB of pending text per thread
+#define LOG_LINE_MAX		4096					// Longest line, longer ones are cut
+#define LOG_FLUSH_MSEC		100						// Pending text is written at least this often
+
+// A thread's pending text
+struct LogRing
+{
+	char data[LOG_RING_SIZE];
+	std::atomic<uint32_t> head;						// Moved by the thread writing the lines
+	std::atomic<uint32_t> tail;						// Moved by whoever writes to the file
+	LogRing * next;
+};
+
+// Owns the calling thread's ring buffer, so it goes away with the thread
+struct LogRingOwner
+{
+	LogRing * ring = NULL;
+	~LogRingOwner();
+};
 
 static FILE * log_stream = NULL;
 static uint32_t logSize = 0;
+static std::string logPath;
+static std::atomic<bool> logActive(false);
+static volatile int logFd = -1;						// For the signal handler, which can't use stdio
+static std::atomic<LogRing *> logRings(NULL);		// Changed with logDrainMutex held
+static thread_local LogRingOwner logRingOwner;
+static std::thread logThread;
+static std::mutex logWakeMutex;
+static std::condition_variable logWake;
+static bool logStop;
+static std::mutex logDrainMutex;
+static bool logHandlersInstalled = false;
+static const char * logCategoryName[LOG_CAT_MAX] = { "m68k", "gpu", "dsp", "blitter", "op", "tom", "jerry", "cdrom", "eeprom", "dac", "memory" };
+static const char * logLevelName[] = { "off", "error", "warning", "info", "debug", "trace" };
+
+// Level of each category, warnings and errors by default
+uint8_t logLevel[LOG_CAT_MAX] = { LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING, LOG_LEVEL_WARNING };
+
+// Private function prototypes
+
+static LogRing * LogThreadRing(void);
+static void LogDrain(void);
+static void LogDrainRing(LogRing * ring);
+static void LogRotate(void);
+static void LogThread(void);
+static void LogAtExit(void);
+static void LogSignal(int sig);
+
 
 int LogInit(const char * path)
 {
+	LogDone();
 	log_stream = fopen(path, "w");
 
 	if (log_stream == NULL)
 		return 0;
 
+	logFd = fileno(log_stream);
+	logPath = path;
+	logSize = 0;
+	logStop = false;
+	logActive = true;
+	logThread = std::thread(LogThread);
+
+	if (!logHandlersInstalled)
+	{
+		atexit(LogAtExit);
+		signal(SIGSEGV, LogSignal);
+		signal(SIGABRT, LogSignal);
+		signal(SIGFPE, LogSignal);
+		signal(SIGILL, LogSignal);
+		logHandlersInstalled = true;
+	}
+
 	return 1;
 }
 
@@ -47,35 +141,263 @@ FILE * LogGet(void)
 
 void LogDone(void)
 {
+	if (!logActive)
+		return;
+
+	logActive = false;
+
+	{
+		std::lock_guard<std::mutex> lock(logWakeMutex);
+		logStop = true;
+	}
+
+	logWake.notify_one();
+
+	if (logThread.joinable())
+		logThread.join();
+
+	LogDrain();
+	logFd = -1;
+
 	if (log_stream != NULL)
 		fclose(log_stream);
+
+	log_stream = NULL;
 }
 
 //
-// This logger is used mainly to ensure that text gets written to the log file
-// even if the program crashes. The performance hit is acceptable in this case!
+// Format the text into the calling thread's ring buffer; the log thread does
+// the actual writing
 //
 void WriteLog(const char * text, ...)
 {
+	if (!logActive)
+		return;
+
+	char line[LOG_LINE_MAX];
 	va_list arg;
 	va_start(arg, text);
+	int length = vsnprintf(line, LOG_LINE_MAX, text, arg);
+	va_end(arg);
 
-	if (log_stream == NULL)
+	if (length <= 0)
+		return;
+
+	if (length >= LOG_LINE_MAX)
+		length = LOG_LINE_MAX - 1;
+
+	LogRing * ring = LogThreadRing();
+	uint32_t head = ring->head.load(std::memory_order_relaxed);
+
+	// Full: hand over to the log thread until there is room
+	while ((LOG_RING_SIZE - (head - ring->tail.load(std::memory_order_acquire))) < (uint32_t)length)
+	{
+		if (!logActive)
+			return;
+
+		logWake.notify_one();
+		std::this_thread::yield();
+	}
+
+	uint32_t offset = head % LOG_RING_SIZE;
+	uint32_t first = (LOG_RING_SIZE - offset < (uint32_t)length ? LOG_RING_SIZE - offset : length);
+	memcpy(ring->data + offset, line, first);
+	memcpy(ring->data, line + first, length - first);
+	ring->head.store(head + length, std::memory_order_release);
+
+	if ((head + length - ring->tail.load(std::memory_order_relaxed)) > (LOG_RING_SIZE / 2))
+		logWake.notify_one();
+}
+
+//
+// Set the level of a category from a "<category>[=<level>]" string, the
+// category being "all" for every one of them and the level "debug" by default
+//
+bool LogSetLevel(const char * spec)
+{
+	const char * equal = strchr(spec, '=');
+	size_t length = (equal ? (size_t)(equal - spec) : strlen(spec));
+	int level = LOG_LEVEL_DEBUG;
+
+	if (equal)
+	{
+		for(level=LOG_LEVEL_OFF; level<=LOG_LEVEL_TRACE; level++)
+		{
+			if (strcmp(equal + 1, logLevelName[level]) == 0)
+				break;
+		}
+
+		if (level > LOG_LEVEL_TRACE)
+			return false;
+	}
+
+	if ((length == 3) && (strncmp(spec, "all", 3) == 0))
+	{
+		memset(logLevel, level, sizeof(logLevel));
+		return true;
+	}
+
+	for(int i=0; i<LOG_CAT_MAX; i++)
+	{
+		if ((strlen(logCategoryName[i]) == length) && (strncmp(spec, logCategoryName[i], length) == 0))
+		{
+			logLevel[i] = level;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//
+// The calling thread's ring buffer, created on its first line
+//
+static LogRing * LogThreadRing(void)
+{
+	if (logRingOwner.ring)
+		return logRingOwner.ring;
+
+	LogRing * ring = new LogRing;
+	ring->head = ring->tail = 0;
+
+	std::lock_guard<std::mutex> lock(logDrainMutex);
+	ring->next = logRings.load();
+	logRings.store(ring);
+	return (logRingOwner.ring = ring);
+}
+
+//
+// The thread ends: its pending text goes to the file, and its ring buffer away
+//
+LogRingOwner::~LogRingOwner()
+{
+	if (ring == NULL)
+		return;
+
+	std::lock_guard<std::mutex> lock(logDrainMutex);
+	LogDrainRing(ring);
+
+	if (log_stream != NULL)
+		fflush(log_stream);
+
+	LogRing * previous = logRings.load();
+
+	if (previous == ring)
+		logRings.store(ring->next);
+	else
 	{
-		va_end(arg);
+		while (previous->next != ring)
+			previous = previous->next;
+
+		previous->next = ring->next;
+	}
+
+	delete ring;
+	ring = NULL;
+}
+
+//
+// Move the pending text of every thread to the file
+//
+static void LogDrain(void)
+{
+	std::lock_guard<std::mutex> lock(logDrainMutex);
+
+	for(LogRing * ring=logRings.load(); ring; ring=ring->next)
+		LogDrainRing(ring);
+
+	if (log_stream != NULL)
+		fflush(log_stream);
+}
+
+//
+// Move the pending text of a thread to the file; logDrainMutex has to be held
+//
+static void LogDrainRing(LogRing * ring)
+{
+	if (log_stream == NULL)
 		return;
+
+	uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+	uint32_t head = ring->head.load(std::memory_order_acquire);
+
+	while (tail != head)
+	{
+		uint32_t offset = tail % LOG_RING_SIZE;
+		uint32_t length = (LOG_RING_SIZE - offset < (head - tail) ? LOG_RING_SIZE - offset : head - tail);
+		fwrite(ring->data + offset, 1, length, log_stream);
+		logSize += length;
+		tail += length;
 	}
 
-	logSize += vfprintf(log_stream, text, arg);
+	ring->tail.store(tail, std::memory_order_release);
 
 	if (logSize > MAX_LOG_SIZE)
+		LogRotate();
+}
+
+//
+// Keep the full file as <name>.1, and go on with a new one
+//
+static void LogRotate(void)
+{
+	std::string oldPath = logPath + ".1";
+
+	fclose(log_stream);
+	remove(oldPath.c_str());
+	rename(logPath.c_str(), oldPath.c_str());
+	log_stream = fopen(logPath.c_str(), "w");
+	logFd = (log_stream != NULL ? fileno(log_stream) : -1);
+	logSize = 0;
+}
+
+static void LogThread(void)
+{
+	std::unique_lock<std::mutex> lock(logWakeMutex);
+
+	while (!logStop)
 	{
-		// Instead of dumping out, we just close the file and ignore any more output.
-		fflush(log_stream);
-		fclose(log_stream);
-		log_stream = NULL;
+		logWake.wait_for(lock, std::chrono::milliseconds(LOG_FLUSH_MSEC));
+		lock.unlock();
+		LogDrain();
+		lock.lock();
 	}
+}
 
-	va_end(arg);
-	fflush(log_stream);					// Make sure that text is written!
+static void LogAtExit(void)
+{
+	LogDone();
+}
+
+//
+// Fatal signal: get the pending text out, then let the signal do its job.
+// Only write() can be used here, so the rings go to the file descriptor as they
+// are, without the lock; a drain running at the same time may repeat a few lines.
+//
+static void LogSignal(int sig)
+{
+	int fd = logFd;
+
+	for(LogRing * ring=logRings.load(); ring && (fd >= 0); ring=ring->next)
+	{
+		uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+		uint32_t head = ring->head.load(std::memory_order_acquire);
+
+		while (tail != head)
+		{
+			uint32_t offset = tail % LOG_RING_SIZE;
+			uint32_t length = (LOG_RING_SIZE - offset < (head - tail) ? LOG_RING_SIZE - offset : head - tail);
+#if defined(_WIN32)
+			if (_write(fd, ring->data + offset, length) <= 0)
+#else
+			if (write(fd, ring->data + offset, length) <= 0)
+#endif // _WIN32
+				break;
+
+			tail += length;
+		}
+	}
+
+	signal(sig, SIG_DFL);
+	raise(sig);
 }
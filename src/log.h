@@ -6,6 +6,7 @@
 #define __LOG_H__
 
 #include <stdio.h>
+#include <stdint.h>
 
 #if 0
 #ifdef __cplusplus
@@ -17,6 +18,7 @@ extern int LogInit(const char *);
 extern FILE * LogGet(void);
 extern void LogDone(void);
 extern void WriteLog(const char * text, ...);
+extern bool LogSetLevel(const char * spec);
 
 #if 0
 #ifdef __cplusplus
@@ -24,8 +26,21 @@ extern void WriteLog(const char * text, ...);
 #endif
 #endif
 
-// Some useful defines... :-) but not used
-//#define GPU_DEBUG
-//#define LOG_BLITS
+// Log categories, each one has its own level, set at runtime with the
+// --log-<category>[=<level>] switches. The categories left out of the
+// VJ_LOG_CATEGORIES mask at build time (e.g. -DVJ_LOG_CATEGORIES=0 for none)
+// have their logging compiled out.
+enum { LOG_CAT_M68K, LOG_CAT_GPU, LOG_CAT_DSP, LOG_CAT_BLITTER, LOG_CAT_OP, LOG_CAT_TOM, LOG_CAT_JERRY, LOG_CAT_CDROM, LOG_CAT_EEPROM, LOG_CAT_DAC, LOG_CAT_MEMORY, LOG_CAT_MAX };
+enum { LOG_LEVEL_OFF, LOG_LEVEL_ERROR, LOG_LEVEL_WARNING, LOG_LEVEL_INFO, LOG_LEVEL_DEBUG, LOG_LEVEL_TRACE };
+
+#ifndef VJ_LOG_CATEGORIES
+#define VJ_LOG_CATEGORIES	0xFFFFFFFF
+#endif
+
+extern uint8_t logLevel[LOG_CAT_MAX];
+
+// Disabled, it costs a single test; compiled out, nothing at all
+#define LOG_ENABLED(cat, level)	((VJ_LOG_CATEGORIES & (1 << (cat))) && (logLevel[cat] >= (level)))
+#define LOGCAT(cat, level, ...)	do { if (LOG_ENABLED(cat, level)) WriteLog(__VA_ARGS__); } while (0)
 
 #endif	// __LOG_H__
@@ -27,14 +27,26 @@ void HandleMovem(char * output, uint16_t data, int direction);
 // Local "global" variables
 static long int m68kpc_offset;
 
+// Instruction words read instead of the memory, see m68k_disassemble_code()
+static const uint16_t * codeWords = NULL;
+static uint32_t codeAddress, codeSize;
+
+static uint16_t DasmReadWord(uint32_t address)
+{
+	if (codeWords && ((address - codeAddress) < codeSize))
+		return codeWords[(address - codeAddress) >> 1];
+
+	return m68k_read_memory_16(address);
+}
+
 #if 0
 #define get_ibyte_1(o) get_byte(regs.pc + (regs.pc_p - regs.pc_oldp) + (o) + 1)
 #define get_iword_1(o) get_word(regs.pc + (regs.pc_p - regs.pc_oldp) + (o))
 #define get_ilong_1(o) get_long(regs.pc + (regs.pc_p - regs.pc_oldp) + (o))
 #else
-#define get_ibyte_1(o) m68k_read_memory_8(regs.pc + (o) + 1)
-#define get_iword_1(o) m68k_read_memory_16(regs.pc + (o))
-#define get_ilong_1(o) m68k_read_memory_32(regs.pc + (o))
+#define get_ibyte_1(o) (DasmReadWord(regs.pc + (o)) & 0xFF)
+#define get_iword_1(o) DasmReadWord(regs.pc + (o))
+#define get_ilong_1(o) ((DasmReadWord(regs.pc + (o)) << 16) | DasmReadWord(regs.pc + (o) + 2))
 #endif
 
 
@@ -395,7 +407,8 @@ unsigned int M68KDisassemble(char * output, uint32_t addr, unsigned int OpCodes)
 
 	strcat(str, f);
 
-	if (ccpt)
+	// The condition is only known for the instruction about to be run
+	if (ccpt && !codeWords)
 	{
 		sprintf(f, " (%s)", (cctrue(dp->cc) ? "true" : "false"));
 		strcat(str, f);
@@ -429,3 +442,19 @@ unsigned int m68k_disassemble(char * str_buff, unsigned int pc, unsigned int cpu
 	return M68KDisassemble(str_buff, pc, OpCodes);
 }
 
+
+//
+// Disassemble the instruction held by 'words' words of code, as if at pc.
+// Words beyond the code are still read from the memory.
+//
+unsigned int m68k_disassemble_code(char * str_buff, unsigned int pc, const uint16_t * code, unsigned int words, unsigned int OpCodes)
+{
+	codeWords = code;
+	codeAddress = pc;
+	codeSize = words * 2;
+	unsigned int size = M68KDisassemble(str_buff, pc, OpCodes);
+	codeWords = NULL;
+
+	return size;
+}
+
@@ -58,6 +58,7 @@ void m68k_set_irq2(unsigned int intLevel);
 
 // Local "Global" vars
 static int32_t initialCycles;
+static uint64_t totalCycles;				// Cycles run since the reset
 cpuop_func * cpuFunctionTable[65536];
 
 // By virtue of the fact that m68k_set_irq() can be called asychronously by
@@ -218,6 +219,7 @@ void m68k_pulse_reset(void)
 	regs.spcflags = 0;
 	regs.stopped = 0;
 	regs.remainingCycles = 0;
+	totalCycles = 0;
 	
 	regs.intmask = 0x07;
 	regs.s = 1;								// Supervisor mode ON
@@ -236,6 +238,7 @@ int m68k_execute(int num_cycles)
 	{
 		regs.remainingCycles = 0;	// int32_t
 		regs.interruptCycles = 0;	// uint32_t
+		totalCycles += num_cycles;
 
 		return num_cycles;
 	}
@@ -371,6 +374,7 @@ if (inRoutine)
 			cycles = (int32_t)(*cpuFunctionTable[opcode])(opcode);
 		}
 		regs.remainingCycles -= cycles;
+		totalCycles += cycles;
 //		pthread_mutex_unlock(&executionLock);
 
 //printf("Executed opcode $%04X (%i cycles)...\n", opcode, cycles);
@@ -691,6 +695,12 @@ int m68k_cycles_remaining(void) {}        /* Number of cycles left */
 //void m68k_end_timeslice(void) {}          /* End timeslice now */
 
 
+uint64_t m68k_cycles_total(void)
+{
+	return totalCycles;
+}
+
+
 void m68k_modify_timeslice(int cycles)
 {
 	regs.remainingCycles = cycles;
@@ -11,6 +11,8 @@
 #ifndef __M68KINTERFACE_H__
 #define __M68KINTERFACE_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -124,6 +126,7 @@ unsigned int m68k_is_valid_instruction(unsigned int instruction, unsigned int cp
  * disassembly in str_buff and returns the size of the instruction in bytes.
  */
 unsigned int m68k_disassemble(char * str_buff, unsigned int pc, unsigned int cpu_type, unsigned int OpCodes);
+unsigned int m68k_disassemble_code(char * str_buff, unsigned int pc, const uint16_t * code, unsigned int words, unsigned int OpCodes);
 
 /* These functions let you read/write/modify the number of cycles left to run
  * while m68k_execute() is running.
@@ -132,6 +135,7 @@ unsigned int m68k_disassemble(char * str_buff, unsigned int pc, unsigned int cpu
  */
 int m68k_cycles_run(void);              // Number of cycles run so far
 int m68k_cycles_remaining(void);        // Number of cycles left
+uint64_t m68k_cycles_total(void);       // Number of instruction cycles run since the reset
 void m68k_modify_timeslice(int cycles); // Modify cycles left
 void m68k_end_timeslice(void);          // End timeslice now
 
@@ -467,8 +467,6 @@ void OPProcessList(int halfline, bool render)
 //       pixels wide...
 	halfline &= 0x7FF;
 
-extern int op_start_log;
-
 	op_pointer = OPGetListPointer();
 
 //	objectp_stop_reading_list = false;
@@ -503,7 +501,7 @@ else
 //WriteLog("\t%08X type %i\n", op_pointer, (uint8_t)p0 & 0x07);
 
 #if 1
-if (halfline == TOMGetVDB() && op_start_log)
+if (halfline == TOMGetVDB() && LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG))
 //if (halfline == 215 && op_start_log)
 //if (halfline == 28 && op_start_log)
 //if (halfline == 0)
@@ -601,7 +599,7 @@ WriteLog("    --> List end\n\n");
 			uint32_t height = (p0 & 0xFFC000) >> 14;
 			uint32_t oldOPP = op_pointer - 8;
 // *** BEGIN OP PROCESSOR TESTING ONLY ***
-if (inhibit && op_start_log)
+if (inhibit && LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG))
 	WriteLog("!!! ^^^ This object is INHIBITED! ^^^ !!!\n");
 bitmapCounter++;
 if (!inhibit)	// For OP testing only!
@@ -651,7 +649,7 @@ if (!inhibit)	// For OP testing only!
 			uint32_t oldOPP = op_pointer - 8;
 //WriteLog("OP: Scaled Object (ypos=%04X, height=%04X", ypos, height);
 // *** BEGIN OP PROCESSOR TESTING ONLY ***
-if (inhibit && op_start_log)
+if (inhibit && LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG))
 {
 	WriteLog("!!! ^^^ This object is INHIBITED! ^^^ !!! (halfline=%u, ypos=%u, height=%u)\n", halfline, ypos, height);
 	DumpScaledObject(p0, OPLoadPhrase(op_pointer), OPLoadPhrase(op_pointer+8));
@@ -1503,8 +1501,7 @@ uint32_t scaledPhrasePixelsUS = phraseWidthToPixels[depth] * hscale;
 
 	if (startPos < 0)			// Case #1: Begin out, end in, L to R
 {
-extern int start_logging;
-if (start_logging)
+if (LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG))
 	WriteLog("OP: Scaled bitmap (%02X, %u BPP, spp=%u) start pos (%i) < 0...", hscale, op_bitmap_bit_depth[depth], scaledPhrasePixels, startPos);
 //		clippedWidth = 0 - startPos,
 		clippedWidth = (0 - startPos) << 5,
@@ -1512,7 +1509,7 @@ if (start_logging)
 		dataClippedWidth = phraseClippedWidth = (clippedWidth / scaledPhrasePixelsUS) >> 5,
 //		startPos = 0 - (clippedWidth % scaledPhrasePixels);
 		startPos += (dataClippedWidth * scaledPhrasePixelsUS) >> 5;
-if (start_logging)
+if (LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG))
 	WriteLog(" [new sp=%i, cw=%i, dcw=pcw=%i]\n", startPos, clippedWidth, dataClippedWidth);
 }
 
@@ -1529,10 +1526,9 @@ if (start_logging)
 		dataClippedWidth = phraseClippedWidth = clippedWidth / scaledPhrasePixels,
 		startPos = lbufWidth + (clippedWidth % scaledPhrasePixels);
 
-extern int op_start_log;
-if (op_start_log && clippedWidth != 0)
+if (LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG) && clippedWidth != 0)
 	WriteLog("OP: Clipped line. SP=%i, EP=%i, clip=%u, iwidth=%u, hscale=%02X\n", startPos, endPos, clippedWidth, iwidth, hscale);
-if (op_start_log && startPos == 13)
+if (LOG_ENABLED(LOG_CAT_OP, LOG_LEVEL_DEBUG) && startPos == 13)
 {
 	WriteLog("OP: Scaled line. SP=%i, EP=%i, clip=%u, iwidth=%u, hscale=%02X, depth=%u, firstPix=%u\n", startPos, endPos, clippedWidth, iwidth, hscale, depth, firstPix);
 	DumpScaledObject(p0, p1, p2);
@@ -0,0 +1,76 @@
+//
+// Per-unit host time accounting
+//
+
+// Time is charged to whichever unit is current; switching units closes the
+// running slice, so the totals are exclusive and add up to the wall time spent
+// between PerfCountReset() and the last switch. When disabled, a switch is just
+// a flag test so the instrumentation can stay in the hot paths, and the totals
+// are kept until the next enable.
+
+#include "perfcount.h"
+
+#include <chrono>
+
+
+// Global variables
+
+bool perfCountEnabled = false;
+const char * perfUnitName[PERF_MAX] = { "other", "m68k", "gpu", "dsp", "blitter", "op" };
+
+// Local variables
+
+static std::chrono::steady_clock::time_point sliceStart;
+static double unitSeconds[PERF_MAX];
+static int currentUnit = PERF_OTHER;
+
+
+void PerfCountEnable(bool state)
+{
+	// Close the running slice, so the totals can still be read once disabled
+	if (!state)
+		PerfCountSwitch(PERF_OTHER);
+	else
+		PerfCountReset();
+
+	perfCountEnabled = state;
+}
+
+
+void PerfCountReset(void)
+{
+	for(int i=0; i<PERF_MAX; i++)
+		unitSeconds[i] = 0;
+
+	currentUnit = PERF_OTHER;
+	sliceStart = std::chrono::steady_clock::now();
+}
+
+
+//
+// Charge the elapsed slice to the current unit and make 'unit' current.
+// Returns the previously current unit, so nested callers can switch back.
+//
+int PerfCountSwitch(int unit)
+{
+	int previous = currentUnit;
+
+	if (perfCountEnabled && (unit != currentUnit))
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		unitSeconds[currentUnit] += std::chrono::duration<double>(now - sliceStart).count();
+		sliceStart = now;
+		currentUnit = unit;
+	}
+
+	return previous;
+}
+
+
+double PerfCountGetSeconds(int unit)
+{
+	if ((unit < 0) || (unit >= PERF_MAX))
+		return 0;
+
+	return unitSeconds[unit];
+}
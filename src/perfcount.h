@@ -0,0 +1,20 @@
+//
+// PERFCOUNT.H: Per-unit host time accounting
+//
+
+#ifndef __PERFCOUNT_H__
+#define __PERFCOUNT_H__
+
+#include <stdint.h>
+
+enum { PERF_OTHER = 0, PERF_M68K, PERF_GPU, PERF_DSP, PERF_BLITTER, PERF_OP, PERF_MAX };
+
+void PerfCountEnable(bool state);
+void PerfCountReset(void);
+int PerfCountSwitch(int unit);
+double PerfCountGetSeconds(int unit);
+
+extern bool perfCountEnabled;
+extern const char * perfUnitName[PERF_MAX];
+
+#endif	// __PERFCOUNT_H__
@@ -32,6 +32,11 @@
 
 #define MaxMemory1BrowserWindow		4
 
+// Frame skip (vjs.frameSkip): 0 to FRAMESKIP_MAX frames skipped between two
+// drawn ones, or FRAMESKIP_AUTO to skip only when the host is late
+#define FRAMESKIP_MAX				4
+#define FRAMESKIP_AUTO				0xFF
+
 
 // List the erase settings possibilities
 enum
@@ -108,6 +113,7 @@ struct VJSettings
 	char debuggerROMPath[MAX_PATH];
 	char absROMPath[MAX_PATH];
 	char screenshotPath[MAX_PATH];
+	char zipCachePath[MAX_PATH];								// Files uncompressed from ZIPs, none if empty
 	char sourcefilesearchPaths[4096];
 };
 
@@ -265,6 +265,7 @@
 #include "m68000/m68kinterface.h"
 //#include "memory.h"
 #include "op.h"
+#include "perfcount.h"
 #include "settings.h"
 
 #define NEW_TIMER_SYSTEM
@@ -344,10 +345,6 @@
 #define TOP_VISIBLE_VC_PAL		67
 #define BOTTOM_VISIBLE_VC_PAL	579
 
-//This can be defined in the makefile as well...
-//(It's easier to do it here, though...)
-//#define TOM_DEBUG
-
 uint8_t tomRam8[0x4000];
 uint32_t tomWidth, tomHeight;
 uint32_t tomTimerPrescaler;
@@ -360,6 +357,7 @@ uint16_t tom_jerry_int_pending, tom_timer_int_pending, tom_object_int_pending,
 // OS/system dependent.
 uint32_t * screenBuffer;
 uint32_t screenPitch;
+uint32_t * screenLineHash = NULL;		// One hash per screen buffer line, if set
 
 static const char * videoMode_to_str[8] =
 	{ "16 BPP CRY", "24 BPP RGB", "16 BPP DIRECT", "16 BPP RGB",
@@ -873,6 +871,20 @@ void tom_render_16bpp_rgb_scanline(uint32_t * backbuffer)
 }
 
 
+//
+// FNV-1a on the line pixels; changing any one pixel always changes the hash
+//
+uint32_t TOMLineHash(uint32_t * line, uint32_t width)
+{
+	uint32_t hash = 0x811C9DC5;
+
+	for(uint32_t i=0; i<width; i++)
+		hash = (hash ^ line[i]) * 0x01000193;
+
+	return hash;
+}
+
+
 //
 // Process a single halfline
 //
@@ -886,6 +898,8 @@ void TOMExecHalfline(uint16_t halfline, bool render)
 	if (halfline & 0x01)
 		return;
 
+	int perfUnit = PerfCountSwitch(PERF_OP);
+
 //Hm, it seems that the OP needs to execute from zero, so let's try it:
 // And it works! But need to do some optimizations in the OP to keep it from
 // attempting to do a scanline render in the non-display area... [DONE]
@@ -962,13 +976,22 @@ TOM: Vertical Interrupt written by M68K: 491
 			if (GET16(tomRam8, VMODE) & BGEN) // && (CRY or RGB16)...
 				for(uint32_t i=0; i<720; i++)
 					*current_line_buffer++ = bgHI, *current_line_buffer++ = bgLO;
-
-			OPProcessList(halfline, render);
 		}
+
+		// On a skipped frame, the OP still walks the list for its side effects
+		// (interrupts, GPU objects, write-backs) but doesn't expand the bitmaps
+		OPProcessList(halfline, render);
 	}
 	else
 		inActiveDisplayArea = false;
 
+	// Nothing to draw for a skipped frame
+	if (!render)
+	{
+		PerfCountSwitch(perfUnit);
+		return;
+	}
+
 	// Take PAL into account...
 
 	uint16_t topVisible = (vjs.hardwareTypeNTSC ? TOP_VISIBLE_VC : TOP_VISIBLE_VC_PAL),
@@ -1070,7 +1093,18 @@ void tom_render_24bpp_scanline(uint32_t * backbuffer)
 			for(uint32_t i=0; i<tomWidth; i++)
 				*currentLineBuffer++ = pixel;
 		}
+
+		// Let the display find the lines that changed, while the line is hot
+		if (screenLineHash)
+		{
+			uint32_t line = (TOMCurrentLine - screenBuffer) / screenPitch;
+
+			if (line < VIRTUAL_SCREEN_LINES)
+				screenLineHash[line] = TOMLineHash(TOMCurrentLine, tomWidth);
+		}
 	}
+
+	PerfCountSwitch(perfUnit);
 }
 
 
@@ -1091,7 +1125,7 @@ void TOMDone(void)
 	TOMDumpIORegistersToLog();
 	OPDone();
 	BlitterDone();
-	WriteLog("TOM: Resolution %i x %i %s\n", TOMGetVideoModeWidth(),
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_INFO, "TOM: Resolution %i x %i %s\n", TOMGetVideoModeWidth(),
 		TOMGetVideoModeHeight(), videoMode_to_str[TOMGetVideoMode()]);
 }
 
@@ -1238,6 +1272,9 @@ void TOMReset(void)
 //
 void TOMDumpIORegistersToLog(void)
 {
+	if (!LOG_ENABLED(LOG_CAT_TOM, LOG_LEVEL_DEBUG))
+		return;
+
 	WriteLog("\n\n---------------------------------------------------------------------\n");
 	WriteLog("TOM I/O Registers\n");
 	WriteLog("---------------------------------------------------------------------\n");
@@ -1288,9 +1325,7 @@ uint8_t TOMReadByte(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 // Also, the 68K CANNOT make use of the 32-bit interface, since its bus width is only 16-bits...
 //	offset &= 0xFF3FFF;
 
-#ifdef TOM_DEBUG
-	WriteLog("TOM: Reading byte at %06X for %s\n", offset, whoName[who]);
-#endif
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_TRACE, "TOM: Reading byte at %06X for %s\n", offset, whoName[who]);
 
 	if ((offset >= GPU_CONTROL_RAM_BASE) && (offset < GPU_CONTROL_RAM_BASE+0x20))
 		return GPUReadByte(offset, who);
@@ -1320,11 +1355,9 @@ uint16_t TOMReadWord(uint32_t offset, uint32_t who/*=UNKNOWN*/)
 {
 //???Is this needed???
 //	offset &= 0xFF3FFF;
-#ifdef TOM_DEBUG
-	WriteLog("TOM: Reading word at %06X for %s\n", offset, whoName[who]);
-#endif
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_TRACE, "TOM: Reading word at %06X for %s\n", offset, whoName[who]);
 if (offset >= 0xF02000 && offset <= 0xF020FF)
-	WriteLog("TOM: ReadWord attempted from GPU register file by %s (unimplemented)!\n", whoName[who]);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_WARNING, "TOM: ReadWord attempted from GPU register file by %s (unimplemented)!\n", whoName[who]);
 
 	if (offset == 0xF000E0)
 	{
@@ -1380,9 +1413,7 @@ void TOMWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 	// Moved here tentatively, so we can see everything written to TOM.
 	tomRam8[offset & 0x3FFF] = data;
 
-#ifdef TOM_DEBUG
-	WriteLog("TOM: Writing byte %02X at %06X", data, offset);
-#endif
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_TRACE, "TOM: Writing byte %02X at %06X", data, offset);
 //???Is this needed???
 // Perhaps on the writes--32-bit writes that is! And masked with FF7FFF...
 #ifndef TOM_STRICT_MEMORY_ACCESS
@@ -1393,9 +1424,7 @@ void TOMWriteByte(uint32_t offset, uint8_t data, uint32_t who/*=UNKNOWN*/)
 	if ((offset >= 0xF08000) && (offset <= 0xF0BFFF))
 		offset &= 0xFF7FFF;
 #endif
-#ifdef TOM_DEBUG
-	WriteLog(" -->[%06X] by %s\n", offset, whoName[who]);
-#endif
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_TRACE, " -->[%06X] by %s\n", offset, whoName[who]);
 
 #ifdef TOM_STRICT_MEMORY_ACCESS
 	// Sanity check ("Aww, there ain't no Sanity Clause...")
@@ -1467,9 +1496,7 @@ void TOMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 	tomRam8[(offset + 0) & 0x3FFF] = data >> 8;
 	tomRam8[(offset + 1) & 0x3FFF] = data & 0xFF;
 
-#ifdef TOM_DEBUG
-	WriteLog("TOM: Writing byte %04X at %06X", data, offset);
-#endif
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_TRACE, "TOM: Writing byte %04X at %06X", data, offset);
 //???Is this needed??? Yes, but we need to be more vigilant than this.
 #ifndef TOM_STRICT_MEMORY_ACCESS
 	offset &= 0xFF3FFF;
@@ -1479,9 +1506,7 @@ void TOMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 	if ((offset >= 0xF08000) && (offset <= 0xF0BFFF))
 		offset &= 0xFF7FFF;
 #endif
-#ifdef TOM_DEBUG
-	WriteLog(" -->[%06X] by %s\n", offset, whoName[who]);
-#endif
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_TRACE, " -->[%06X] by %s\n", offset, whoName[who]);
 
 #ifdef TOM_STRICT_MEMORY_ACCESS
 	// Sanity check
@@ -1494,7 +1519,7 @@ void TOMWriteWord(uint32_t offset, uint16_t data, uint32_t who/*=UNKNOWN*/)
 //if (offset == 0xF00000 + MEMCON2)
 //	WriteLog("TOM: Memory Configuration 2 written by %s: %04X\n", whoName[who], data);
 if (offset >= 0xF02000 && offset <= 0xF020FF)
-	WriteLog("TOM: WriteWord attempted to GPU register file by %s (unimplemented)!\n", whoName[who]);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_WARNING, "TOM: WriteWord attempted to GPU register file by %s (unimplemented)!\n", whoName[who]);
 
 	if ((offset >= GPU_CONTROL_RAM_BASE) && (offset < GPU_CONTROL_RAM_BASE+0x20))
 	{
@@ -1584,9 +1609,9 @@ if (offset >= 0xF02000 && offset <= 0xF020FF)
 //	TOMWriteByte(0xF00000 | (offset+1), data & 0xFF, who);
 
 if (offset == MEMCON1)
-	WriteLog("TOM: Memory Config 1 written by %s: $%04X\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Memory Config 1 written by %s: $%04X\n", whoName[who], data);
 if (offset == MEMCON2)
-	WriteLog("TOM: Memory Config 2 written by %s: $%04X\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Memory Config 2 written by %s: $%04X\n", whoName[who], data);
 //if (offset == OLP)
 //	WriteLog("TOM: Object List Pointer written by %s: $%04X\n", whoName[who], data);
 //if (offset == OLP + 2)
@@ -1594,51 +1619,51 @@ if (offset == MEMCON2)
 //if (offset == OBF)
 //	WriteLog("TOM: Object Processor Flag written by %s: %u\n", whoName[who], data);
 if (offset == VMODE)
-	WriteLog("TOM: Video Mode written by %s: %04X. PWIDTH = %u, MODE = %s, flags:%s%s (VC = %u) (M68K PC = %06X)\n", whoName[who], data, ((data >> 9) & 0x07) + 1, videoMode_to_str[(data & MODE) >> 1], (data & BGEN ? " BGEN" : ""), (data & VARMOD ? " VARMOD" : ""), GET16(tomRam8, VC), m68k_get_reg(NULL, M68K_REG_PC));
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Video Mode written by %s: %04X. PWIDTH = %u, MODE = %s, flags:%s%s (VC = %u) (M68K PC = %06X)\n", whoName[who], data, ((data >> 9) & 0x07) + 1, videoMode_to_str[(data & MODE) >> 1], (data & BGEN ? " BGEN" : ""), (data & VARMOD ? " VARMOD" : ""), GET16(tomRam8, VC), m68k_get_reg(NULL, M68K_REG_PC));
 if (offset == BORD1)
-	WriteLog("TOM: Border 1 written by %s: $%04X\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Border 1 written by %s: $%04X\n", whoName[who], data);
 if (offset == BORD2)
-	WriteLog("TOM: Border 2 written by %s: $%04X\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Border 2 written by %s: $%04X\n", whoName[who], data);
 if (offset == HP)
-	WriteLog("TOM: Horizontal Period written by %s: %u (+1*2 = %u)\n", whoName[who], data, (data + 1) * 2);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Period written by %s: %u (+1*2 = %u)\n", whoName[who], data, (data + 1) * 2);
 if (offset == HBB)
-	WriteLog("TOM: Horizontal Blank Begin written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Blank Begin written by %s: %u\n", whoName[who], data);
 if (offset == HBE)
-	WriteLog("TOM: Horizontal Blank End written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Blank End written by %s: %u\n", whoName[who], data);
 if (offset == HS)
-	WriteLog("TOM: Horizontal Sync written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Sync written by %s: %u\n", whoName[who], data);
 if (offset == HVS)
-	WriteLog("TOM: Horizontal Vertical Sync written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Vertical Sync written by %s: %u\n", whoName[who], data);
 if (offset == HDB1)
-	WriteLog("TOM: Horizontal Display Begin 1 written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Display Begin 1 written by %s: %u\n", whoName[who], data);
 if (offset == HDB2)
-	WriteLog("TOM: Horizontal Display Begin 2 written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Display Begin 2 written by %s: %u\n", whoName[who], data);
 if (offset == HDE)
-	WriteLog("TOM: Horizontal Display End written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Display End written by %s: %u\n", whoName[who], data);
 if (offset == VP)
-	WriteLog("TOM: Vertical Period written by %s: %u (%sinterlaced)\n", whoName[who], data, (data & 0x01 ? "non-" : ""));
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Period written by %s: %u (%sinterlaced)\n", whoName[who], data, (data & 0x01 ? "non-" : ""));
 if (offset == VBB)
-	WriteLog("TOM: Vertical Blank Begin written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Blank Begin written by %s: %u\n", whoName[who], data);
 if (offset == VBE)
-	WriteLog("TOM: Vertical Blank End written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Blank End written by %s: %u\n", whoName[who], data);
 if (offset == VS)
-	WriteLog("TOM: Vertical Sync written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Sync written by %s: %u\n", whoName[who], data);
 if (offset == VDB)
-	WriteLog("TOM: Vertical Display Begin written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Display Begin written by %s: %u\n", whoName[who], data);
 if (offset == VDE)
-	WriteLog("TOM: Vertical Display End written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Display End written by %s: %u\n", whoName[who], data);
 if (offset == VEB)
-	WriteLog("TOM: Vertical Equalization Begin written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Equalization Begin written by %s: %u\n", whoName[who], data);
 if (offset == VEE)
-	WriteLog("TOM: Vertical Equalization End written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Equalization End written by %s: %u\n", whoName[who], data);
 if (offset == VI)
-	WriteLog("TOM: Vertical Interrupt written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Vertical Interrupt written by %s: %u\n", whoName[who], data);
 if (offset == PIT0)
-	WriteLog("TOM: PIT0 written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: PIT0 written by %s: %u\n", whoName[who], data);
 if (offset == PIT1)
-	WriteLog("TOM: PIT1 written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: PIT1 written by %s: %u\n", whoName[who], data);
 if (offset == HEQ)
-	WriteLog("TOM: Horizontal Equalization End written by %s: %u\n", whoName[who], data);
+	LOGCAT(LOG_CAT_TOM, LOG_LEVEL_DEBUG, "TOM: Horizontal Equalization End written by %s: %u\n", whoName[who], data);
 //if (offset == BG)
 //	WriteLog("TOM: Background written by %s: %u\n", whoName[who], data);
 //if (offset == INT1)
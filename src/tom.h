@@ -20,6 +20,7 @@
 #define VIRTUAL_SCREEN_WIDTH            326
 #define VIRTUAL_SCREEN_HEIGHT_NTSC      240
 #define VIRTUAL_SCREEN_HEIGHT_PAL       256
+#define VIRTUAL_SCREEN_LINES            512		// Screen buffer lines, interlace included
 
 // 68000 Interrupt bit positions (enabled at $F000E0)
 
@@ -36,6 +37,7 @@ void TOMWriteWord(uint32_t offset, uint16_t data, uint32_t who = UNKNOWN);
 
 void TOMExecHalfline(uint16_t halfline, bool render);
 uint32_t TOMGetVideoModeWidth(void);
+uint32_t TOMLineHash(uint32_t * line, uint32_t width);
 uint32_t TOMGetVideoModeHeight(void);
 uint8_t TOMGetVideoMode(void);
 uint8_t * TOMGetRamPointer(void);
@@ -69,5 +71,6 @@ extern int32_t tomTimerCounter;
 
 extern uint32_t screenPitch;
 extern uint32_t * screenBuffer;
+extern uint32_t * screenLineHash;
 
 #endif	// __TOM_H__
@@ -0,0 +1,229 @@
+//
+// Binary execution trace of the 68K, GPU and DSP
+//
+
+// Tracing through WriteLog() and the disassemblers runs at a few thousand
+// instructions per second; here the cores only fill fixed size records in a
+// ring buffer allocated once, so the last TRACE_RECORDS instructions are
+// always at hand. Each record keeps the instruction words, so the trace can be
+// disassembled later on, even if the code has been overwritten since. With the
+// register deltas on, the registers changed by an instruction are recorded
+// right after it (they are found by comparing against a shadow copy).
+//
+// The ring is written to a file on demand, or when the 68K halts. The file is
+// decoded by the debugger (see TraceDecoder).
+
+#include "trace.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "jaguar.h"
+#include "log.h"
+#include "memory.h"
+#include "m68000/m68kinterface.h"
+
+#define TRACE_RECORDS		0x80000					// 512K records = 16 MB
+#define TRACE_M68K_WORDS	5						// Longest 68000 instruction
+#define TRACE_M68K_REGS		(M68K_REG_SR + 1)		// D0-D7, A0-A7, PC & SR
+#define TRACE_RISC_REGS		32
+
+
+// Global variables
+
+bool traceActive[TRACE_MAX] = { false, false, false };
+const char * traceUnitName[TRACE_MAX] = { "m68k", "gpu", "dsp" };
+
+// Local variables
+
+static TraceRecord * traceBuffer = NULL;
+static uint64_t traceHead = 0;
+static bool traceRegisters = false;
+static uint64_t traceCycles[TRACE_MAX];				// RISC cycles, the 68K keeps its own
+static uint32_t traceShadow[TRACE_MAX][TRACE_RISC_REGS];
+static bool traceShadowValid[TRACE_MAX];
+
+
+//
+// Start tracing the units of the mask (a bit per TRACE_xxx unit)
+//
+void TraceStart(uint32_t unitMask, bool registers)
+{
+	if (traceBuffer == NULL)
+	{
+		traceBuffer = new TraceRecord[TRACE_RECORDS];
+		traceHead = 0;
+	}
+
+	traceRegisters = registers;
+
+	for(int i=0; i<TRACE_MAX; i++)
+	{
+		traceActive[i] = ((unitMask & (1 << i)) != 0);
+		traceShadowValid[i] = false;
+	}
+
+	WriteLog("TRACE: Tracing started (%u records, registers %s)\n", TRACE_RECORDS, (registers ? "on" : "off"));
+}
+
+
+void TraceStop(void)
+{
+	for(int i=0; i<TRACE_MAX; i++)
+		traceActive[i] = false;
+}
+
+
+bool TraceEnabled(void)
+{
+	return traceActive[TRACE_M68K] || traceActive[TRACE_GPU] || traceActive[TRACE_DSP];
+}
+
+
+//
+// Called at the Jaguar reset, so the trace starts with the new run
+//
+void TraceReset(void)
+{
+	traceHead = 0;
+
+	for(int i=0; i<TRACE_MAX; i++)
+	{
+		traceCycles[i] = 0;
+		traceShadowValid[i] = false;
+	}
+}
+
+
+static inline TraceRecord * TraceNextRecord(void)
+{
+	return &traceBuffer[traceHead++ % TRACE_RECORDS];
+}
+
+
+static void TraceRegister(int unit, uint64_t cycle, uint8_t reg, uint32_t value)
+{
+	TraceRecord * record = TraceNextRecord();
+	record->cycle = cycle;
+	record->pc = value;
+	record->unit = unit;
+	record->type = TRACE_REGISTER;
+	record->reg = reg;
+	record->words = 0;
+}
+
+
+//
+// Record the 68K instruction about to be run at pc
+//
+void TraceM68K(uint32_t pc)
+{
+	uint64_t cycle = m68k_cycles_total();
+
+	if (traceRegisters)
+	{
+		for(int i=0; i<TRACE_M68K_REGS; i++)
+		{
+			// The PC is in the instruction record already
+			if (i == M68K_REG_PC)
+				continue;
+
+			uint32_t value = m68k_get_reg(NULL, (m68k_register_t)i);
+
+			if (traceShadowValid[TRACE_M68K] && (value != traceShadow[TRACE_M68K][i]))
+				TraceRegister(TRACE_M68K, cycle, i, value);
+
+			traceShadow[TRACE_M68K][i] = value;
+		}
+
+		traceShadowValid[TRACE_M68K] = true;
+	}
+
+	TraceRecord * record = TraceNextRecord();
+	record->cycle = cycle;
+	record->pc = pc;
+	record->unit = TRACE_M68K;
+	record->type = TRACE_INSTRUCTION;
+	record->reg = 0;
+	record->words = TRACE_M68K_WORDS;
+
+	// Read as the debugger does, without the side effects of a bus master access
+	for(int i=0; i<TRACE_M68K_WORDS; i++)
+		record->code[i] = JaguarReadWord(pc + (i * 2), DEBUG);
+}
+
+
+//
+// Record the GPU or DSP instruction about to be run at pc, taking 'cycles'
+// cycles; reg is the current register bank
+//
+void TraceRISC(int unit, uint32_t pc, uint16_t opcode, uint32_t cycles, uint32_t * reg)
+{
+	uint64_t cycle = traceCycles[unit];
+	traceCycles[unit] += cycles;
+
+	if (traceRegisters)
+	{
+		for(int i=0; i<TRACE_RISC_REGS; i++)
+		{
+			if (traceShadowValid[unit] && (reg[i] != traceShadow[unit][i]))
+				TraceRegister(unit, cycle, i, reg[i]);
+
+			traceShadow[unit][i] = reg[i];
+		}
+
+		traceShadowValid[unit] = true;
+	}
+
+	TraceRecord * record = TraceNextRecord();
+	record->cycle = cycle;
+	record->pc = pc;
+	record->unit = unit;
+	record->type = TRACE_INSTRUCTION;
+	record->reg = 0;
+	record->code[0] = opcode;
+	record->words = 1;
+
+	// MOVEI is followed by its 32-bit value
+	if ((opcode >> 10) == 38)
+	{
+		record->code[1] = JaguarReadWord(pc + 2, DEBUG);
+		record->code[2] = JaguarReadWord(pc + 4, DEBUG);
+		record->words = 3;
+	}
+}
+
+
+//
+// Write the trace to a file, oldest record first
+//
+bool TraceDump(const char * filename)
+{
+	if (traceBuffer == NULL)
+		return false;
+
+	FILE * fp = fopen(filename, "wb");
+
+	if (fp == NULL)
+	{
+		WriteLog("TRACE: Could not open %s for writing!\n", filename);
+		return false;
+	}
+
+	TraceHeader header;
+	memset(&header, 0, sizeof(header));
+	strcpy(header.magic, TRACE_MAGIC);
+	header.version = TRACE_VERSION;
+	header.recordSize = sizeof(TraceRecord);
+	header.records = (traceHead < TRACE_RECORDS ? traceHead : TRACE_RECORDS);
+
+	uint32_t start = (uint32_t)((traceHead - header.records) % TRACE_RECORDS);
+	uint32_t first = (uint32_t)(TRACE_RECORDS - start < header.records ? TRACE_RECORDS - start : header.records);
+
+	bool ok = (fwrite(&header, sizeof(header), 1, fp) == 1)
+		&& (fwrite(traceBuffer + start, sizeof(TraceRecord), first, fp) == first)
+		&& (fwrite(traceBuffer, sizeof(TraceRecord), header.records - first, fp) == (header.records - first));
+	fclose(fp);
+
+	WriteLog("TRACE: %s %u records to %s\n", (ok ? "Wrote" : "Failed to write"), (uint32_t)header.records, filename);
+	return ok;
+}
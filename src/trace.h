@@ -0,0 +1,49 @@
+//
+// TRACE.H: Header file
+//
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <stdint.h>
+
+enum { TRACE_M68K = 0, TRACE_GPU, TRACE_DSP, TRACE_MAX };
+enum { TRACE_INSTRUCTION = 0, TRACE_REGISTER };
+
+#define TRACE_MAGIC			"VJTRACE"
+#define TRACE_VERSION		1
+#define TRACE_CODE_WORDS	8
+
+// One instruction run, or one register changed since the unit's previous instruction
+struct TraceRecord
+{
+	uint64_t cycle;						// Unit's cycles run since the reset
+	uint32_t pc;						// Register value, for a register record
+	uint8_t unit;						// TRACE_M68K, TRACE_GPU or TRACE_DSP
+	uint8_t type;						// TRACE_INSTRUCTION or TRACE_REGISTER
+	uint8_t reg;						// M68K_REG_xxx or RISC register number
+	uint8_t words;						// Instruction words in code
+	uint16_t code[TRACE_CODE_WORDS];
+};
+
+// A trace file is this header, followed by the records, oldest first
+struct TraceHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t recordSize;
+	uint64_t records;
+};
+
+void TraceStart(uint32_t unitMask, bool registers);
+void TraceStop(void);
+bool TraceEnabled(void);
+void TraceReset(void);
+bool TraceDump(const char * filename);
+void TraceM68K(uint32_t pc);
+void TraceRISC(int unit, uint32_t pc, uint16_t opcode, uint32_t cycles, uint32_t * reg);
+
+extern bool traceActive[TRACE_MAX];
+extern const char * traceUnitName[TRACE_MAX];
+
+#endif	// __TRACE_H__
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <zlib.h>
+#include "crc32.h"
 #include "log.h"
 
 
@@ -79,9 +80,11 @@ bool GetZIPHeader(FILE * fp, ZipFileEntry & ze)
 //
 // Uncompress a file from a ZIP file filestream
 // NOTE: The passed in buffer *must* be fully allocated before calling this!
+// If crc isn't NULL, it gets the CRC32 of the uncompressed file, computed on
+// each chunk as it is inflated.
 //
 #define CHUNKSIZE 16384
-int UncompressFileFromZIP(FILE * fp, ZipFileEntry ze, uint8_t * buffer)
+int UncompressFileFromZIP(FILE * fp, ZipFileEntry ze, uint8_t * buffer, uint32_t * crc/*= NULL*/)
 {
 	z_stream zip;
 	unsigned char inBuffer[CHUNKSIZE];
@@ -103,6 +106,9 @@ int UncompressFileFromZIP(FILE * fp, ZipFileEntry ze, uint8_t * buffer)
 	zip.avail_out = ze.uncompressedSize;
 	zip.next_out = buffer;
 
+	if (crc)
+		*crc = 0;
+
 	// Decompress until deflate stream ends or we hit end of file
 	do
 	{
@@ -119,8 +125,12 @@ int UncompressFileFromZIP(FILE * fp, ZipFileEntry ze, uint8_t * buffer)
 		if (zip.avail_in == 0)
 			break;
 
+		uint8_t * chunk = zip.next_out;
 		ret = inflate(&zip, Z_NO_FLUSH);
 
+		if (crc)
+			*crc = crc32_update(*crc, chunk, (unsigned int)(zip.next_out - chunk));
+
 		if ((ret == Z_NEED_DICT) || (ret == Z_DATA_ERROR) || (ret == Z_MEM_ERROR))
 		{
 			inflateEnd(&zip);
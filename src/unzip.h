@@ -21,6 +21,6 @@ struct ZipFileEntry
 };
 
 extern bool GetZIPHeader(FILE *, ZipFileEntry &);
-extern int UncompressFileFromZIP(FILE *, ZipFileEntry, uint8_t *);
+extern int UncompressFileFromZIP(FILE *, ZipFileEntry, uint8_t *, uint32_t * crc = NULL);
 
 #endif	// __UNZIP_H__
@@ -0,0 +1,150 @@
+//
+// Capture of the JERRY I2S output to a WAV file
+//
+
+// The samples are the ones the DAC gets at each I2S word clock, at the
+// emulated rate, whether or not there is a host audio device and however fast
+// the emulation runs. They are gathered in a buffer and written in batches;
+// the header sizes are filled in when the capture is stopped. The WAV rate is
+// the I2S rate of the first sample (rounded to the Hz); should the software
+// change its rate later, the samples are still written as they come, and the
+// log tells about it.
+
+#include "wavcapture.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "log.h"
+
+#define WAV_BUFFER_SAMPLES		0x8000			// 32K stereo samples = 128 KB per write
+#define WAV_HEADER_SIZE			44
+
+
+// Global variables
+
+bool wavCaptureActive = false;
+
+// Local variables
+
+static FILE * wavFile = NULL;
+static int16_t wavBuffer[WAV_BUFFER_SAMPLES][2];
+static uint32_t wavBufferCount;
+static uint32_t wavSamples;
+static uint32_t wavRate;
+static uint32_t wavLastRate;
+static uint32_t wavRateChanges;
+
+// Private function prototypes
+
+static void WAVFlush(void);
+static void WAVPut32(uint8_t * p, uint32_t value);
+static void WAVWriteHeader(void);
+
+
+//
+// Open the file, the header is written once the rate is known
+//
+bool WAVCaptureStart(const char * filename)
+{
+	WAVCaptureStop();
+
+	if (!(wavFile = fopen(filename, "wb")))
+	{
+		WriteLog("WAV: Could not open \"%s\" for writing!\n", filename);
+		return false;
+	}
+
+	// Room for the header, filled in at the end
+	uint8_t header[WAV_HEADER_SIZE];
+	memset(header, 0, WAV_HEADER_SIZE);
+	fwrite(header, 1, WAV_HEADER_SIZE, wavFile);
+
+	wavBufferCount = wavSamples = wavRate = wavLastRate = wavRateChanges = 0;
+	wavCaptureActive = true;
+	WriteLog("WAV: Capturing audio to \"%s\".\n", filename);
+	return true;
+}
+
+
+void WAVCaptureStop(void)
+{
+	if (!wavFile)
+		return;
+
+	wavCaptureActive = false;
+	WAVFlush();
+	WAVWriteHeader();
+	fclose(wavFile);
+	wavFile = NULL;
+
+	WriteLog("WAV: Captured %u samples at %u Hz.\n", wavSamples, wavRate);
+
+	if (wavRateChanges)
+		WriteLog("WAV: The I2S rate changed %u times during the capture!\n", wavRateChanges);
+}
+
+
+void WAVCaptureSample(int16_t left, int16_t right, uint32_t rate)
+{
+	if (!wavRate)
+		wavRate = wavLastRate = rate;
+	else if (rate != wavLastRate)
+	{
+		wavRateChanges++;
+		wavLastRate = rate;
+	}
+
+	wavBuffer[wavBufferCount][0] = left;
+	wavBuffer[wavBufferCount][1] = right;
+
+	if (++wavBufferCount == WAV_BUFFER_SAMPLES)
+		WAVFlush();
+}
+
+
+//
+// Write the buffered samples, as 16 bit little endian
+//
+static void WAVFlush(void)
+{
+	static uint8_t data[WAV_BUFFER_SAMPLES * 4];
+
+	for(uint32_t i=0; i<wavBufferCount; i++)
+	{
+		data[(i * 4) + 0] = wavBuffer[i][0] & 0xFF;
+		data[(i * 4) + 1] = (wavBuffer[i][0] >> 8) & 0xFF;
+		data[(i * 4) + 2] = wavBuffer[i][1] & 0xFF;
+		data[(i * 4) + 3] = (wavBuffer[i][1] >> 8) & 0xFF;
+	}
+
+	fwrite(data, 4, wavBufferCount, wavFile);
+	wavSamples += wavBufferCount;
+	wavBufferCount = 0;
+}
+
+
+static void WAVPut32(uint8_t * p, uint32_t value)
+{
+	p[0] = value & 0xFF, p[1] = (value >> 8) & 0xFF, p[2] = (value >> 16) & 0xFF, p[3] = value >> 24;
+}
+
+
+static void WAVWriteHeader(void)
+{
+	uint8_t header[WAV_HEADER_SIZE];
+	uint32_t dataSize = wavSamples * 4;
+
+	memcpy(header + 0, "RIFF", 4);
+	WAVPut32(header + 4, WAV_HEADER_SIZE - 8 + dataSize);
+	memcpy(header + 8, "WAVEfmt ", 8);
+	WAVPut32(header + 16, 16);					// fmt chunk size
+	WAVPut32(header + 20, 0x00020001);			// PCM, 2 channels
+	WAVPut32(header + 24, wavRate);
+	WAVPut32(header + 28, wavRate * 4);			// Bytes per second
+	WAVPut32(header + 32, 0x00100004);			// 4 bytes per sample, 16 bits
+	memcpy(header + 36, "data", 4);
+	WAVPut32(header + 40, dataSize);
+
+	fseek(wavFile, 0, SEEK_SET);
+	fwrite(header, 1, WAV_HEADER_SIZE, wavFile);
+}
@@ -0,0 +1,16 @@
+//
+// WAVCAPTURE.H: Header file
+//
+
+#ifndef __WAVCAPTURE_H__
+#define __WAVCAPTURE_H__
+
+#include <stdint.h>
+
+bool WAVCaptureStart(const char * filename);
+void WAVCaptureStop(void);
+void WAVCaptureSample(int16_t left, int16_t right, uint32_t rate);
+
+extern bool wavCaptureActive;
+
+#endif	// __WAVCAPTURE_H__
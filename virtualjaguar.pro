@@ -84,6 +84,7 @@ HEADERS = \
 	src/gui/about.h \
 	src/gui/alpinetab.h \
 	src/gui/app.h \
+	src/gui/emuthread.h \
 	src/gui/configdialog.h \
 	src/gui/controllertab.h \
 	src/gui/controllerwidget.h \
@@ -100,6 +101,7 @@ HEADERS = \
 	src/gui/keygrabber.h \
 	src/gui/mainwin.h \
 	src/gui/profile.h \
+	src/gui/romsweep.h \
 	src/gui/emustatus.h \
 	src/gui/debug/cpubrowser.h \
 	src/gui/debug/hwregsblitterbrowser.h \
@@ -118,6 +120,7 @@ HEADERS = \
 	src/debugger/DSPDasmWin.h \
 	src/debugger/GPUDasmWin.h \
 	src/debugger/HWLABELManager.h \
+	src/debugger/TraceDecoder.h \
 	src/debugger/ELFManager.h \
 	src/debugger/allwatchbrowser.h \
 	src/debugger/localbrowser.h \
@@ -130,6 +133,7 @@ HEADERS = \
 	src/debugger/callstackbrowser.h \
 	src/debugger/exceptionvectortablebrowser.h \
 	src/debugger/NewFnctBreakpointWin.h \
+	src/debugger/NewWatchpointWin.h \
 	src/debugger/CartFilesListWin.h \
 	src/debugger/SaveDumpAsWin.h \
 	src/log.h \
@@ -143,6 +147,7 @@ SOURCES = \
 	src/gui/about.cpp \
 	src/gui/alpinetab.cpp \
 	src/gui/app.cpp \
+	src/gui/emuthread.cpp \
 	src/gui/configdialog.cpp \
 	src/gui/controllertab.cpp \
 	src/gui/controllerwidget.cpp \
@@ -159,6 +164,7 @@ SOURCES = \
 	src/gui/keygrabber.cpp \
 	src/gui/mainwin.cpp \
 	src/gui/profile.cpp \
+	src/gui/romsweep.cpp \
 	src/gui/emustatus.cpp \
 	src/gui/debug/cpubrowser.cpp \
 	src/gui/debug/hwregsblitterbrowser.cpp \
@@ -177,6 +183,7 @@ SOURCES = \
 	src/debugger/DSPDasmWin.cpp \
 	src/debugger/GPUDasmWin.cpp \
 	src/debugger/HWLABELManager.cpp \
+	src/debugger/TraceDecoder.cpp \
 	src/debugger/ELFManager.cpp \
 	src/debugger/allwatchbrowser.cpp \
 	src/debugger/localbrowser.cpp \
@@ -189,6 +196,7 @@ SOURCES = \
 	src/debugger/exceptionvectortablebrowser.cpp \
 	src/debugger/callstackbrowser.cpp \
 	src/debugger/NewFnctBreakpointWin.cpp \
+	src/debugger/NewWatchpointWin.cpp \
 	src/debugger/CartFilesListWin.cpp \
 	src/debugger/SaveDumpAsWin.cpp \
 	src/log.cpp \